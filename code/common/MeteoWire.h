@@ -0,0 +1,138 @@
+/**
+ * @file MeteoWire.h
+ * @brief ESP-NOW telemetry frames, shared by the outdoor and indoor modules.
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @struct struct_message
+ * @brief One outdoor reading, as decoded (not a wire layout).
+ */
+typedef struct struct_message {
+  uint8_t humidityRead;           ///< Relative humidity (%).
+  int16_t outdoorTemperatureRead; ///< Temperature * 10 (255 = 25.5 C).
+  uint16_t pressureRead;          ///< Atmospheric pressure (hPa).
+  uint8_t uvIndexRead;            ///< UV raw value, clamped to 255.
+} struct_message;
+
+#define METEO_WIRE_VERSION 2 ///< Version byte of frames sent now.
+#define METEO_WIRE_V1_SIZE 8 ///< v1: struct_message with ESP32 padding.
+
+/// @brief v2 flag: the sequence restarted (RTC memory lost), no gap to count.
+#define WIRE_FLAG_RESTART 0x01
+
+/**
+ * @struct WireFrameV2
+ * @brief A v2 frame as it goes on air (packed, little-endian).
+ *
+ * seq counts readings, not retries, and survives deep sleep. crc is a
+ * CRC-16/CCITT-FALSE over every byte before it.
+ */
+struct __attribute__((packed)) WireFrameV2 {
+  uint8_t version;     ///< METEO_WIRE_VERSION.
+  uint16_t seq;        ///< Reading number, wraps.
+  uint8_t flags;       ///< WIRE_FLAG_* bits.
+  int16_t temperature; ///< Temperature * 10.
+  uint8_t humidity;    ///< Relative humidity (%).
+  uint16_t pressure;   ///< hPa.
+  uint8_t uv;          ///< UV raw value.
+  uint16_t crc;        ///< wireCrc16() of the bytes before it.
+};
+static_assert(sizeof(WireFrameV2) == 12, "WireFrameV2 must stay packed");
+static_assert(offsetof(WireFrameV2, crc) == sizeof(WireFrameV2) - 2,
+              "The CRC must be last");
+static_assert(sizeof(WireFrameV2) != METEO_WIRE_V1_SIZE,
+              "v1 and v2 are told apart by length");
+
+/**
+ * @enum WireStatus
+ * @brief Outcome of wireDecode().
+ */
+enum WireStatus : uint8_t {
+  WIRE_OK,          ///< Decoded.
+  WIRE_BAD_LENGTH,  ///< Neither a v1 nor a v2 frame.
+  WIRE_BAD_VERSION, ///< v2 length, unknown version byte.
+  WIRE_BAD_CRC,     ///< v2 frame corrupted on the way.
+  WIRE_IMPLAUSIBLE  ///< v1 length, but not a reading.
+};
+
+/**
+ * @struct WireReading
+ * @brief A decoded frame.
+ */
+struct WireReading {
+  struct_message data; ///< The reading.
+  uint8_t version;     ///< 1 or 2.
+  uint16_t seq;        ///< Sequence number (v2 only).
+  uint8_t flags;       ///< WIRE_FLAG_* bits (v2 only).
+};
+
+/// @brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF).
+inline uint16_t wireCrc16(const uint8_t *p, size_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= (uint16_t)(*p++) << 8;
+    for (uint8_t b = 0; b < 8; b++)
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021)
+                           : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+/// @brief Builds the v2 frame of reading number @p seq.
+inline WireFrameV2 wireEncode(const struct_message &m, uint16_t seq,
+                              uint8_t flags = 0) {
+  WireFrameV2 f;
+  f.version = METEO_WIRE_VERSION;
+  f.seq = seq;
+  f.flags = flags;
+  f.temperature = m.outdoorTemperatureRead;
+  f.humidity = m.humidityRead;
+  f.pressure = m.pressureRead;
+  f.uv = m.uvIndexRead;
+  f.crc = wireCrc16((const uint8_t *)&f, offsetof(WireFrameV2, crc));
+  return f;
+}
+
+/// @brief Decodes a v1 or v2 frame of @p len bytes.
+inline WireStatus wireDecode(const uint8_t *p, size_t len, WireReading &out) {
+  if (len == METEO_WIRE_V1_SIZE) {
+    // Offsets of the padded v1 struct: u8, pad, i16, u16, u8, pad. The
+    // sender's struct was a zeroed global, so its padding is 0.
+    out.version = 1;
+    out.seq = 0;
+    out.flags = 0;
+    out.data.humidityRead = p[0];
+    memcpy(&out.data.outdoorTemperatureRead, p + 2, 2);
+    memcpy(&out.data.pressureRead, p + 4, 2);
+    out.data.uvIndexRead = p[6];
+    const struct_message &d = out.data;
+    bool plausible = p[1] == 0 && p[7] == 0 && d.humidityRead <= 100 &&
+                     d.outdoorTemperatureRead >= -600 &&
+                     d.outdoorTemperatureRead <= 850 &&
+                     (d.pressureRead == 0 || // BME280 missing.
+                      (d.pressureRead >= 300 && d.pressureRead <= 1100));
+    return plausible ? WIRE_OK : WIRE_IMPLAUSIBLE;
+  }
+  if (len != sizeof(WireFrameV2))
+    return WIRE_BAD_LENGTH;
+
+  WireFrameV2 f;
+  memcpy(&f, p, sizeof(f));
+  if (f.version != METEO_WIRE_VERSION)
+    return WIRE_BAD_VERSION;
+  if (f.crc != wireCrc16(p, offsetof(WireFrameV2, crc)))
+    return WIRE_BAD_CRC;
+  out.version = f.version;
+  out.seq = f.seq;
+  out.flags = f.flags;
+  out.data.humidityRead = f.humidity;
+  out.data.outdoorTemperatureRead = f.temperature;
+  out.data.pressureRead = f.pressure;
+  out.data.uvIndexRead = f.uv;
+  return WIRE_OK;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file Bench.cpp
+ * @brief Registry, runner and reporters of the benchmark harness.
+ */
+
+#include "Bench.h"
+
+#include <Arduino.h>
+#include <cstdio>
+#include <cstring>
+
+namespace benchmark {
+
+namespace {
+struct Entry {
+  const char *name;
+  Function fn;
+};
+
+struct Result {
+  std::string name;
+  uint64_t iterations;
+  double nsPerIter;
+  double blockedMsPerIter;
+  std::string label;
+  std::map<std::string, double> counters;
+};
+
+std::vector<Entry> &registry() {
+  static std::vector<Entry> r;
+  return r;
+}
+
+const char *flagValue(const char *arg, const char *flag) {
+  size_t n = std::strlen(flag);
+  return std::strncmp(arg, flag, n) == 0 && arg[n] == '=' ? arg + n + 1
+                                                          : nullptr;
+}
+
+void printJsonString(std::FILE *out, const std::string &s) {
+  std::fputc('"', out);
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      std::fputc('\\', out);
+    std::fputc(c, out);
+  }
+  std::fputc('"', out);
+}
+
+void reportConsole(std::FILE *out, const std::vector<Result> &results) {
+  std::fprintf(out, "%-40s %14s %12s %12s\n", "Benchmark", "Time/iter",
+               "Iterations", "blocked_ms");
+  std::fprintf(out, "%s\n", std::string(81, '-').c_str());
+  for (const Result &r : results) {
+    double t = r.nsPerIter;
+    const char *unit = "ns";
+    if (t >= 1e6) {
+      t /= 1e6;
+      unit = "ms";
+    } else if (t >= 1e3) {
+      t /= 1e3;
+      unit = "us";
+    }
+    std::fprintf(out, "%-40s %11.2f %s %12llu %12.1f", r.name.c_str(), t, unit,
+                 (unsigned long long)r.iterations, r.blockedMsPerIter);
+    for (auto &c : r.counters)
+      std::fprintf(out, " %s=%.6g", c.first.c_str(), c.second);
+    if (!r.label.empty())
+      std::fprintf(out, " %s", r.label.c_str());
+    std::fputc('\n', out);
+  }
+}
+
+void reportJson(std::FILE *out, const std::vector<Result> &results) {
+  std::fprintf(out, "{\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); i++) {
+    const Result &r = results[i];
+    std::fprintf(out, "    {\"name\": ");
+    printJsonString(out, r.name);
+    std::fprintf(out,
+                 ", \"iterations\": %llu, \"real_time\": %.3f, "
+                 "\"time_unit\": \"ns\", \"blocked_ms\": %.3f",
+                 (unsigned long long)r.iterations, r.nsPerIter,
+                 r.blockedMsPerIter);
+    for (auto &c : r.counters) {
+      std::fprintf(out, ", ");
+      printJsonString(out, c.first);
+      std::fprintf(out, ": %.6g", c.second);
+    }
+    if (!r.label.empty()) {
+      std::fprintf(out, ", \"label\": ");
+      printJsonString(out, r.label);
+    }
+    std::fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+}
+} // namespace
+
+void State::start() {
+  _elapsed = 0;
+  _blockedUs = 0;
+  ResumeTiming();
+}
+
+void State::finish() { PauseTiming(); }
+
+void State::PauseTiming() {
+  if (!_running)
+    return;
+  _elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            _t0)
+                  .count();
+  _blockedUs += (double)(host::blockedMicros() - _blocked0);
+  _running = false;
+}
+
+void State::ResumeTiming() {
+  if (_running)
+    return;
+  _blocked0 = host::blockedMicros();
+  _t0 = std::chrono::steady_clock::now();
+  _running = true;
+}
+
+int RegisterBenchmark(const char *name, Function fn) {
+  registry().push_back({name, fn});
+  return (int)registry().size();
+}
+
+int RunSpecifiedBenchmarks(int argc, char **argv) {
+  const char *filter = "";
+  const char *format = "console";
+  const char *outPath = nullptr;
+  double minTime = 0.2;
+  uint64_t maxIters = 1000000;
+
+  for (int i = 1; i < argc; i++) {
+    if (const char *v = flagValue(argv[i], "--benchmark_filter"))
+      filter = v;
+    else if (const char *v = flagValue(argv[i], "--benchmark_format"))
+      format = v;
+    else if (const char *v = flagValue(argv[i], "--benchmark_out"))
+      outPath = v;
+    else if (const char *v = flagValue(argv[i], "--benchmark_min_time"))
+      minTime = std::atof(v);
+    else if (const char *v = flagValue(argv[i], "--benchmark_max_iterations"))
+      maxIters = std::strtoull(v, nullptr, 10);
+    else if (std::strcmp(argv[i], "--benchmark_list_tests") == 0) {
+      for (const Entry &e : registry())
+        std::printf("%s\n", e.name);
+      return 0;
+    } else {
+      std::fprintf(stderr, "unknown flag: %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  std::vector<Result> results;
+  for (const Entry &e : registry()) {
+    if (*filter && !std::strstr(e.name, filter))
+      continue;
+
+    uint64_t n = 1;
+    while (true) {
+      State st(n);
+      e.fn(st);
+      bool done = st.elapsedSeconds() >= minTime || n >= maxIters;
+      if (done) {
+        Result r{e.name, n, st.elapsedSeconds() * 1e9 / n,
+                 st.blockedMicros() / 1000.0 / n, st.label(), st.counters};
+        for (auto &c : r.counters)
+          c.second /= n;
+        results.push_back(r);
+        break;
+      }
+      double scale = st.elapsedSeconds() > 0
+                         ? minTime * 1.4 / st.elapsedSeconds()
+                         : 100.0;
+      uint64_t next = (uint64_t)(n * std::min(std::max(scale, 2.0), 100.0));
+      n = std::min(next, maxIters);
+    }
+  }
+
+  std::FILE *out = stdout;
+  if (outPath && !(out = std::fopen(outPath, "w"))) {
+    std::fprintf(stderr, "cannot open %s\n", outPath);
+    return 1;
+  }
+  if (std::strcmp(format, "json") == 0)
+    reportJson(out, results);
+  else
+    reportConsole(out, results);
+  if (out != stdout)
+    std::fclose(out);
+  return 0;
+}
+
+} // namespace benchmark
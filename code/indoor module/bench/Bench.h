@@ -0,0 +1,100 @@
+/**
+ * @file Bench.h
+ * @brief Minimal Google-Benchmark-style harness for the native build.
+ *
+ * blocked_ms is the virtual time spent in delay() per iteration.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+/**
+ * @class State
+ * @brief Per-run state handed to a benchmark function.
+ */
+class State {
+public:
+  explicit State(uint64_t maxIterations) : _max(maxIterations) {}
+
+  /// @brief What `auto _` binds to. Like Google Benchmark's, it has a
+  /// user-provided destructor so GCC does not report `_` as unused.
+  struct Value {
+    ~Value() {}
+  };
+
+  /// @brief Iterator driving `for (auto _ : state)`.
+  struct Iterator {
+    State *state;
+    uint64_t left;
+    bool operator!=(const Iterator &) const {
+      if (left != 0)
+        return true;
+      state->finish();
+      return false;
+    }
+    void operator++() { left--; }
+    Value operator*() const { return Value(); }
+  };
+
+  Iterator begin() {
+    start();
+    return Iterator{this, _max};
+  }
+  Iterator end() { return Iterator{this, 0}; }
+
+  /// @brief Excludes the following code from the measured time.
+  void PauseTiming();
+  /// @brief Resumes measuring after PauseTiming().
+  void ResumeTiming();
+
+  void SetLabel(const std::string &label) { _label = label; }
+  uint64_t iterations() const { return _max; }
+
+  /// @brief User counters; reported as an average per iteration.
+  std::map<std::string, double> counters;
+
+  double elapsedSeconds() const { return _elapsed; }
+  double blockedMicros() const { return _blockedUs; }
+  const std::string &label() const { return _label; }
+
+private:
+  void start();
+  void finish();
+
+  uint64_t _max;
+  std::chrono::steady_clock::time_point _t0;
+  uint64_t _blocked0 = 0;
+  double _elapsed = 0;
+  double _blockedUs = 0;
+  bool _running = false;
+  std::string _label;
+};
+
+using Function = void (*)(State &);
+
+/// @brief Adds a benchmark to the global registry.
+int RegisterBenchmark(const char *name, Function fn);
+
+/// @brief Runs the registered benchmarks selected by the command line.
+int RunSpecifiedBenchmarks(int argc, char **argv);
+
+/// @brief Keeps the compiler from optimising away a computed value.
+template <typename T> inline void DoNotOptimize(T const &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+} // namespace benchmark
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+
+/// @brief Registers @p fn as a benchmark named after the function.
+#define BENCHMARK(fn)                                                         \
+  static int BENCH_CONCAT(bench_reg_, __LINE__) =                              \
+      ::benchmark::RegisterBenchmark(#fn, fn)
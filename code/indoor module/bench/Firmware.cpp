@@ -0,0 +1,70 @@
+/**
+ * @file Firmware.cpp
+ * @brief Host boot sequence shared by all benchmarks.
+ */
+
+#include "Firmware.h"
+
+#include <LittleFS.h>
+#include <Preferences.h>
+#include <RTClib.h>
+#include <WiFi.h>
+#include <esp_now.h>
+
+#include <MeteoWire.h>
+
+void setup();
+
+namespace bench {
+
+const uint8_t kOutdoorMac[6] = {0x58, 0xcf, 0x79, 0x12, 0x34, 0x56};
+
+void bootFirmware() {
+  static bool booted = false;
+  if (booted)
+    return;
+  booted = true;
+
+  host::setAccessPoint("bench-ap", 6, 800);
+  host::setRtcIntPin(RTC_INT_PIN);
+
+  Preferences prefs;
+  prefs.begin("net", false);
+  prefs.putString("ssid", "bench-ap");
+  prefs.putString("pass", "bench-pass");
+  prefs.end();
+
+  // data/certs/ is not checked in; use placeholders of realistic size
+  // (Amazon Root CA 1, an RSA-2048 device certificate and key).
+  LittleFS.addOverlay(TLS_CA_PATH, pemPlaceholder("CERTIFICATE", 837));
+  LittleFS.addOverlay(TLS_CERT_PATH, pemPlaceholder("CERTIFICATE", 862));
+  LittleFS.addOverlay(TLS_KEY_PATH,
+                      pemPlaceholder("RSA PRIVATE KEY", 1191));
+
+  setup();
+}
+
+std::string pemPlaceholder(const char *label, size_t derBytes) {
+  std::string pem = std::string("-----BEGIN ") + label + "-----\n";
+  size_t b64 = (derBytes + 2) / 3 * 4;
+  for (size_t i = 0; i < b64; i += 64)
+    pem += std::string(b64 - i < 64 ? b64 - i : 64, 'A') + "\n";
+  return pem + "-----END " + label + "-----\n";
+}
+
+struct_message sampleReading(uint32_t seq) {
+  struct_message m = {};
+  m.humidityRead = (uint8_t)(40 + seq % 20);
+  m.outdoorTemperatureRead = (int16_t)(-35 + (int)(seq % 70));
+  m.pressureRead = (uint16_t)(1005 + seq % 15);
+  m.uvIndexRead = (uint8_t)(seq % 11);
+  return m;
+}
+
+void injectReading(const struct_message &m) {
+  static uint16_t seq = 0;
+  WireFrameV2 frame = wireEncode(m, ++seq);
+  host::espNowInject(kOutdoorMac, (const uint8_t *)&frame, sizeof(frame));
+}
+
+} // namespace bench
@@ -0,0 +1,42 @@
+/**
+ * @file Firmware.h
+ * @brief Boots the real firmware on the host stand-ins for benchmarking.
+ */
+
+#pragma once
+#include <string>
+
+#include "NetworkManager.h"
+#include "SensorManager.h"
+#include "UIManager.h"
+
+extern SensorManager *sensorMgr;
+extern NetworkManager *netMgr;
+extern UIManager *uiMgr;
+
+namespace bench {
+/// @brief MAC of the simulated outdoor module.
+extern const uint8_t kOutdoorMac[6];
+
+/**
+ * @brief Runs the firmware's setup() once, with saved WiFi credentials, a
+ * reachable access point and dummy TLS credentials in place.
+ */
+void bootFirmware();
+
+/**
+ * @brief A PEM object of the right shape and size (the payload is filler).
+ * @param label What follows "BEGIN ", e.g. "CERTIFICATE".
+ * @param derBytes Size of the DER it stands for.
+ */
+std::string pemPlaceholder(const char *label, size_t derBytes);
+
+/// @brief Builds a plausible outdoor reading.
+struct_message sampleReading(uint32_t seq = 0);
+
+/**
+ * @brief Delivers @p m from the outdoor module as a v2 frame, numbered like
+ * a node that never restarts.
+ */
+void injectReading(const struct_message &m);
+} // namespace bench
@@ -0,0 +1,94 @@
+/**
+ * @file FrameReport.cpp
+ * @brief Frame-cost scenario and JSON writer.
+ */
+
+#include "FrameReport.h"
+#include "Firmware.h"
+
+#include <FrameRecorder.h>
+
+namespace bench {
+
+namespace {
+const char *screenName(int32_t s) {
+  switch (s) {
+  case HOME_SCREEN:
+    return "HOME_SCREEN";
+  case SETTINGS_SCREEN:
+    return "SETTINGS_SCREEN";
+  case APP_CONNECTION_SCREEN:
+    return "APP_CONNECTION_SCREEN";
+  case WIFI_CONNECTION_SCREEN:
+    return "WIFI_CONNECTION_SCREEN";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+void writeCallName(std::FILE *out, const host::FrameRecord &r) {
+  switch (r.id) {
+  case TRACE_CHANGE_SCREEN:
+    std::fprintf(out, "changeScreen(%s)", screenName(r.arg));
+    break;
+  case TRACE_DRAW_DYNAMIC:
+    std::fprintf(out, "drawDynamic");
+    break;
+  case TRACE_DRAW_CLOCK:
+    std::fprintf(out, "drawClock");
+    break;
+  default:
+    std::fprintf(out, "trace%d", (int)r.id);
+    break;
+  }
+}
+
+/// @brief Moves the virtual clock past the next minute boundary.
+void advanceToNextMinute() { host::advanceMicros(60ULL * 1000000ULL); }
+} // namespace
+
+void writeFrameReport(std::FILE *out) {
+  bootFirmware();
+  host::clearFrameRecords();
+
+  uiMgr->changeScreen(HOME_SCREEN);
+  uiMgr->changeScreen(SETTINGS_SCREEN);
+  uiMgr->changeScreen(APP_CONNECTION_SCREEN);
+  uiMgr->changeScreen(HOME_SCREEN);
+
+  // New reading: dynamic data only (clock poll not yet due).
+  screenDataDirty = true;
+  uiMgr->update();
+
+  // Clock poll within the same minute, then across a minute boundary.
+  host::advanceMicros(2100ULL * 1000ULL);
+  uiMgr->update();
+  advanceToNextMinute();
+  uiMgr->update();
+
+  // Last: entering this screen starts the provisioning portal.
+  uiMgr->changeScreen(WIFI_CONNECTION_SCREEN);
+
+  const auto &records = host::frameRecords();
+  std::fprintf(out, "{\n  \"frames\": [\n");
+  for (size_t i = 0; i < records.size(); i++) {
+    const host::FrameRecord &r = records[i];
+    std::fprintf(out, "    {\"call\": \"");
+    writeCallName(out, r);
+    std::fprintf(
+        out,
+        "\", \"depth\": %u, \"wall_us\": %.1f, \"pixels\": %llu, "
+        "\"push_image_calls\": %u, \"stream_calls\": %u, \"fill_calls\": %u, "
+        "\"font_loads\": %u, \"driver_us\": %.1f, \"fs_bytes\": %llu, "
+        "\"fs_opens\": %u, \"fs_read_us\": %.1f, \"png_decodes\": %u, "
+        "\"inflate_us\": %.1f, \"rle_decodes\": %u, \"rle_us\": %.1f}%s\n",
+        (unsigned)r.depth, r.wallNs / 1e3, (unsigned long long)r.pixels,
+        r.pushImageCalls, r.streamCalls, r.fillCalls, r.fontLoads,
+        r.driverNs / 1e3, (unsigned long long)r.fsBytes, r.fsOpens,
+        r.fsNs / 1e3, r.pngDecodes, r.inflateNs / 1e3, r.rleDecodes,
+        r.rleNs / 1e3, i + 1 < records.size() ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace bench
@@ -0,0 +1,17 @@
+/**
+ * @file FrameReport.h
+ * @brief Per-screen frame-cost report of the home, settings and connection
+ * screens.
+ */
+
+#pragma once
+#include <cstdio>
+
+namespace bench {
+/**
+ * @brief Drives every screen switch and home-screen redraw once and writes
+ * one JSON record per traced UI call.
+ * @param out Destination stream.
+ */
+void writeFrameReport(std::FILE *out);
+} // namespace bench
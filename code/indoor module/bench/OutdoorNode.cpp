@@ -0,0 +1,39 @@
+/**
+ * @file OutdoorNode.cpp
+ * @brief Builds the unmodified outdoor sketch into its own namespace.
+ */
+
+#include "OutdoorNode.h"
+
+#include "soc/rtc_cntl_reg.h"
+#include "soc/soc.h"
+#include <Adafruit_BME280.h>
+#include <Adafruit_NeoPixel.h>
+#include <Adafruit_Sensor.h>
+#include <Arduino.h>
+#include <MeteoWire.h>
+#include <WiFi.h>
+#include <Wire.h>
+#include <esp_now.h>
+#include <esp_wifi.h>
+
+namespace outdoor {
+#include "../../outdoor module/src/main.cpp"
+} // namespace outdoor
+
+namespace bench {
+uint64_t outdoorWake() {
+  try {
+    outdoor::setup();
+  } catch (const host::DeepSleep &s) {
+    return s.sleepUs;
+  }
+  return 0;
+}
+
+uint8_t outdoorSavedChannel() { return outdoor::savedChannel; }
+
+void setOutdoorSavedChannel(uint8_t ch) { outdoor::savedChannel = ch; }
+
+uint32_t outdoorMaxRetryMs() { return (uint32_t)outdoor::MAX_RETRY_TIME_MS; }
+} // namespace bench
@@ -0,0 +1,23 @@
+/**
+ * @file OutdoorNode.h
+ * @brief The outdoor module's sketch, compiled for the host radio simulator.
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace bench {
+/**
+ * @brief Runs one wake cycle of the outdoor sketch (setup() up to deep
+ * sleep) on the current radio node.
+ * @return Deep-sleep time the sketch armed, in microseconds.
+ */
+uint64_t outdoorWake();
+
+/// @brief Channel the sketch tries first (its RTC_DATA_ATTR savedChannel).
+uint8_t outdoorSavedChannel();
+void setOutdoorSavedChannel(uint8_t ch);
+
+/// @brief The sketch's MAX_RETRY_TIME_MS.
+uint32_t outdoorMaxRetryMs();
+} // namespace bench
@@ -0,0 +1,160 @@
+/**
+ * @file RadioReport.cpp
+ * @brief Link scenarios and JSON writer for the radio simulator.
+ */
+
+#include "RadioReport.h"
+#include "Firmware.h"
+#include "OutdoorNode.h"
+
+#include <RadioSim.h>
+#include <WiFi.h>
+
+namespace bench {
+
+namespace {
+/// @brief One link scenario.
+struct Scenario {
+  const char *name;
+  float loss;            ///< Per-frame loss, both directions.
+  uint32_t ackLatencyUs; ///< Receiver ACK turnaround on top of SIFS.
+  uint8_t apChannel;     ///< Channel of the indoor module's AP (0 = no AP).
+  uint8_t savedChannel;  ///< Outdoor RTC channel before the first wake.
+  int32_t indoorHopAtMs; ///< Indoor WiFi join this long after each wake.
+};
+
+const Scenario kScenarios[] = {
+    {"ideal", 0.0f, 0, 6, 6, -1},
+    {"cold_start", 0.0f, 0, 6, 1, -1},
+    {"ap_channel_13", 0.0f, 0, 13, 1, -1},
+    {"loss_10", 0.10f, 0, 6, 6, -1},
+    {"loss_30", 0.30f, 0, 6, 6, -1},
+    {"loss_60", 0.60f, 0, 6, 6, -1},
+    {"late_ack", 0.0f, 600, 6, 6, -1},
+    {"no_ap", 0.0f, 0, 0, 6, -1},
+    {"indoor_joining", 0.0f, 0, 6, 6, 100},
+};
+
+constexpr int kWakes = 30;
+constexpr uint32_t kApJoinMs = 800;
+const uint8_t kIndoorNode = 0;
+
+/// @brief Energy drawn by the radio: listen power while on, TX on top.
+double energyMj(const host::RadioStats &s) {
+  const host::RadioParams &p = host::radioParams();
+  double nj = (double)s.radioOnUs * p.rxPowerMw +
+              (double)s.txAirtimeUs * (p.txPowerMw - p.rxPowerMw);
+  return nj / 1e6;
+}
+
+/// @brief Lets the indoor firmware handle the queued readings the way it
+/// does on the device.
+void indoorHandleReading() {
+  netMgr->loop();
+  screenDataDirty = false;
+}
+
+struct Result {
+  int delivered = 0;
+  uint32_t frames = 0;
+  uint32_t timeouts = 0;
+  uint64_t maxWakeRadioUs = 0;
+  host::RadioStats outdoor;
+};
+
+Result runScenario(const Scenario &sc, host::NodeId outdoorId) {
+  host::clearScheduledEvents();
+  if (sc.apChannel)
+    host::setAccessPoint("bench-ap", sc.apChannel, kApJoinMs);
+  else
+    host::setAccessPoint("", 1, kApJoinMs);
+
+  host::LinkParams link;
+  link.loss = sc.loss;
+  link.ackLatencyUs = sc.ackLatencyUs;
+  host::setLink(outdoorId, kIndoorNode, link);
+  host::setLink(kIndoorNode, outdoorId, link);
+  host::seedRadio(0xC0FFEE);
+  setOutdoorSavedChannel(sc.savedChannel);
+
+  // Settle the indoor module onto the channel it sits on after a publish.
+  struct_message m = sampleReading(0);
+  injectReading(m);
+  indoorHandleReading();
+  host::resetRadioStats();
+
+  Result r;
+  const uint32_t retryUs = outdoorMaxRetryMs() * 1000U;
+  for (int i = 0; i < kWakes; i++) {
+    if (sc.indoorHopAtMs >= 0)
+      host::scheduleIn((uint64_t)sc.indoorHopAtMs * 1000ULL, []() {
+        host::startChannelHop(kIndoorNode, kApJoinMs);
+      });
+
+    uint32_t rx0 = netMgr->espNowFrames();
+    uint64_t on0 = host::radioStats(outdoorId).radioOnUs;
+    uint64_t sleepUs;
+    {
+      host::NodeScope as(outdoorId);
+      sleepUs = outdoorWake();
+    }
+    uint64_t wakeAt = host::nowMicros() + sleepUs;
+    uint64_t wakeRadioUs = host::radioStats(outdoorId).radioOnUs - on0;
+    r.maxWakeRadioUs = std::max(r.maxWakeRadioUs, wakeRadioUs);
+    if (wakeRadioUs >= retryUs)
+      r.timeouts++;
+
+    if (netMgr->espNowFrames() != rx0) {
+      r.delivered++;
+      indoorHandleReading();
+    }
+
+    // The indoor publish overlaps the outdoor node's sleep.
+    if (wakeAt > host::nowMicros())
+      host::advanceMicros(wakeAt - host::nowMicros());
+  }
+  r.outdoor = host::radioStats(outdoorId);
+  r.frames = host::radioStats(kIndoorNode).delivered;
+  return r;
+}
+} // namespace
+
+void writeRadioReport(std::FILE *out) {
+  bootFirmware();
+  host::setRealTimeClock(false);
+  host::NodeId outdoorId = host::addRadioNode(kOutdoorMac);
+  const host::RadioParams &p = host::radioParams();
+
+  std::fprintf(out,
+               "{\n  \"radio\": {\"tx_mw\": %.0f, \"rx_mw\": %.0f, "
+               "\"hop_dwell_ms\": %u, \"wakes_per_scenario\": %d},\n"
+               "  \"scenarios\": [\n",
+               p.txPowerMw, p.rxPowerMw, (unsigned)p.hopDwellMs, kWakes);
+  const size_t count = sizeof(kScenarios) / sizeof(kScenarios[0]);
+  for (size_t i = 0; i < count; i++) {
+    const Scenario &sc = kScenarios[i];
+    Result r = runScenario(sc, outdoorId);
+    const host::RadioStats &s = r.outdoor;
+    double energy = energyMj(s);
+    double perPacket = r.delivered ? 1.0 / r.delivered : 0.0;
+    std::fprintf(
+        out,
+        "    {\"name\": \"%s\", \"loss\": %.2f, \"ack_latency_us\": %u, "
+        "\"ap_channel\": %u, \"delivered\": %d, \"delivery_ratio\": %.3f, "
+        "\"duplicates\": %u, \"tx_frames\": %u, \"retry_timeouts\": %u, "
+        "\"max_wake_radio_on_ms\": %.1f, \"radio_on_ms\": %.1f, "
+        "\"airtime_ms\": %.3f, \"energy_mj\": %.2f, "
+        "\"radio_on_ms_per_packet\": %.1f, \"airtime_us_per_packet\": %.1f, "
+        "\"energy_mj_per_packet\": %.3f}%s\n",
+        sc.name, sc.loss, (unsigned)sc.ackLatencyUs, (unsigned)sc.apChannel,
+        r.delivered, (double)r.delivered / kWakes,
+        (unsigned)(r.frames - r.delivered), s.transmissions, r.timeouts,
+        r.maxWakeRadioUs / 1e3, s.radioOnUs / 1e3, s.txAirtimeUs / 1e3,
+        energy, s.radioOnUs / 1e3 * perPacket,
+        (double)s.txAirtimeUs * perPacket, energy * perPacket,
+        i + 1 < count ? "," : "");
+  }
+  std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace bench
@@ -0,0 +1,17 @@
+/**
+ * @file RadioReport.h
+ * @brief Outdoor -> indoor ESP-NOW link scenarios on the simulated radio.
+ */
+
+#pragma once
+#include <cstdio>
+
+namespace bench {
+/**
+ * @brief Runs the outdoor sketch against the indoor firmware under several
+ * loss and channel scenarios and writes airtime and energy per delivered
+ * packet as JSON.
+ * @param out Destination stream.
+ */
+void writeRadioReport(std::FILE *out);
+} // namespace bench
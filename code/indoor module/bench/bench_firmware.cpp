@@ -0,0 +1,685 @@
+/**
+ * @file bench_firmware.cpp
+ * @brief Hot-path benchmarks of the indoor firmware (native build).
+ */
+
+#include "Bench.h"
+#include "Firmware.h"
+
+#include <LittleFS.h>
+#include <PubSubClient.h>
+#include <algorithm>
+#include <driver/adc.h>
+#include <driver/ledc.h>
+#include <esp_now.h>
+#include <esp_sntp.h>
+#include <string>
+#include <vector>
+
+#include "Background.h"
+#include "BandWriter.h"
+#include "HeapTracker.h"
+#include "Icon.h"
+#include "Profiler.h"
+#include "Rle565.h"
+#include "SystemClock.h"
+
+/// @brief Resets the panel and filesystem counters before a run.
+static void resetDisplayCounters() {
+  LittleFS.resetStats();
+  TFT_eSPI::hostResetStats();
+}
+
+/// @brief Reports panel and filesystem traffic of a run.
+static void reportDisplayCounters(benchmark::State &state) {
+  state.counters["fs_bytes"] = (double)LittleFS.bytesRead();
+  state.counters["pixels"] = (double)TFT_eSPI::hostStats().pixels;
+  state.counters["push_calls"] = TFT_eSPI::hostStats().pushImageCalls;
+  state.counters["stream_calls"] = TFT_eSPI::hostStats().streamCalls;
+  state.counters["dma_calls"] = TFT_eSPI::hostStats().dmaCalls;
+}
+
+/// @brief Reports allocations charged to @p site during a run.
+static void reportHeapCounters(benchmark::State &state, HeapSite site) {
+  const HeapSiteStats &s = heapTracker.stats(site);
+  std::string prefix = HeapTracker::siteName(site);
+  state.counters[prefix + ".allocs"] = s.allocs;
+  state.counters[prefix + ".bytes"] = (double)s.bytes;
+}
+
+/// @brief Reports icon cache hits and misses of a run.
+static void reportIconCache(benchmark::State &state) {
+  const IconCache::Stats &s = uiMgr->iconCache().stats();
+  state.counters["icon_hits"] = s.hits;
+  state.counters["icon_misses"] = s.misses;
+}
+
+static void BM_ChangeScreenHome(benchmark::State &state) {
+  bench::bootFirmware();
+  resetDisplayCounters();
+  heapTracker.reset();
+  uiMgr->iconCache().resetStats();
+  for (auto _ : state)
+    uiMgr->changeScreen(HOME_SCREEN);
+  reportDisplayCounters(state);
+  reportHeapCounters(state, HEAP_SITE_DRAW_CLOCK);
+  reportHeapCounters(state, HEAP_SITE_ICON_LOAD);
+  reportIconCache(state);
+}
+BENCHMARK(BM_ChangeScreenHome);
+
+static void BM_ChangeScreenSettings(benchmark::State &state) {
+  bench::bootFirmware();
+  resetDisplayCounters();
+  for (auto _ : state)
+    uiMgr->changeScreen(SETTINGS_SCREEN);
+  reportDisplayCounters(state);
+}
+BENCHMARK(BM_ChangeScreenSettings);
+
+static void BM_ChangeScreenAppConnection(benchmark::State &state) {
+  bench::bootFirmware();
+  resetDisplayCounters();
+  for (auto _ : state)
+    uiMgr->changeScreen(APP_CONNECTION_SCREEN);
+  reportDisplayCounters(state);
+}
+BENCHMARK(BM_ChangeScreenAppConnection);
+
+/// @brief Shadows the .rle built from @p png with an empty file, so the
+/// loaders fall back to decoding the PNG.
+static void hideRle(const char *png) {
+  LittleFS.addOverlay(Rle565Image::pathFor(png).c_str(), "");
+}
+
+static void unhideRle(const char *png) {
+  LittleFS.removeOverlay(Rle565Image::pathFor(png).c_str());
+}
+
+static const char *const kBackground = "/images/settings_screen-min.png";
+static const char *const kIcon = "/images/hum_press294x34.png";
+
+/// @brief Draws the settings background, from the PNG or the .rle.
+static void runBackground(benchmark::State &state, bool rle) {
+  static TFT_eSPI panel;
+  panel.init();
+  panel.setRotation(1);
+  BandWriter::begin(panel);
+  Background bg(kBackground);
+  if (!rle)
+    hideRle(kBackground);
+  resetDisplayCounters();
+  for (auto _ : state)
+    bg.draw(panel, png);
+  reportDisplayCounters(state);
+  unhideRle(kBackground);
+}
+
+static void BM_BackgroundPng(benchmark::State &state) {
+  runBackground(state, false);
+}
+BENCHMARK(BM_BackgroundPng);
+
+static void BM_BackgroundRle(benchmark::State &state) {
+  runBackground(state, true);
+}
+BENCHMARK(BM_BackgroundRle);
+
+static const uint32_t kBusHz = 40000000;     ///< Panel SPI clock.
+static const uint32_t kBusTransferNs = 5000; ///< Driver cost per transfer.
+static const double kCpuScale = 10.0; ///< ESP32 vs host decode speed (rough).
+
+/**
+ * @brief Full-screen background draw time with the panel bus modelled:
+ * one blocking push per row (as before BandWriter) or BG_BAND_LINES-row
+ * bands double-buffered over DMA.
+ *
+ * draw_ms is micros() per draw: decoding (host wall time stretched by
+ * kCpuScale) plus waiting for the bus; stall_ms is the part of bus_ms that
+ * decoding did not hide.
+ */
+static void runBackgroundBus(benchmark::State &state, bool rle, bool dma) {
+  static TFT_eSPI panel;
+  panel.init();
+  panel.setRotation(1);
+  BandWriter::begin(panel);
+  BandWriter::configure(dma ? BG_BAND_LINES : 1, dma);
+  Background bg(kBackground);
+  if (!rle)
+    hideRle(kBackground);
+  TFT_eSPI::hostSetBusModel(kBusHz, kBusTransferNs);
+  host::setCpuScale(kCpuScale);
+  resetDisplayCounters();
+  uint64_t t0 = host::nowMicros();
+  for (auto _ : state)
+    bg.draw(panel, png);
+  state.counters["draw_ms"] = (host::nowMicros() - t0) / 1000.0;
+  state.counters["bus_ms"] = TFT_eSPI::hostStats().busNs / 1e6;
+  state.counters["stall_ms"] = TFT_eSPI::hostStats().busStallNs / 1e6;
+  host::setCpuScale(1.0);
+  reportDisplayCounters(state);
+  TFT_eSPI::hostSetBusModel(0);
+  BandWriter::configure(BG_BAND_LINES, true);
+  unhideRle(kBackground);
+}
+
+static void BM_BackgroundPngRows(benchmark::State &state) {
+  runBackgroundBus(state, false, false);
+}
+BENCHMARK(BM_BackgroundPngRows);
+
+static void BM_BackgroundPngBandsDma(benchmark::State &state) {
+  runBackgroundBus(state, false, true);
+}
+BENCHMARK(BM_BackgroundPngBandsDma);
+
+static void BM_BackgroundRleRows(benchmark::State &state) {
+  runBackgroundBus(state, true, false);
+}
+BENCHMARK(BM_BackgroundRleRows);
+
+static void BM_BackgroundRleBandsDma(benchmark::State &state) {
+  runBackgroundBus(state, true, true);
+}
+BENCHMARK(BM_BackgroundRleBandsDma);
+
+/// @brief Loads an icon into its sprite, from the PNG or the .rle.
+static void runIconLoad(benchmark::State &state, bool rle) {
+  static TFT_eSPI panel;
+  Icon icon(&panel, kIcon, 0, 0, 0);
+  if (!rle)
+    hideRle(kIcon);
+  resetDisplayCounters();
+  heapTracker.reset();
+  for (auto _ : state)
+    icon.loadFromFS();
+  reportDisplayCounters(state);
+  reportHeapCounters(state, HEAP_SITE_ICON_LOAD);
+  unhideRle(kIcon);
+}
+
+static void BM_IconLoadPng(benchmark::State &state) {
+  runIconLoad(state, false);
+}
+BENCHMARK(BM_IconLoadPng);
+
+static void BM_IconLoadRle(benchmark::State &state) {
+  runIconLoad(state, true);
+}
+BENCHMARK(BM_IconLoadRle);
+
+/// @brief Decoded rows of one icon, as Icon's PNG draw callback gets them.
+struct IconRows {
+  uint16_t width;             ///< Row width.
+  uint16_t height;            ///< Number of rows.
+  std::vector<uint16_t> rgb;  ///< Rows, native RGB565 (the old path).
+  std::vector<uint16_t> wire; ///< Same rows in panel byte order.
+};
+
+static File s_iconRowsFile;
+static IconRows *s_iconRowsDst = nullptr;
+
+static int captureIconRow(PNGDRAW *p) {
+  uint16_t *dst = s_iconRowsDst->rgb.data() + (size_t)p->y * p->iWidth;
+  png.getLineAsRGB565(p, dst, PNG_RGB565_LITTLE_ENDIAN, 0x0000);
+  return 1;
+}
+
+/// @brief Every icon in /images (not the full-screen backgrounds), decoded
+/// once.
+static const std::vector<IconRows> &iconRows() {
+  static std::vector<IconRows> icons;
+  if (!icons.empty())
+    return icons;
+
+  std::vector<std::string> paths;
+  File dir = LittleFS.open("/images");
+  for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+    std::string name = f.name();
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".png") == 0 &&
+        name.find("screen") == std::string::npos)
+      paths.push_back("/images/" + name);
+  }
+  std::sort(paths.begin(), paths.end());
+
+  for (const std::string &path : paths) {
+    auto open = [](const char *name, int32_t *size) -> void * {
+      s_iconRowsFile = LittleFS.open(name, "r");
+      *size = s_iconRowsFile.size();
+      return &s_iconRowsFile;
+    };
+    auto close = [](void *) { s_iconRowsFile.close(); };
+    auto read = [](PNGFILE *, uint8_t *buf, int32_t len) -> int32_t {
+      return s_iconRowsFile.read(buf, len);
+    };
+    auto seek = [](PNGFILE *, int32_t pos) -> int32_t {
+      s_iconRowsFile.seek(pos);
+      return pos;
+    };
+    if (png.open(path.c_str(), open, close, read, seek, captureIconRow) !=
+        PNG_SUCCESS)
+      continue;
+    IconRows icon;
+    icon.width = png.getWidth();
+    icon.height = png.getHeight();
+    icon.rgb.resize((size_t)icon.width * icon.height);
+    s_iconRowsDst = &icon;
+    png.decode(NULL, 0);
+    png.close();
+    for (uint16_t c : icon.rgb)
+      icon.wire.push_back((uint16_t)(c << 8 | c >> 8));
+    icons.push_back(std::move(icon));
+  }
+  return icons;
+}
+
+/**
+ * @brief Copies the opaque pixels of every icon row into a sprite, per
+ * pixel with drawPixel() (the old PNG callback) or run by run into the
+ * sprite buffer (Icon::copyOpaqueSpans()). Transparent key: black.
+ */
+static void runIconRows(benchmark::State &state, bool spans) {
+  const std::vector<IconRows> &icons = iconRows();
+  static TFT_eSPI panel;
+  TFT_eSprite spr(&panel);
+  uint16_t w = 0, h = 0;
+  for (const IconRows &icon : icons) {
+    w = max(w, icon.width);
+    h = max(h, icon.height);
+  }
+  spr.createSprite(w, h);
+  uint16_t *pixels = (uint16_t *)spr.getPointer();
+
+  uint64_t copied = 0, rows = 0;
+  for (auto _ : state) {
+    for (const IconRows &icon : icons) {
+      for (uint16_t y = 0; y < icon.height; y++) {
+        size_t at = (size_t)y * icon.width;
+        if (spans) {
+          copied += Icon::copyOpaqueSpans(pixels + (size_t)y * w,
+                                          icon.wire.data() + at, icon.width,
+                                          0x0000);
+        } else {
+          for (uint16_t x = 0; x < icon.width; x++) {
+            uint16_t c = icon.rgb[at + x];
+            if (c != 0x0000) {
+              spr.drawPixel(x, y, c);
+              copied++;
+            }
+          }
+        }
+      }
+      rows += icon.height;
+    }
+    benchmark::DoNotOptimize(pixels[0]);
+  }
+  state.counters["icons"] = (double)icons.size() * state.iterations();
+  state.counters["rows"] = (double)rows;
+  state.counters["opaque_px"] = (double)copied;
+}
+
+static void BM_IconRowsDrawPixel(benchmark::State &state) {
+  runIconRows(state, false);
+}
+BENCHMARK(BM_IconRowsDrawPixel);
+
+static void BM_IconRowsSpans(benchmark::State &state) {
+  runIconRows(state, true);
+}
+BENCHMARK(BM_IconRowsSpans);
+
+// WIFI_CONNECTION_SCREEN is left out: entering it starts the provisioning
+// portal, which permanently switches the network stack into AP mode.
+
+/// @brief One DS18B20 conversion, started and read back.
+static void runConversion() {
+  host::advanceMicros(INDOOR_TEMP_INTERVAL_MS * 1000ULL);
+  sensorMgr->update();
+  host::advanceMicros(1000000);
+  sensorMgr->update();
+}
+
+/// @brief Puts @p count probes on the bus and lets the firmware find them.
+static void setProbes(const float *temps, uint8_t count) {
+  // A probe that stops answering makes the next conversion rescan the bus.
+  host::setProbeTemps(nullptr, 0);
+  runConversion();
+  host::setProbeTemps(temps, count);
+  runConversion();
+}
+
+/// @brief A new outdoor reading per iteration, through the ESP-NOW
+/// callback; with @p probes > 1, new probe temperatures as well.
+static void runHomeDataRedraw(benchmark::State &state, uint8_t probes) {
+  bench::bootFirmware();
+  float temps[MAX_TEMP_PROBES] = {21.5f, 19.0f, 45.5f, -12.5f};
+  if (probes > 1)
+    setProbes(temps, probes);
+  uiMgr->changeScreen(HOME_SCREEN);
+  resetDisplayCounters();
+  heapTracker.reset();
+  uiMgr->iconCache().resetStats();
+  uint32_t seq = 0;
+  for (auto _ : state) {
+    struct_message m = bench::sampleReading(seq++);
+    bench::injectReading(m);
+    netMgr->pollEspNow();
+    if (probes > 1) {
+      for (uint8_t i = 1; i < probes; i++)
+        temps[i] += 0.5f;
+      host::setProbeTemps(temps, probes);
+      runConversion();
+    }
+    uiMgr->update();
+  }
+  reportDisplayCounters(state);
+  reportHeapCounters(state, HEAP_SITE_DRAW_DYNAMIC);
+  reportIconCache(state);
+  state.counters["font_loads"] = TFT_eSPI::hostStats().fontLoads;
+  if (probes > 1)
+    setProbes(temps, 1);
+}
+
+static void BM_HomeDataRedraw(benchmark::State &state) {
+  runHomeDataRedraw(state, 1);
+}
+BENCHMARK(BM_HomeDataRedraw);
+
+/// @brief The home screen with three extra probes on its bottom line.
+static void BM_HomeDataRedrawProbes(benchmark::State &state) {
+  runHomeDataRedraw(state, 4);
+}
+BENCHMARK(BM_HomeDataRedrawProbes);
+
+/// @brief Minute redraws; with @p spriteLimit, sprites above it fail.
+static void runHomeClockMinute(benchmark::State &state, size_t spriteLimit) {
+  bench::bootFirmware();
+  uiMgr->changeScreen(HOME_SCREEN);
+  uiMgr->update();
+  TFT_eSPI::hostSetSpriteLimit(spriteLimit);
+  resetDisplayCounters();
+  heapTracker.reset();
+  uiMgr->iconCache().resetStats();
+  for (auto _ : state) {
+    host::advanceMicros(60ULL * 1000000); // Next minute on the RTC.
+    uiMgr->update();
+  }
+  TFT_eSPI::hostSetSpriteLimit(0);
+  reportDisplayCounters(state);
+  reportHeapCounters(state, HEAP_SITE_ICON_LOAD);
+  state.counters["font_loads"] = TFT_eSPI::hostStats().fontLoads;
+  state.counters["icon_evictions"] = uiMgr->iconCache().stats().evictions;
+}
+
+static void BM_HomeClockMinute(benchmark::State &state) {
+  runHomeClockMinute(state, 0);
+}
+BENCHMARK(BM_HomeClockMinute);
+
+/// @brief As above with no heap block for the 64 KB clock panel sprite.
+static void BM_HomeClockMinuteLowRam(benchmark::State &state) {
+  runHomeClockMinute(state, ICON_CACHE_BUDGET_BYTES / 2);
+}
+BENCHMARK(BM_HomeClockMinuteLowRam);
+
+/// @brief An NTP sync against an RTC 7 minutes off, winter and summer.
+/// hour_errors is the share of syncs after which the home clock or the RTC
+/// did not show local time; it must be 0.
+static void BM_ClockNtpSync(benchmark::State &state) {
+  struct Case {
+    uint32_t utc; ///< NTP time.
+    uint8_t hour; ///< Local hour at utc (Poland).
+  };
+  static const Case kCases[] = {{1768478400, 13},  // 2026-01-15 12:00 UTC.
+                                {1784116800, 14}}; // 2026-07-15 12:00 UTC.
+  bench::bootFirmware();
+  uiMgr->changeScreen(HOME_SCREEN);
+  RTC_DS3231 rtc;
+  uint32_t errors = 0, i = 0;
+  for (auto _ : state) {
+    const Case &c = kCases[i++ % 2];
+    uint32_t local = c.utc + (c.hour - 12) * 3600;
+    host::setRtcUnixTime(local + 7 * 60);
+    sysClock.syncFromRtc();
+    host::setNtpUnixTime(c.utc);
+    host::tlsDropConnections();
+    netMgr->loop(); // Reconnects, which syncs NTP.
+    uiMgr->update();
+    if (now.hour() != c.hour || now.minute() != 0 ||
+        rtc.now().hour() != c.hour)
+      errors++;
+  }
+  state.counters["hour_errors"] = errors;
+}
+BENCHMARK(BM_ClockNtpSync);
+
+static void BM_HomeIdleLoop(benchmark::State &state) {
+  bench::bootFirmware();
+  uiMgr->changeScreen(HOME_SCREEN);
+  uiMgr->update();
+  resetDisplayCounters();
+  Wire.hostResetStats();
+  for (auto _ : state) {
+    host::advanceMicros(10000); // One loop() delay, panel untouched.
+    uiMgr->update();
+  }
+  state.counters["touch_reads"] = TFT_eSPI::hostStats().touchReads;
+  state.counters["i2c"] = Wire.hostTransactions();
+}
+BENCHMARK(BM_HomeIdleLoop);
+
+static void BM_BacklightAuto(benchmark::State &state) {
+  bench::bootFirmware();
+  autoBrightness = true;
+  uint32_t fades0 = host::ledcFades();
+  uint64_t adc0 = host::adcDmaSamples();
+  uint32_t i = 0;
+  for (auto _ : state) {
+    // Sensor noise of +-40 counts around a steady room light.
+    host::setAnalog(FOTORESISTOR_PIN, (i++ & 1) ? 2440 : 2360);
+    host::advanceMicros(10000);
+    sensorMgr->update();
+  }
+  autoBrightness = false;
+  state.counters["ledc_fades"] = host::ledcFades() - fades0;
+  state.counters["adc_samples"] = (double)(host::adcDmaSamples() - adc0);
+}
+BENCHMARK(BM_BacklightAuto);
+
+static void BM_TouchTap(benchmark::State &state) {
+  bench::bootFirmware();
+  uiMgr->changeScreen(HOME_SCREEN);
+  uiMgr->update();
+  resetDisplayCounters();
+  for (auto _ : state) {
+    // 100 ms press on empty panel, sampled by 10 ms loops until released.
+    TFT_eSPI::hostSetTouch(true, 240, 160);
+    host::setDigitalInput(TOUCH_IRQ_PIN, LOW);
+    for (int i = 0; i < 10; i++) {
+      host::advanceMicros(10000);
+      uiMgr->update();
+    }
+    TFT_eSPI::hostSetTouch(false);
+    host::setDigitalInput(TOUCH_IRQ_PIN, HIGH);
+    for (int i = 0; i < 4; i++) {
+      host::advanceMicros(10000);
+      uiMgr->update();
+    }
+  }
+  state.counters["touch_reads"] = TFT_eSPI::hostStats().touchReads;
+}
+BENCHMARK(BM_TouchTap);
+
+static void BM_EspNowReceive(benchmark::State &state) {
+  bench::bootFirmware();
+  uint32_t seq = 0;
+  uint32_t dropped0 = netMgr->espNowDropped();
+  for (auto _ : state) {
+    // Callback into the ring, then loop() taking it out.
+    struct_message m = bench::sampleReading(seq++);
+    bench::injectReading(m);
+    netMgr->pollEspNow();
+  }
+  screenDataDirty = false;
+  state.counters["dropped"] = netMgr->espNowDropped() - dropped0;
+}
+BENCHMARK(BM_EspNowReceive);
+
+/// @brief One outdoor node's frames through wireDecode() and
+/// Station::trackSeq(): v1 and v2 frames, a retry, a corrupted frame, a
+/// seq wrap and a restart. The verdicts are checked in test/test_wire.
+static void BM_EspNowWire(benchmark::State &state) {
+  struct Step {
+    uint8_t kind;  ///< 1 = v1, 2 = v2, 'c' = v2 bit flip.
+    uint16_t seq;  ///< v2 sequence number.
+    uint8_t flags; ///< v2 flags.
+  };
+  static const Step kSteps[] = {
+      {2, 40000, WIRE_FLAG_RESTART}, {2, 40000, WIRE_FLAG_RESTART},
+      {2, 40002, 0},                 {'c', 40003, 0},
+      {2, 40004, 0},                 {1, 0, 0},
+      {2, 1, WIRE_FLAG_RESTART},     {2, 65535, 0},
+      {2, 0, 0},                     {2, 2, 0},
+  };
+  struct Frame {
+    uint8_t buf[sizeof(WireFrameV2)];
+    size_t len;
+  };
+  Frame frames[sizeof(kSteps) / sizeof(kSteps[0])];
+  for (size_t i = 0; i < sizeof(kSteps) / sizeof(kSteps[0]); i++) {
+    const Step &s = kSteps[i];
+    struct_message m = bench::sampleReading(i);
+    WireFrameV2 f = wireEncode(m, s.seq, s.flags);
+    Frame &out = frames[i];
+    out.len = sizeof(WireFrameV2);
+    memcpy(out.buf, &f, out.len);
+    if (s.kind == 1) {
+      // The padded struct the first firmware sent.
+      out.len = METEO_WIRE_V1_SIZE;
+      memset(out.buf, 0, out.len);
+      out.buf[0] = m.humidityRead;
+      memcpy(out.buf + 2, &m.outdoorTemperatureRead, 2);
+      memcpy(out.buf + 4, &m.pressureRead, 2);
+      out.buf[6] = m.uvIndexRead;
+    } else if (s.kind == 'c') {
+      out.buf[offsetof(WireFrameV2, temperature)] ^= 0x10;
+    }
+  }
+
+  for (auto _ : state) {
+    Station st;
+    for (const Frame &f : frames) {
+      WireReading r{};
+      if (wireDecode(f.buf, f.len, r) == WIRE_OK && r.version >= 2)
+        benchmark::DoNotOptimize(
+            st.trackSeq(r.seq, r.flags & WIRE_FLAG_RESTART));
+    }
+    benchmark::DoNotOptimize(st);
+  }
+}
+BENCHMARK(BM_EspNowWire);
+
+/// @brief One reading in, one publish out, in the given session mode.
+static void runPublishCycle(benchmark::State &state, bool persistent) {
+  bench::bootFirmware();
+  netMgr->setPersistentSession(persistent);
+  netMgr->loop(); // Session set up (or torn down) outside the timing.
+  host::mqttResetStats();
+  heapTracker.reset();
+  uint32_t seq = 0;
+  uint32_t joins0 = host::wifiJoinCount();
+  for (auto _ : state) {
+    struct_message m = bench::sampleReading(seq++);
+    bench::injectReading(m);
+    netMgr->loop();
+  }
+  state.counters["publishes"] = host::mqttPublishCount();
+  state.counters["tls_handshakes"] = host::tlsHandshakeCount();
+  state.counters["wifi_joins"] = host::wifiJoinCount() - joins0;
+  reportHeapCounters(state, HEAP_SITE_CONNECT_AWS);
+  reportHeapCounters(state, HEAP_SITE_PUBLISH);
+  netMgr->setPersistentSession(NET_PERSISTENT_SESSION);
+}
+
+static void BM_PublishCycle(benchmark::State &state) {
+  runPublishCycle(state, true);
+}
+BENCHMARK(BM_PublishCycle);
+
+/// @brief The per-reading join, handshake and teardown of the old mode.
+static void BM_PublishCycleReconnect(benchmark::State &state) {
+  runPublishCycle(state, false);
+}
+BENCHMARK(BM_PublishCycleReconnect);
+
+/// @brief The broker drops the session once per iteration and loop()
+/// reconnects. The handshake itself is a fixed charge of the stand-in;
+/// what is measured is the firmware's side: credential bytes read from
+/// LittleFS and connectAWS() allocations. With @p reload the credentials
+/// are read for every connection, as they used to be.
+static void runTlsReconnect(benchmark::State &state, bool reload) {
+  bench::bootFirmware();
+  netMgr->setPersistentSession(true);
+  netMgr->forgetCredentials();
+  host::tlsDropConnections();
+  netMgr->loop(); // First connection reads the credentials.
+  LittleFS.resetStats();
+  host::mqttResetStats();
+  heapTracker.reset();
+  for (auto _ : state) {
+    if (reload)
+      netMgr->forgetCredentials();
+    host::tlsDropConnections();
+    netMgr->loop();
+  }
+  state.counters["tls_handshakes"] = host::tlsHandshakeCount();
+  state.counters["fs_bytes"] = (double)LittleFS.bytesRead();
+  reportHeapCounters(state, HEAP_SITE_CONNECT_AWS);
+}
+
+static void BM_TlsReconnect(benchmark::State &state) {
+  runTlsReconnect(state, false);
+}
+BENCHMARK(BM_TlsReconnect);
+
+static void BM_TlsReconnectReload(benchmark::State &state) {
+  runTlsReconnect(state, true);
+}
+BENCHMARK(BM_TlsReconnectReload);
+
+void loop();
+
+/// @brief Formats the profiler's p99/max of every loop stage.
+static std::string profilerLabel() {
+  static const char *const names[PROFILE_STAGE_COUNT] = {"net", "sensor",
+                                                          "ui"};
+  std::string label;
+  char buf[64];
+  for (uint8_t s = 0; s < PROFILE_STAGE_COUNT; s++) {
+    const LatencyHistogram &h = loopProfiler.histogram((ProfileStage)s);
+    float mhz = ESP.getCpuFreqMHz();
+    std::snprintf(buf, sizeof(buf), "%s%s_p99/max=%.2f/%.2fms",
+                  label.empty() ? "" : " ", names[s],
+                  h.percentile(990) / mhz / 1000.0f, h.max() / mhz / 1000.0f);
+    label += buf;
+  }
+  return label;
+}
+
+static void BM_MainLoopWithReadings(benchmark::State &state) {
+  bench::bootFirmware();
+  uiMgr->changeScreen(HOME_SCREEN);
+  loopProfiler.reset();
+  uint32_t i = 0;
+  for (auto _ : state) {
+    // One outdoor reading per 50 loop iterations.
+    if (i % 50 == 0) {
+      struct_message m = bench::sampleReading(i / 50);
+      bench::injectReading(m);
+    }
+    i++;
+    loop();
+  }
+  state.SetLabel(profilerLabel());
+}
+BENCHMARK(BM_MainLoopWithReadings);
@@ -0,0 +1,51 @@
+/**
+ * @file main.cpp
+ * @brief Entry point of the native benchmark suite.
+ *
+ * Usage: program [--benchmark_filter=<substr>] [--benchmark_format=json]
+ *                [--benchmark_out=<file>] [--benchmark_min_time=<s>]
+ *        program --frame_report[=<file>]
+ *        program --radio_report[=<file>]
+ */
+
+#include "Bench.h"
+#include "FrameReport.h"
+#include "RadioReport.h"
+
+#include <cstring>
+
+namespace {
+/**
+ * @brief Runs @p report if @p arg is `<flag>` or `<flag>=<file>`.
+ * @return -1 if @p arg is a different flag, else the exit code.
+ */
+int runReport(const char *arg, const char *flag, void (*report)(std::FILE *)) {
+  size_t n = std::strlen(flag);
+  if (std::strncmp(arg, flag, n) != 0 || (arg[n] != '\0' && arg[n] != '='))
+    return -1;
+  const char *path = arg[n] == '=' ? arg + n + 1 : nullptr;
+  std::FILE *out = path ? std::fopen(path, "w") : stdout;
+  if (!out) {
+    std::fprintf(stderr, "cannot open %s\n", path);
+    return 1;
+  }
+  report(out);
+  if (out != stdout)
+    std::fclose(out);
+  return 0;
+}
+} // namespace
+
+// The unit tests in test/ bring their own main().
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    int rc = runReport(argv[i], "--frame_report", bench::writeFrameReport);
+    if (rc < 0)
+      rc = runReport(argv[i], "--radio_report", bench::writeRadioReport);
+    if (rc >= 0)
+      return rc;
+  }
+  return benchmark::RunSpecifiedBenchmarks(argc, argv);
+}
+#endif
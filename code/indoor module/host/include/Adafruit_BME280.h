@@ -0,0 +1,60 @@
+/**
+ * @file Adafruit_BME280.h
+ * @brief Host stand-in for the BME280 driver used by the outdoor module.
+ *
+ * A forced measurement costs the sensor's conversion time in virtual delay.
+ * Readings come from host::setBme280().
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <Wire.h>
+
+#include "Adafruit_Sensor.h"
+
+/**
+ * @class Adafruit_BME280
+ * @brief Temperature / pressure / humidity sensor on I2C.
+ */
+class Adafruit_BME280 {
+public:
+  enum sensor_mode { MODE_SLEEP = 0, MODE_FORCED = 1, MODE_NORMAL = 3 };
+  enum sensor_sampling {
+    SAMPLING_NONE = 0,
+    SAMPLING_X1,
+    SAMPLING_X2,
+    SAMPLING_X4,
+    SAMPLING_X8,
+    SAMPLING_X16
+  };
+  enum sensor_filter {
+    FILTER_OFF = 0,
+    FILTER_X2,
+    FILTER_X4,
+    FILTER_X8,
+    FILTER_X16
+  };
+  enum standby_duration { STANDBY_MS_0_5 = 0, STANDBY_MS_1000 = 5 };
+
+  bool begin(uint8_t addr = 0x77, TwoWire *wire = &Wire);
+  void setSampling(sensor_mode mode = MODE_NORMAL,
+                   sensor_sampling tempSampling = SAMPLING_X16,
+                   sensor_sampling pressSampling = SAMPLING_X16,
+                   sensor_sampling humSampling = SAMPLING_X16,
+                   sensor_filter filter = FILTER_OFF,
+                   standby_duration duration = STANDBY_MS_0_5);
+  bool takeForcedMeasurement();
+  float readTemperature();
+  float readPressure();
+  float readHumidity();
+
+private:
+  TwoWire *_wire = &Wire;
+  uint8_t _oversampling = 1; ///< Sum of the three oversampling factors.
+};
+
+namespace host {
+/// @brief Sets the values the simulated BME280 reports.
+void setBme280(float tempC, float pressurePa, float humidity,
+               bool present = true);
+} // namespace host
@@ -0,0 +1,34 @@
+/**
+ * @file Adafruit_NeoPixel.h
+ * @brief Host stand-in for the NeoPixel driver (outdoor status LED).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#define NEO_GRB 0x52
+#define NEO_KHZ800 0x0000
+
+/**
+ * @class Adafruit_NeoPixel
+ * @brief WS2812 strip; show() only counts frames.
+ */
+class Adafruit_NeoPixel {
+public:
+  Adafruit_NeoPixel(uint16_t n, int16_t pin, uint16_t type)
+      : _count(n), _pin(pin), _type(type) {}
+  void begin() {}
+  void clear() {}
+  void show() { _shows++; }
+  void setPixelColor(uint16_t n, uint32_t c) {
+    (void)n;
+    (void)c;
+  }
+  uint32_t shows() const { return _shows; }
+
+private:
+  uint16_t _count;
+  int16_t _pin;
+  uint16_t _type;
+  uint32_t _shows = 0;
+};
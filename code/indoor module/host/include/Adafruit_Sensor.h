@@ -0,0 +1,7 @@
+/**
+ * @file Adafruit_Sensor.h
+ * @brief Host stand-in for the Adafruit unified sensor base (outdoor node).
+ */
+
+#pragma once
+#include <Arduino.h>
@@ -0,0 +1,189 @@
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Arduino-ESP32 core used by the native build.
+ *
+ * Time is a virtual clock: delay() advances it without sleeping.
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <math.h>
+
+#include "IPAddress.h"
+#include "WString.h"
+#include "esp_attr.h"
+#include "esp_sleep.h"
+
+using std::max;
+using std::min;
+#define constrain(amt, low, high)                                              \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define PROGMEM
+#define F(s) (s)
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+// --- Timing ---
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// --- GPIO / ADC / PWM ---
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint16_t analogRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+/// @brief ADC1 channel of a pin, or -1 (ADC2 is not modelled).
+int8_t digitalPinToAnalogChannel(uint8_t pin);
+
+// --- Interrupts ---
+#define digitalPinToInterrupt(p) (p)
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode);
+void detachInterrupt(uint8_t pin);
+
+// --- ESP32 specifics ---
+uint32_t esp_random();
+void configTime(long gmtOffset_sec, int daylightOffset_sec,
+                const char *server1, const char *server2 = nullptr,
+                const char *server3 = nullptr);
+void configTzTime(const char *tz, const char *server1,
+                  const char *server2 = nullptr,
+                  const char *server3 = nullptr);
+
+/**
+ * @class HardwareSerial
+ * @brief Serial port writing to stdout.
+ *
+ * Output is formatted (so its CPU cost is still paid) but only echoed when
+ * enabled with host::setSerialEcho() or the METEO_HOST_SERIAL env variable,
+ * which keeps benchmark output readable.
+ */
+class HardwareSerial {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  void flush() { std::fflush(stdout); }
+
+  /// @brief Bytes queued with host::serialInput() not yet read.
+  int available();
+  /// @brief Next input byte, or -1 if none.
+  int read();
+
+  size_t print(const char *s);
+  size_t print(const String &s) { return print(s.c_str()); }
+  size_t print(char c);
+  size_t print(int v);
+  size_t print(unsigned int v);
+  size_t print(long v);
+  size_t print(unsigned long v);
+  size_t print(double v, int decimals = 2);
+
+  size_t println() { return print("\n"); }
+  template <typename T> size_t println(const T &v) {
+    size_t n = print(v);
+    return n + print("\n");
+  }
+
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+};
+
+extern HardwareSerial Serial;
+
+/**
+ * @class EspClass
+ * @brief Subset of the ESP object (chip control and heap statistics).
+ */
+class EspClass {
+public:
+  [[noreturn]] void restart();
+  uint32_t getFreeHeap();
+  uint32_t getMaxAllocHeap();
+  /// @brief CCOUNT: CPU cycles at getCpuFreqMHz(), wrapping at 32 bits.
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+};
+
+extern EspClass ESP;
+
+/**
+ * @namespace host
+ * @brief Hooks used by the native build and benchmarks to drive the
+ * stand-ins.
+ */
+namespace host {
+/// @brief Enables or disables echoing Serial output to stdout.
+void setSerialEcho(bool on);
+
+/// @brief Queues bytes for Serial.available()/read().
+void serialInput(const char *s);
+
+/// @brief Advances the virtual clock, running events that fall due.
+void advanceMicros(uint64_t us);
+
+/// @brief Current time of the clock behind micros().
+uint64_t nowMicros();
+
+/// @brief Selects wall time + virtual time (true) or virtual time only.
+void setRealTimeClock(bool on);
+
+/**
+ * @brief Stretches the wall time micros() sees by @p factor, so code that
+ * runs several times slower on the ESP32 takes about as long on the clock.
+ */
+void setCpuScale(double factor);
+
+/**
+ * @brief Takes @p ns of wall time that just elapsed back off the clock,
+ * for host work that stands in for hardware (e.g. a modelled SPI bus).
+ */
+void excludeWallTime(uint64_t ns);
+
+/// @brief Virtual time each yield() consumes when the clock is virtual.
+void setYieldMicros(uint32_t us);
+
+/// @brief Runs @p fn once the clock reaches @p atUs.
+void scheduleAt(uint64_t atUs, std::function<void()> fn);
+
+/// @brief Runs @p fn @p us microseconds from now.
+void scheduleIn(uint64_t us, std::function<void()> fn);
+
+/// @brief Drops all pending scheduled events.
+void clearScheduledEvents();
+
+/// @brief Total time the firmware spent inside delay() (virtual).
+uint64_t blockedMicros();
+
+/// @brief Sets the value returned by analogRead() for a pin.
+void setAnalog(uint8_t pin, uint16_t value);
+
+/// @brief Last value written with analogWrite() to a pin.
+int lastAnalogWrite(uint8_t pin);
+
+/**
+ * @brief Drives an input pin from outside (a peripheral's output), running
+ * the ISR attached to it if the edge matches its mode.
+ */
+void setDigitalInput(uint8_t pin, uint8_t level);
+} // namespace host
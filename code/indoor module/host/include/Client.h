@@ -0,0 +1,24 @@
+/**
+ * @file Client.h
+ * @brief Host stand-in for the Arduino Client interface.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @class Client
+ * @brief Abstract byte-stream connection.
+ */
+class Client {
+public:
+  virtual ~Client() = default;
+  virtual int connect(const char *host, uint16_t port) = 0;
+  virtual size_t write(const uint8_t *buf, size_t size) = 0;
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual void flush() {}
+  virtual void stop() = 0;
+  virtual uint8_t connected() = 0;
+  virtual operator bool() { return connected(); }
+};
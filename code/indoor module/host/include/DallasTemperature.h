@@ -0,0 +1,69 @@
+/**
+ * @file DallasTemperature.h
+ * @brief Host stand-in for the DallasTemperature (DS18B20) library.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "OneWire.h"
+
+#define DEVICE_DISCONNECTED_C -127
+#define DEVICE_DISCONNECTED_RAW -7040
+
+typedef uint8_t DeviceAddress[8];
+
+/**
+ * @class DallasTemperature
+ * @brief DS18B20 driver.
+ */
+class DallasTemperature {
+public:
+  explicit DallasTemperature(OneWire *wire) : _wire(wire) {}
+
+  void begin();
+  uint8_t getDeviceCount();
+  bool getAddress(uint8_t *address, uint8_t index);
+  bool isConnected(const uint8_t *address);
+
+  void setResolution(uint8_t bits);
+  bool setResolution(const uint8_t *address, uint8_t bits);
+  uint8_t getResolution() const { return _resolution; }
+  void setWaitForConversion(bool wait) { _waitForConversion = wait; }
+  bool getWaitForConversion() const { return _waitForConversion; }
+  uint16_t millisToWaitForConversion(uint8_t bits) const;
+
+  struct request_t {
+    bool result;
+    unsigned long timestamp;
+    operator bool() { return result; }
+  };
+
+  request_t requestTemperatures();
+  request_t requestTemperaturesByAddress(const uint8_t *address);
+  request_t requestTemperaturesByIndex(uint8_t index);
+  bool isConversionComplete();
+
+  float getTempC(const uint8_t *address);
+  float getTempCByIndex(uint8_t index);
+
+private:
+  OneWire *_wire;
+  uint8_t _resolution = 12;
+  bool _waitForConversion = true;
+  unsigned long _conversionStartMs = 0; ///< Start of pending conversion.
+  bool _converting = false;
+};
+
+namespace host {
+/**
+ * @brief Configures the simulated probes on the 1-Wire bus.
+ * @param temps Temperatures in Celsius, one per probe.
+ * @param count Number of probes (0 = none connected).
+ */
+void setProbeTemps(const float *temps, uint8_t count);
+
+/// @brief Number of 1-Wire bus resets/commands issued since the last reset.
+uint32_t oneWireTransactions();
+void oneWireResetStats();
+} // namespace host
@@ -0,0 +1,27 @@
+/**
+ * @file ESPAsyncDNSServer.h
+ * @brief Host stand-in for the captive-portal DNS server.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @class AsyncDNSServer
+ * @brief DNS responder that resolves every name to one address.
+ */
+class AsyncDNSServer {
+public:
+  bool start(uint16_t port, const String &domainName,
+             const IPAddress &resolvedIP) {
+    (void)port;
+    (void)domainName;
+    (void)resolvedIP;
+    _running = true;
+    return true;
+  }
+  void stop() { _running = false; }
+
+private:
+  bool _running = false;
+};
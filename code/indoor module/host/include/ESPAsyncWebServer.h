@@ -0,0 +1,103 @@
+/**
+ * @file ESPAsyncWebServer.h
+ * @brief Host stand-in for ESPAsyncWebServer.
+ *
+ * Routes are registered but never served; the provisioning portal is not
+ * exercised by the native build.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+#include <functional>
+
+typedef enum {
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+
+/**
+ * @class AsyncWebParameter
+ * @brief One query or form parameter.
+ */
+class AsyncWebParameter {
+public:
+  const String &name() const { return _name; }
+  const String &value() const { return _value; }
+
+private:
+  String _name;
+  String _value;
+};
+
+/**
+ * @class AsyncWebServerRequest
+ * @brief Incoming HTTP request.
+ */
+class AsyncWebServerRequest {
+public:
+  bool hasParam(const char *name, bool post = false) const {
+    (void)name;
+    (void)post;
+    return false;
+  }
+  const AsyncWebParameter *getParam(const char *name, bool post = false) const {
+    (void)name;
+    (void)post;
+    return &_empty;
+  }
+  void send(int code, const char *contentType = "",
+            const String &content = String()) {
+    (void)code;
+    (void)contentType;
+    (void)content;
+  }
+  void redirect(const char *url) { (void)url; }
+
+private:
+  AsyncWebParameter _empty;
+};
+
+typedef std::function<void(AsyncWebServerRequest *)> ArRequestHandlerFunction;
+
+/**
+ * @class AsyncWebHandler
+ * @brief Registered route.
+ */
+class AsyncWebHandler {
+public:
+  AsyncWebHandler &setDefaultFile(const char *filename) {
+    (void)filename;
+    return *this;
+  }
+};
+
+/**
+ * @class AsyncWebServer
+ * @brief Asynchronous HTTP server.
+ */
+class AsyncWebServer {
+public:
+  explicit AsyncWebServer(uint16_t port) : _port(port) {}
+
+  AsyncWebHandler &serveStatic(const char *uri, fs::FS &fs, const char *path) {
+    (void)uri;
+    (void)fs;
+    (void)path;
+    return _handler;
+  }
+  AsyncWebHandler &on(const char *uri, WebRequestMethod method,
+                      ArRequestHandlerFunction onRequest) {
+    (void)uri;
+    (void)method;
+    (void)onRequest;
+    return _handler;
+  }
+  void onNotFound(ArRequestHandlerFunction fn) { (void)fn; }
+  void begin() {}
+
+private:
+  uint16_t _port;
+  AsyncWebHandler _handler;
+};
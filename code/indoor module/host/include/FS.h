@@ -0,0 +1,112 @@
+/**
+ * @file FS.h
+ * @brief Host stand-in for the Arduino-ESP32 filesystem API.
+ *
+ * Files live under a host directory; in-memory overlays can shadow them.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "WString.h"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct FileImpl;
+
+/**
+ * @class File
+ * @brief Handle to an open file or directory.
+ */
+class File {
+public:
+  File() = default;
+  explicit File(std::shared_ptr<FileImpl> impl) : _impl(std::move(impl)) {}
+
+  operator bool() const;
+  size_t size() const;
+  size_t position() const;
+  int available();
+  int read();
+  size_t read(uint8_t *buf, size_t len);
+  size_t write(const uint8_t *buf, size_t len);
+  size_t write(uint8_t c) { return write(&c, 1); }
+  bool seek(uint32_t pos, SeekMode mode = SeekSet);
+  String readString();
+  void close();
+
+  const char *name() const;
+  const char *path() const;
+  bool isDirectory() const;
+  File openNextFile();
+
+private:
+  std::shared_ptr<FileImpl> _impl;
+};
+
+/**
+ * @class FS
+ * @brief Filesystem rooted in a host directory.
+ */
+class FS {
+public:
+  explicit FS(const char *root);
+
+  File open(const char *path, const char *mode = "r");
+  File open(const String &path, const char *mode = "r") {
+    return open(path.c_str(), mode);
+  }
+  bool exists(const char *path);
+  bool remove(const char *path);
+
+  /// @brief Changes the host directory backing this filesystem.
+  void setRoot(const char *root) { _root = root; }
+  const std::string &root() const { return _root; }
+
+  /**
+   * @brief Adds (or replaces) an in-memory file that shadows the host tree.
+   * @param path Absolute path inside the filesystem (e.g. "/certs/a.pem").
+   * @param data File contents.
+   */
+  void addOverlay(const char *path, const std::string &data);
+  void removeOverlay(const char *path);
+  void clearOverlay();
+
+  /// @brief Total bytes returned by File::read() since the last reset.
+  uint64_t bytesRead() const { return _bytesRead; }
+  /// @brief Number of successful open() calls since the last reset.
+  uint32_t opens() const { return _opens; }
+  /// @brief Wall time spent inside File::read() since the last reset.
+  uint64_t readNanos() const { return _readNs; }
+  void resetStats() {
+    _bytesRead = 0;
+    _opens = 0;
+    _readNs = 0;
+  }
+
+  void noteRead(size_t n, uint64_t ns) {
+    _bytesRead += n;
+    _readNs += ns;
+  }
+
+private:
+  std::string hostPath(const char *path) const;
+
+  std::string _root;
+  std::vector<std::pair<std::string, std::shared_ptr<std::vector<uint8_t>>>>
+      _overlay;
+  uint64_t _bytesRead = 0;
+  uint32_t _opens = 0;
+  uint64_t _readNs = 0;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
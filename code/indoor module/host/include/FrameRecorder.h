@@ -0,0 +1,49 @@
+/**
+ * @file FrameRecorder.h
+ * @brief Per-call rendering cost records collected from the firmware's
+ * trace hooks (see src/Trace.h).
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Trace.h"
+
+namespace host {
+
+/**
+ * @struct FrameRecord
+ * @brief Cost of one traced UI call (changeScreen, dynamic data, clock).
+ *
+ * Nested calls (e.g. the clock drawn from changeScreen(HOME_SCREEN)) get
+ * their own record; their cost is also included in the enclosing one.
+ */
+struct FrameRecord {
+  TraceId id;              ///< Traced region.
+  int32_t arg;             ///< Region argument (SCREEN for changeScreen).
+  uint8_t depth;           ///< Nesting depth (0 = outermost).
+  uint64_t wallNs;         ///< Total wall time.
+  uint64_t pixels;         ///< Pixels written to the panel.
+  uint32_t pushImageCalls; ///< pushImage() calls on the panel.
+  uint32_t streamCalls;    ///< pushPixels()/pushBlock() calls on the panel.
+  uint32_t fillCalls;      ///< fillRect()/fillScreen() calls.
+  uint32_t fontLoads;      ///< loadFont() calls.
+  uint64_t driverNs;       ///< Time inside panel driver calls.
+  uint64_t fsBytes;        ///< Bytes read from LittleFS.
+  uint32_t fsOpens;        ///< Files opened on LittleFS.
+  uint64_t fsNs;           ///< Time inside LittleFS reads.
+  uint32_t pngDecodes;     ///< PNG images decoded.
+  uint64_t inflateNs;      ///< PNG decode time excluding file reads and
+                           ///< panel pushes.
+  uint32_t rleDecodes;     ///< Pre-decoded .rle images streamed.
+  uint64_t rleNs;          ///< .rle unpack time excluding file reads and
+                           ///< panel pushes.
+};
+
+/// @brief Records completed since the last clearFrameRecords(), in call
+/// order.
+const std::vector<FrameRecord> &frameRecords();
+void clearFrameRecords();
+
+} // namespace host
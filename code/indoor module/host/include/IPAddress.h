@@ -0,0 +1,22 @@
+/**
+ * @file IPAddress.h
+ * @brief Host stand-in for the Arduino IPAddress class.
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @class IPAddress
+ * @brief IPv4 address value type.
+ */
+class IPAddress {
+public:
+  IPAddress() : _addr{0, 0, 0, 0} {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _addr{a, b, c, d} {}
+
+  uint8_t operator[](int i) const { return _addr[i & 3]; }
+
+private:
+  uint8_t _addr[4];
+};
@@ -0,0 +1,28 @@
+/**
+ * @file LittleFS.h
+ * @brief Host stand-in for the LittleFS flash filesystem.
+ *
+ * Backed by the project's data/ directory (override with the METEO_FS_ROOT
+ * environment variable).
+ */
+
+#pragma once
+#include "FS.h"
+
+namespace fs {
+
+/**
+ * @class LittleFSFS
+ * @brief LittleFS mounted from a host directory.
+ */
+class LittleFSFS : public FS {
+public:
+  LittleFSFS();
+  bool begin(bool formatOnFail = false, const char *basePath = "/littlefs",
+             uint8_t maxOpenFiles = 10, const char *partitionLabel = "spiffs");
+  void end() {}
+};
+
+} // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,20 @@
+/**
+ * @file OneWire.h
+ * @brief Host stand-in for the OneWire bus.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @class OneWire
+ * @brief 1-Wire master on a GPIO pin.
+ */
+class OneWire {
+public:
+  explicit OneWire(uint8_t pin) : _pin(pin) {}
+  uint8_t pin() const { return _pin; }
+
+private:
+  uint8_t _pin;
+};
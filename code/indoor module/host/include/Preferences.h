@@ -0,0 +1,33 @@
+/**
+ * @file Preferences.h
+ * @brief Host stand-in for the ESP32 NVS Preferences API.
+ *
+ * Namespaces are kept in process memory for the lifetime of the program.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @class Preferences
+ * @brief Key/value storage grouped in namespaces.
+ */
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly = false,
+             const char *partitionLabel = nullptr);
+  void end();
+  bool clear();
+  bool remove(const char *key);
+  bool isKey(const char *key);
+
+  String getString(const char *key, const String &defaultValue = String());
+  size_t putString(const char *key, const String &value);
+  uint32_t getUInt(const char *key, uint32_t defaultValue = 0);
+  size_t putUInt(const char *key, uint32_t value);
+
+private:
+  String _ns;             ///< Currently open namespace.
+  bool _readOnly = false; ///< Namespace opened read-only.
+  bool _open = false;     ///< begin() was called without end().
+};
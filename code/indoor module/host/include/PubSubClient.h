@@ -0,0 +1,66 @@
+/**
+ * @file PubSubClient.h
+ * @brief Host stand-in for the PubSubClient MQTT library.
+ *
+ * Published messages are counted and the last one is kept for inspection.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <functional>
+
+#include "Client.h"
+
+#define MQTT_CALLBACK_SIGNATURE                                               \
+  std::function<void(char *, uint8_t *, unsigned int)> callback
+
+/**
+ * @class PubSubClient
+ * @brief MQTT 3.1.1 client.
+ */
+class PubSubClient {
+public:
+  PubSubClient() = default;
+  explicit PubSubClient(Client &client) : _client(&client) {}
+
+  PubSubClient &setServer(const char *domain, uint16_t port);
+  PubSubClient &setCallback(MQTT_CALLBACK_SIGNATURE);
+  PubSubClient &setClient(Client &client);
+  PubSubClient &setKeepAlive(uint16_t keepAlive);
+  PubSubClient &setSocketTimeout(uint16_t timeout);
+  bool setBufferSize(uint16_t size);
+
+  bool connect(const char *id);
+  void disconnect();
+  bool publish(const char *topic, const char *payload);
+  bool publish(const char *topic, const char *payload, bool retained);
+  bool subscribe(const char *topic);
+  bool unsubscribe(const char *topic);
+  bool loop();
+  bool connected();
+  int state() const { return _state; }
+
+  /// @brief Delivers a message to the registered callback (host only).
+  void hostDeliver(const char *topic, const uint8_t *payload, unsigned len);
+
+private:
+  Client *_client = nullptr;
+  const char *_domain = nullptr;
+  uint16_t _port = 0;
+  uint16_t _keepAlive = 15;
+  uint16_t _socketTimeout = 15;
+  std::function<void(char *, uint8_t *, unsigned int)> _callback;
+  int _state = -1;
+  bool _connected = false;
+};
+
+namespace host {
+/// @brief Number of MQTT PUBLISH packets sent since the last reset.
+uint32_t mqttPublishCount();
+/// @brief Number of MQTT CONNECT handshakes since the last reset.
+uint32_t mqttConnectCount();
+/// @brief Topic and payload of the last PUBLISH.
+const String &mqttLastTopic();
+const String &mqttLastPayload();
+void mqttResetStats();
+} // namespace host
@@ -0,0 +1,78 @@
+/**
+ * @file RTClib.h
+ * @brief Host stand-in for Adafruit RTClib (DateTime and RTC_DS3231).
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "Wire.h"
+
+/**
+ * @class DateTime
+ * @brief Calendar date and time with second resolution.
+ */
+class DateTime {
+public:
+  DateTime(uint32_t t = 946684800UL);
+  DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0,
+           uint8_t min = 0, uint8_t sec = 0);
+
+  uint16_t year() const { return _y; }
+  uint8_t month() const { return _m; }
+  uint8_t day() const { return _d; }
+  uint8_t hour() const { return _hh; }
+  uint8_t minute() const { return _mm; }
+  uint8_t second() const { return _ss; }
+  uint8_t dayOfTheWeek() const;
+  uint32_t unixtime() const { return _unix; }
+
+private:
+  uint32_t _unix;
+  uint16_t _y;
+  uint8_t _m, _d, _hh, _mm, _ss;
+};
+
+/// @brief Output of the INT/SQW pin.
+enum Ds3231SqwPinMode {
+  DS3231_OFF = 0x1C,           ///< Alarm interrupt output.
+  DS3231_SquareWave1Hz = 0x00, ///< 1 Hz square wave.
+};
+
+/// @brief Alarm 2 match modes.
+enum Ds3231Alarm2Mode {
+  DS3231_A2_PerMinute = 0x7, ///< Every minute, at second 00.
+  DS3231_A2_Minute = 0x6,    ///< Minutes match.
+  DS3231_A2_Hour = 0x4,      ///< Hours and minutes match.
+};
+
+/**
+ * @class RTC_DS3231
+ * @brief DS3231 real-time clock on the I2C bus.
+ */
+class RTC_DS3231 {
+public:
+  bool begin(TwoWire *wireInstance = &Wire);
+  DateTime now();
+  void adjust(const DateTime &dt);
+  bool lostPower() { return false; }
+
+  void writeSqwPinMode(Ds3231SqwPinMode mode);
+  void disable32K();
+  bool setAlarm2(const DateTime &dt, Ds3231Alarm2Mode alarmMode);
+  void disableAlarm(uint8_t alarmNum);
+  void clearAlarm(uint8_t alarmNum);
+  bool alarmFired(uint8_t alarmNum);
+
+private:
+  TwoWire *_wire = &Wire;
+};
+
+namespace host {
+/// @brief Sets the simulated RTC time (in Unix seconds) at the current
+/// virtual instant.
+void setRtcUnixTime(uint32_t t);
+
+/// @brief Wires the DS3231 INT/SQW output to an ESP32 input pin.
+void setRtcIntPin(uint8_t pin);
+} // namespace host
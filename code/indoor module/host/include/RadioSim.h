@@ -0,0 +1,93 @@
+/**
+ * @file RadioSim.h
+ * @brief Simulated 2.4 GHz medium shared by several ESP-NOW/WiFi nodes.
+ *
+ * Needs the purely virtual clock (host::setRealTimeClock(false)).
+ */
+
+#pragma once
+#include <cstdint>
+
+namespace host {
+
+using NodeId = uint8_t;
+
+/// @brief Radio/PHY timing and power parameters.
+struct RadioParams {
+  uint32_t preambleUs = 192;      ///< PLCP preamble + header (long, 1 Mbps).
+  uint32_t usPerByte = 8;         ///< 1 Mbps.
+  uint32_t macOverheadBytes = 43; ///< 802.11 header, vendor IE, FCS.
+  uint32_t ackBytes = 14;         ///< ACK frame length.
+  uint32_t sifsUs = 10;           ///< Short inter-frame space.
+  uint32_t ackTimeoutUs = 400;    ///< Wait for a missing ACK.
+  uint32_t hopDwellMs = 105;      ///< Per-channel dwell of an active scan.
+  float txPowerMw = 1105.0f;      ///< TX power draw (3.3 V x 335 mA).
+  float rxPowerMw = 287.0f;       ///< Radio-on (listen/RX) draw (3.3 V x 87 mA).
+};
+
+/// @brief Parameters of one directed link.
+struct LinkParams {
+  float loss = 0.0f;         ///< Independent loss probability per frame.
+  uint32_t ackLatencyUs = 0; ///< Extra receiver turnaround before the ACK.
+  uint8_t macRetries = 3;    ///< Hardware retransmissions after the first.
+  int8_t rssi = -60;         ///< Signal strength at the receiver, dBm.
+};
+
+/// @brief Per-node counters.
+struct RadioStats {
+  uint64_t radioOnUs = 0;     ///< Time with the radio powered (STA/AP).
+  uint64_t txAirtimeUs = 0;   ///< Time spent transmitting (frames + ACKs).
+  uint32_t sends = 0;         ///< esp_now_send() calls accepted.
+  uint32_t transmissions = 0; ///< Frames put on air including retries.
+  uint32_t sendSuccess = 0;   ///< Send callbacks reporting success.
+  uint32_t delivered = 0;     ///< Frames handed to this node's recv cb.
+  uint32_t hopsStarted = 0;   ///< Channel scans started (WiFi.begin).
+};
+
+/// @brief Replaces the global radio/PHY parameters.
+void setRadioParams(const RadioParams &params);
+const RadioParams &radioParams();
+
+/// @brief Adds a node with the given MAC; returns its id.
+NodeId addRadioNode(const uint8_t mac[6]);
+void setNodeMac(NodeId id, const uint8_t mac[6]);
+NodeId currentNode();
+void setCurrentNode(NodeId id);
+
+/// @brief Sets the parameters of the link @p from -> @p to.
+void setLink(NodeId from, NodeId to, const LinkParams &params);
+
+/// @brief Channel the node listens on at this instant (0 = radio off).
+uint8_t nodeChannel(NodeId id);
+
+/// @brief Makes a node sweep channels 1..13 for @p durationMs, then return
+/// to @p landOn (0 = its previous channel).
+void startChannelHop(NodeId id, uint32_t durationMs, uint8_t landOn = 0);
+
+/// @brief Counters of one node (radio-on time is accumulated up to now).
+RadioStats radioStats(NodeId id);
+void resetRadioStats();
+
+/// @brief Powers a node's radio down (e.g. when it enters deep sleep).
+void radioOff(NodeId id);
+
+/// @brief Reseeds the loss process.
+void seedRadio(uint32_t seed);
+
+/// @brief Removes all nodes except node 0 and resets its state.
+void resetRadio();
+
+/**
+ * @class NodeScope
+ * @brief Runs the enclosing block as another node.
+ */
+class NodeScope {
+public:
+  explicit NodeScope(NodeId id) : _prev(currentNode()) { setCurrentNode(id); }
+  ~NodeScope() { setCurrentNode(_prev); }
+
+private:
+  NodeId _prev;
+};
+
+} // namespace host
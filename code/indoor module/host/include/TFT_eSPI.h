@@ -0,0 +1,262 @@
+/**
+ * @file TFT_eSPI.h
+ * @brief Host stand-in for the TFT_eSPI display driver.
+ *
+ * Renders into RGB565 framebuffers and counts panel traffic; see
+ * TFT_eSPI::hostStats().
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+#include <vector>
+
+// --- Colours (RGB565) ---
+#define TFT_BLACK 0x0000
+#define TFT_NAVY 0x000F
+#define TFT_DARKGREEN 0x03E0
+#define TFT_MAROON 0x7800
+#define TFT_LIGHTGREY 0xD69A
+#define TFT_DARKGREY 0x7BEF
+#define TFT_BLUE 0x001F
+#define TFT_GREEN 0x07E0
+#define TFT_RED 0xF800
+#define TFT_YELLOW 0xFFE0
+#define TFT_WHITE 0xFFFF
+#define TFT_BROWN 0x9A60
+
+// --- Text datums ---
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define MC_DATUM 4
+#define MR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+
+#define TFT_WIDTH 320
+#define TFT_HEIGHT 480
+
+/**
+ * @class TFT_eSPI
+ * @brief In-memory display with the TFT_eSPI drawing API.
+ */
+class TFT_eSPI {
+public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI();
+
+  void init(uint8_t tc = 0);
+  void begin(uint8_t tc = 0) { init(tc); }
+  void setRotation(uint8_t r);
+  int16_t width() const { return _vpDatum ? _vpX1 - _vpX0 : _width; }
+  int16_t height() const { return _vpDatum ? _vpY1 - _vpY0 : _height; }
+
+  // --- Viewport ---
+  /**
+   * @brief Clips all drawing (not pushPixels()/pushBlock()) to a rectangle.
+   * With @p vpDatum coordinates become relative to its top-left corner.
+   */
+  void setViewport(int32_t x, int32_t y, int32_t w, int32_t h,
+                   bool vpDatum = true);
+  void resetViewport();
+  /// @brief True if the rectangle overlaps the viewport.
+  bool checkViewport(int32_t x, int32_t y, int32_t w, int32_t h);
+
+  virtual void drawPixel(int32_t x, int32_t y, uint32_t color);
+  virtual void fillRect(int32_t x, int32_t y, int32_t w, int32_t h,
+                        uint32_t color);
+  void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+
+  void setSwapBytes(bool swap) { _swapBytes = swap; }
+  bool getSwapBytes() const { return _swapBytes; }
+
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                 const uint16_t *data);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data,
+                 uint16_t transparent);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                 const uint16_t *data, uint16_t transparent);
+
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+    fillRect(x, y, w, 1, color);
+  }
+
+  // --- Streaming into an address window ---
+  void startWrite() {}
+  void endWrite() {}
+  /// @brief Sets the window filled row by row by pushPixels()/pushBlock().
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+  /// @brief Streams @p len pixels (byte order as for pushImage()).
+  void pushPixels(const void *data, uint32_t len);
+  /// @brief Streams @p len pixels of one colour.
+  void pushBlock(uint16_t color, uint32_t len);
+
+  // --- DMA ---
+  bool initDMA(bool ctrl_cs = false);
+  void deInitDMA() { _dmaReady = false; }
+  /**
+   * @brief Streams @p len pixels into the address window without waiting.
+   * @p image must stay untouched until dmaBusy() is false; on the host its
+   * pixels only reach the framebuffer when the transfer completes.
+   */
+  void pushPixelsDMA(uint16_t *image, uint32_t len);
+  /// @brief pushImage() by DMA; @p buffer, if given, receives a copy first.
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data,
+                    uint16_t *buffer = nullptr);
+  bool dmaBusy();
+  void dmaWait();
+
+  // --- Text ---
+  void setTextColor(uint16_t fg, uint16_t bg, bool bgfill = false);
+  void setTextColor(uint16_t fg) { setTextColor(fg, fg); }
+  void setTextDatum(uint8_t datum) { _textDatum = datum; }
+  uint8_t getTextDatum() const { return _textDatum; }
+
+  void loadFont(String fontName, fs::FS &ffs);
+  void loadFont(String fontName, bool flash = true);
+  void unloadFont();
+  bool fontLoaded() const { return _fontLoaded; }
+
+  int16_t drawString(const String &s, int32_t x, int32_t y, uint8_t font = 1);
+  int16_t drawString(const char *s, int32_t x, int32_t y, uint8_t font = 1);
+  int16_t textWidth(const String &s) { return textWidth(s.c_str()); }
+  int16_t textWidth(const char *s);
+  int16_t fontHeight() const;
+
+  /// @brief Metrics of the loaded smooth font (subset of the library's).
+  struct fontMetrics {
+    uint16_t yAdvance;   ///< Line height.
+    uint16_t maxAscent;  ///< Tallest glyph above the baseline.
+    uint16_t maxDescent; ///< Deepest glyph below the baseline.
+  } gFont = {0, 0, 0};
+
+  // --- Touch ---
+  uint8_t getTouch(uint16_t *x, uint16_t *y, uint16_t threshold = 600);
+
+  // --- Host hooks ---
+  /// @brief Read-only access to the framebuffer (see stored()).
+  const uint16_t *framebuffer() const { return _fb.data(); }
+  uint16_t readPixel(int32_t x, int32_t y) const;
+
+  /// @brief Sets the state reported by getTouch() (all instances).
+  static void hostSetTouch(bool pressed, uint16_t x = 0, uint16_t y = 0);
+
+  /// @brief Cumulative panel traffic since the last hostResetStats().
+  struct HostStats {
+    uint64_t pixels = 0;         ///< Pixels written to the panel.
+    uint32_t pushImageCalls = 0; ///< pushImage() calls on the panel.
+    uint32_t streamCalls = 0;    ///< pushPixels()/pushBlock() calls.
+    uint32_t fillCalls = 0;      ///< fillRect()/fillScreen() calls.
+    uint32_t fontLoads = 0;      ///< loadFont() calls (any instance).
+    uint64_t driverNs = 0;       ///< Wall time inside panel driver calls.
+    uint32_t dmaCalls = 0;       ///< pushPixelsDMA()/pushImageDMA() calls.
+    uint64_t busNs = 0;          ///< Modelled SPI time of all transfers.
+    uint64_t busStallNs = 0;     ///< Time callers waited for the bus.
+    uint32_t touchReads = 0;     ///< getTouch() calls (XPT2046 transfers).
+  };
+  static const HostStats &hostStats();
+  static void hostResetStats();
+
+  /**
+   * @brief Models the SPI bus: @p spiHz clock (0 disables the model) and
+   * @p transferNs fixed cost per transfer (window setup, CS, driver).
+   */
+  static void hostSetBusModel(uint32_t spiHz, uint32_t transferNs = 0);
+
+  /// @brief Makes createSprite() fail above @p bytes (0 = no limit), as
+  /// it does when the heap has no block that large.
+  static void hostSetSpriteLimit(size_t bytes);
+
+protected:
+  /// @brief One glyph of a loaded .vlw smooth font.
+  struct Glyph {
+    uint32_t code;     ///< Unicode code point.
+    uint16_t height;   ///< Bitmap height.
+    uint16_t width;    ///< Bitmap width.
+    int16_t xAdvance;  ///< Cursor advance.
+    int16_t dY;        ///< Top of bitmap relative to baseline.
+    int8_t dX;         ///< Left offset.
+    uint32_t bitmap;   ///< Offset of the alpha bitmap in _fontData.
+  };
+
+  void resize(int16_t w, int16_t h);
+  void blit(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data,
+            bool swap, bool useTransparent, uint16_t transparent);
+  void streamPixel(uint16_t color);
+  /// @brief How a pixel is kept in _fb: as is on the panel, byte-swapped in
+  /// sprites.
+  uint16_t stored(uint16_t c) const {
+    return _panel ? c : (uint16_t)((c << 8) | (c >> 8));
+  }
+  /// @brief Lands the pending DMA transfer in the framebuffer.
+  void completeDMA();
+  const Glyph *findGlyph(uint32_t code) const;
+  void drawGlyph(const Glyph &g, int32_t x, int32_t y);
+  static uint16_t alphaBlend(uint8_t alpha, uint16_t fg, uint16_t bg);
+  static uint32_t decodeUTF8(const uint8_t *s, size_t &i, size_t len);
+
+  std::vector<uint16_t> _fb; ///< Framebuffer (or sprite buffer).
+  int16_t _width;            ///< Current width (after rotation).
+  int16_t _height;           ///< Current height (after rotation).
+  bool _swapBytes = false;   ///< Byte order of pushImage() data.
+  bool _panel = true;        ///< False for sprites (RAM targets).
+
+  int32_t _vpX0 = 0;     ///< Viewport clip rectangle (absolute).
+  int32_t _vpY0 = 0;     ///< Viewport clip rectangle (absolute).
+  int32_t _vpX1 = 0;     ///< Viewport clip rectangle, exclusive.
+  int32_t _vpY1 = 0;     ///< Viewport clip rectangle, exclusive.
+  int32_t _xDatum = 0;   ///< Origin offset when the viewport is the datum.
+  int32_t _yDatum = 0;   ///< Origin offset when the viewport is the datum.
+  bool _vpDatum = false; ///< Coordinates relative to the viewport.
+
+  int32_t _winX = 0;    ///< Address window origin.
+  int32_t _winY = 0;    ///< Address window origin.
+  int32_t _winW = 0;    ///< Address window width.
+  int32_t _winH = 0;    ///< Address window height.
+  uint32_t _winPos = 0; ///< Next pixel of the window, row-major.
+
+  bool _dmaReady = false;             ///< initDMA() called.
+  const uint16_t *_dmaData = nullptr; ///< Pixels of the pending transfer.
+  uint32_t _dmaLen = 0;               ///< Length of the pending transfer.
+  bool _dmaSwap = false;              ///< Byte order it was started with.
+
+  uint16_t _textColor = TFT_WHITE;   ///< Text foreground.
+  uint16_t _textBgColor = TFT_BLACK; ///< Text background for blending.
+  uint8_t _textDatum = TL_DATUM;     ///< Reference point of drawString().
+
+  bool _fontLoaded = false;       ///< Smooth font present.
+  std::vector<uint8_t> _fontData; ///< Raw .vlw file contents.
+  std::vector<Glyph> _glyphs;     ///< Parsed glyph metrics.
+  uint16_t _yAdvance = 0;         ///< Line height.
+  uint16_t _ascent = 0;           ///< Font ascent.
+  uint16_t _descent = 0;          ///< Font descent.
+  uint16_t _spaceWidth = 0;       ///< Advance of a missing glyph / space.
+};
+
+/**
+ * @class TFT_eSprite
+ * @brief Off-screen buffer that can be pushed onto its parent display.
+ */
+class TFT_eSprite : public TFT_eSPI {
+public:
+  explicit TFT_eSprite(TFT_eSPI *tft);
+
+  void *createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void deleteSprite();
+  bool created() const { return _created; }
+  void *setColorDepth(int8_t b);
+  void fillSprite(uint32_t color) { fillScreen(color); }
+  /// @brief The pixel buffer, RGB565 in panel (big-endian) byte order.
+  void *getPointer() { return _created ? _fb.data() : nullptr; }
+
+  void pushSprite(int32_t x, int32_t y);
+  void pushSprite(int32_t x, int32_t y, uint16_t transparent);
+
+private:
+  TFT_eSPI *_parent; ///< Display the sprite is pushed to.
+  bool _created = false;
+};
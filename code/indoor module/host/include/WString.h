@@ -0,0 +1,107 @@
+/**
+ * @file WString.h
+ * @brief Host stand-in for the Arduino String class.
+ *
+ * Backed by std::string. Only the subset used by the firmware (and by
+ * ArduinoJson's String adapter) is provided.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/**
+ * @class String
+ * @brief Heap-backed, Arduino-compatible string.
+ */
+class String {
+public:
+  String() = default;
+  String(const char *s) : _s(s ? s : "") {}
+  String(const std::string &s) : _s(s) {}
+  explicit String(char c) : _s(1, c) {}
+  explicit String(unsigned char v, unsigned char base = 10);
+  explicit String(int v, unsigned char base = 10);
+  explicit String(unsigned int v, unsigned char base = 10);
+  explicit String(long v, unsigned char base = 10);
+  explicit String(unsigned long v, unsigned char base = 10);
+  explicit String(long long v, unsigned char base = 10);
+  explicit String(unsigned long long v, unsigned char base = 10);
+  explicit String(float v, unsigned int decimals = 2);
+  explicit String(double v, unsigned int decimals = 2);
+
+  const char *c_str() const { return _s.c_str(); }
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  bool isEmpty() const { return _s.empty(); }
+  bool reserve(unsigned int size) {
+    _s.reserve(size);
+    return true;
+  }
+
+  bool concat(const String &s) {
+    _s += s._s;
+    return true;
+  }
+  bool concat(const char *s) {
+    if (s)
+      _s += s;
+    return s != nullptr;
+  }
+  bool concat(const char *s, unsigned int len) {
+    _s.append(s, len);
+    return true;
+  }
+  bool concat(char c) {
+    _s.push_back(c);
+    return true;
+  }
+
+  String &operator+=(const String &s) {
+    _s += s._s;
+    return *this;
+  }
+  String &operator+=(const char *s) {
+    concat(s);
+    return *this;
+  }
+  String &operator+=(char c) {
+    _s.push_back(c);
+    return *this;
+  }
+
+  bool operator==(const String &o) const { return _s == o._s; }
+  bool operator!=(const String &o) const { return _s != o._s; }
+  bool operator==(const char *o) const { return _s == (o ? o : ""); }
+  bool operator!=(const char *o) const { return !(*this == o); }
+  bool operator<(const String &o) const { return _s < o._s; }
+
+  char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  char charAt(unsigned int i) const { return (*this)[i]; }
+
+  String substring(unsigned int from) const {
+    return from >= _s.size() ? String() : String(_s.substr(from));
+  }
+  String substring(unsigned int from, unsigned int to) const;
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const char *s, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  bool startsWith(const String &prefix) const {
+    return _s.compare(0, prefix._s.size(), prefix._s) == 0;
+  }
+  bool endsWith(const String &suffix) const;
+  long toInt() const { return std::strtol(_s.c_str(), nullptr, 10); }
+  float toFloat() const { return std::strtof(_s.c_str(), nullptr); }
+
+  const std::string &str() const { return _s; }
+
+private:
+  std::string _s;
+};
+
+String operator+(const String &a, const String &b);
+String operator+(const String &a, const char *b);
+String operator+(const char *a, const String &b);
+String operator+(const String &a, char b);
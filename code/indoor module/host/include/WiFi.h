@@ -0,0 +1,69 @@
+/**
+ * @file WiFi.h
+ * @brief Host stand-in for the Arduino-ESP32 WiFi class.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "esp_wifi.h"
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3,
+} wifi_mode_t;
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_DISCONNECTED = 6,
+} wl_status_t;
+
+typedef enum {
+  WIFI_AUTH_OPEN = 0,
+  WIFI_AUTH_WPA2_PSK = 3,
+} wifi_auth_mode_t;
+
+/**
+ * @class WiFiClass
+ * @brief Station / soft-AP control.
+ */
+class WiFiClass {
+public:
+  bool mode(wifi_mode_t m);
+  wifi_mode_t getMode() const;
+  wl_status_t begin(const char *ssid, const char *pass = nullptr);
+  bool disconnect(bool wifiOff = false, bool eraseAp = false);
+  wl_status_t status();
+  bool setSleep(bool enable);
+  uint8_t channel() const;
+
+  bool softAP(const char *ssid, const char *pass = nullptr);
+  IPAddress softAPIP() const { return IPAddress(192, 168, 4, 1); }
+  IPAddress localIP() const { return IPAddress(192, 168, 1, 50); }
+
+  int16_t scanNetworks();
+  String SSID(uint8_t i) const;
+  int32_t RSSI(uint8_t i) const;
+  wifi_auth_mode_t encryptionType(uint8_t i) const;
+};
+
+extern WiFiClass WiFi;
+
+namespace host {
+/**
+ * @brief Configures the simulated access point.
+ * @param ssid SSID that WiFi.begin() will associate with (empty = none).
+ * @param channel AP channel; the radio moves there on association.
+ * @param joinMs Virtual time association takes.
+ */
+void setAccessPoint(const char *ssid, uint8_t channel = 6,
+                    uint32_t joinMs = 800);
+
+/// @brief Number of WiFi.begin() calls since start-up.
+uint32_t wifiJoinCount();
+} // namespace host
@@ -0,0 +1,47 @@
+/**
+ * @file WiFiClientSecure.h
+ * @brief Host stand-in for the mbedTLS-backed WiFiClientSecure.
+ *
+ * No TLS is performed; connect() charges a fixed virtual handshake time.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "Client.h"
+
+/**
+ * @class WiFiClientSecure
+ * @brief TLS client socket.
+ */
+class WiFiClientSecure : public Client {
+public:
+  void setCACert(const char *rootCA) { _ca = rootCA; }
+  void setCertificate(const char *clientCa) { _cert = clientCa; }
+  void setPrivateKey(const char *privateKey) { _key = privateKey; }
+
+  int connect(const char *host, uint16_t port) override;
+  size_t write(const uint8_t *buf, size_t size) override;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  void stop() override { _connected = false; }
+  uint8_t connected() override;
+
+private:
+  const char *_ca = nullptr;   ///< Root CA (PEM).
+  const char *_cert = nullptr; ///< Client certificate (PEM).
+  const char *_key = nullptr;  ///< Client private key (PEM).
+  bool _connected = false;
+  uint32_t _generation = 0; ///< host::tlsDropConnections() at connect.
+};
+
+namespace host {
+/// @brief Virtual time charged for a full TLS handshake.
+void setTlsHandshakeMs(uint32_t ms);
+
+/// @brief The broker closes every open connection.
+void tlsDropConnections();
+
+/// @brief Number of TLS handshakes performed since start-up.
+uint32_t tlsHandshakeCount();
+} // namespace host
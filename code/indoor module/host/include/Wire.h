@@ -0,0 +1,37 @@
+/**
+ * @file Wire.h
+ * @brief Host stand-in for the Arduino I2C (TwoWire) bus.
+ *
+ * Devices on the bus are simulated by their own stand-ins; the bus only
+ * counts transactions so I2C traffic can be measured.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @class TwoWire
+ * @brief I2C master.
+ */
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+
+  /// @brief Records one bus transaction of @p bytes payload bytes.
+  void hostTransaction(size_t bytes) {
+    _transactions++;
+    _bytes += bytes;
+  }
+  uint32_t hostTransactions() const { return _transactions; }
+  uint64_t hostBytes() const { return _bytes; }
+  void hostResetStats() {
+    _transactions = 0;
+    _bytes = 0;
+  }
+
+private:
+  uint32_t _transactions = 0;
+  uint64_t _bytes = 0;
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,12 @@
+/**
+ * @file esp_attr.h
+ * @brief Host stand-in for the ESP-IDF placement attributes.
+ *
+ * Host processes do not reset on deep sleep, so RTC memory is plain memory.
+ */
+
+#pragma once
+
+#define RTC_DATA_ATTR
+#define IRAM_ATTR
+#define DMA_ATTR
@@ -0,0 +1,54 @@
+/**
+ * @file esp_now.h
+ * @brief Host stand-in for the ESP-NOW API.
+ *
+ * Sends go through RadioSim.h; host::espNowInject() bypasses it.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+#define ESP_NOW_ETH_ALEN 6
+#define ESP_NOW_MAX_DATA_LEN 250
+
+typedef enum {
+  ESP_NOW_SEND_SUCCESS = 0,
+  ESP_NOW_SEND_FAIL,
+} esp_now_send_status_t;
+
+typedef struct esp_now_peer_info {
+  uint8_t peer_addr[ESP_NOW_ETH_ALEN]; ///< Peer MAC address.
+  uint8_t lmk[16];                     ///< Local master key.
+  uint8_t channel;                     ///< 0 = current channel.
+  int ifidx;                           ///< WiFi interface.
+  bool encrypt;                        ///< Encrypt traffic to this peer.
+  void *priv;                          ///< User data.
+} esp_now_peer_info_t;
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t *mac, const uint8_t *data,
+                                  int len);
+typedef void (*esp_now_send_cb_t)(const uint8_t *mac,
+                                  esp_now_send_status_t status);
+
+esp_err_t esp_now_init();
+esp_err_t esp_now_deinit();
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb);
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t cb);
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *peer);
+esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data,
+                       size_t len);
+
+namespace host {
+/**
+ * @brief Delivers one ESP-NOW frame to the registered receive callback.
+ * @return false if ESP-NOW is not initialised or no callback is registered.
+ */
+bool espNowInject(const uint8_t *mac, const uint8_t *data, int len,
+                  int8_t rssi = -60);
+
+/// @brief Number of esp_now_init() calls since start-up.
+uint32_t espNowInitCount();
+} // namespace host
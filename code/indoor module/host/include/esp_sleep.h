@@ -0,0 +1,22 @@
+/**
+ * @file esp_sleep.h
+ * @brief Host stand-in for the ESP-IDF sleep API.
+ *
+ * esp_deep_sleep_start() throws host::DeepSleep, as a reset would.
+ */
+
+#pragma once
+#include <cstdint>
+
+#include "esp_err.h"
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us);
+[[noreturn]] void esp_deep_sleep_start();
+
+namespace host {
+/// @brief Thrown by esp_deep_sleep_start().
+struct DeepSleep {
+  uint8_t node;     ///< Radio node that went to sleep.
+  uint64_t sleepUs; ///< Armed timer wake-up (0 = none).
+};
+} // namespace host
@@ -0,0 +1,17 @@
+/**
+ * @file esp_sntp.h
+ * @brief Host stand-in for the ESP-IDF SNTP client.
+ */
+
+#pragma once
+#include <cstdint>
+#include <sys/time.h>
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+
+namespace host {
+/// @brief Sets the time NTP servers report (Unix seconds) at this instant.
+void setNtpUnixTime(uint32_t t);
+} // namespace host
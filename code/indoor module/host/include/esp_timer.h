@@ -0,0 +1,10 @@
+/**
+ * @file esp_timer.h
+ * @brief Host stand-in for the ESP-IDF high-resolution timer.
+ */
+
+#pragma once
+#include <cstdint>
+
+/// @brief Microseconds since boot (the virtual clock).
+int64_t esp_timer_get_time();
@@ -0,0 +1,8 @@
+/**
+ * @file rtc_cntl_reg.h
+ * @brief Host stand-in for the RTC controller register map.
+ */
+
+#pragma once
+
+#define RTC_CNTL_BROWN_OUT_REG 0x600080d8u
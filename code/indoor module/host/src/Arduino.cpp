@@ -0,0 +1,300 @@
+/**
+ * @file Arduino.cpp
+ * @brief Host implementation of the Arduino core stand-in.
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <deque>
+#include <map>
+#include <random>
+#include <utility>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+const SteadyClock::time_point kStart = SteadyClock::now();
+uint64_t g_virtualUs = 0; ///< Time added by delay()/advanceMicros().
+uint64_t g_blockedUs = 0; ///< Time spent inside delay().
+bool g_realTime = true;   ///< Add elapsed wall time to the clock.
+double g_cpuScale = 1.0;  ///< Wall time multiplier (see setCpuScale()).
+uint64_t g_scaleBase = 0; ///< Wall time when the multiplier last changed.
+uint64_t g_scaledUs = 0;  ///< Scaled wall time up to g_scaleBase.
+double g_excludedUs = 0;  ///< Scaled wall time taken out by excludeWallTime().
+uint32_t g_yieldUs = 10;  ///< Virtual time a yield() costs (virtual mode).
+uint64_t g_eventSeq = 0;  ///< Tie-breaker keeping same-time events FIFO.
+std::map<std::pair<uint64_t, uint64_t>, std::function<void()>> g_events;
+bool g_serialEcho = std::getenv("METEO_HOST_SERIAL") != nullptr;
+std::deque<char> g_serialIn;
+std::map<uint8_t, uint16_t> g_analogIn;
+std::map<uint8_t, int> g_analogOut;
+std::map<uint8_t, uint8_t> g_digital;
+std::map<uint8_t, std::pair<void (*)(), int>> g_isrs; ///< Handler, mode.
+sntp_sync_time_cb_t g_sntpCb = nullptr;
+bool g_ntpSet = false;    ///< host::setNtpUnixTime() was called.
+uint32_t g_ntpBase = 0;   ///< NTP time at g_ntpSetUs.
+uint64_t g_ntpSetUs = 0;
+std::mt19937 g_rng(0x5eed);
+
+uint64_t realMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             SteadyClock::now() - kStart)
+      .count();
+}
+
+/// @brief Wall time as seen by the firmware, i.e. after setCpuScale().
+uint64_t cpuMicros() {
+  return g_scaledUs +
+         (uint64_t)((realMicros() - g_scaleBase) * g_cpuScale - g_excludedUs);
+}
+
+uint64_t nowMicros() { return (g_realTime ? cpuMicros() : 0) + g_virtualUs; }
+
+/// @brief Runs every event due at or before the current time.
+void runDueEvents() {
+  while (!g_events.empty() && g_events.begin()->first.first <= nowMicros()) {
+    auto fn = std::move(g_events.begin()->second);
+    g_events.erase(g_events.begin());
+    fn();
+  }
+}
+
+/// @brief Moves the clock forward, running events at their scheduled time.
+void advance(uint64_t us) {
+  uint64_t target = nowMicros() + us;
+  while (!g_events.empty() && g_events.begin()->first.first <= target) {
+    uint64_t at = g_events.begin()->first.first;
+    uint64_t now = nowMicros();
+    if (at > now)
+      g_virtualUs += at - now;
+    runDueEvents();
+  }
+  uint64_t now = nowMicros();
+  if (target > now)
+    g_virtualUs += target - now;
+}
+
+size_t emit(const char *s, size_t n) {
+  if (g_serialEcho)
+    std::fwrite(s, 1, n, stdout);
+  return n;
+}
+} // namespace
+
+unsigned long millis() { return (unsigned long)(nowMicros() / 1000ULL); }
+unsigned long micros() { return (unsigned long)nowMicros(); }
+
+void delay(uint32_t ms) {
+  g_blockedUs += (uint64_t)ms * 1000ULL;
+  advance((uint64_t)ms * 1000ULL);
+}
+
+void delayMicroseconds(uint32_t us) {
+  g_blockedUs += us;
+  advance(us);
+}
+
+void yield() {
+  if (g_realTime)
+    runDueEvents();
+  else
+    advance(g_yieldUs);
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) { g_digital[pin] = val; }
+
+int digitalRead(uint8_t pin) {
+  auto it = g_digital.find(pin);
+  return it == g_digital.end() ? HIGH : it->second;
+}
+
+uint16_t analogRead(uint8_t pin) {
+  auto it = g_analogIn.find(pin);
+  return it == g_analogIn.end() ? 2048 : it->second;
+}
+
+uint32_t analogReadMilliVolts(uint8_t pin) {
+  return (uint32_t)analogRead(pin) * 3300U / 4095U;
+}
+
+void analogWrite(uint8_t pin, int value) { g_analogOut[pin] = value; }
+
+int8_t digitalPinToAnalogChannel(uint8_t pin) {
+  static const uint8_t adc1[] = {36, 37, 38, 39, 32, 33, 34, 35};
+  for (int8_t ch = 0; ch < 8; ch++)
+    if (adc1[ch] == pin)
+      return ch;
+  return -1;
+}
+
+uint32_t esp_random() { return g_rng(); }
+
+void configTime(long gmtOffset_sec, int daylightOffset_sec,
+                const char *server1, const char *server2,
+                const char *server3) {
+  (void)gmtOffset_sec;
+  (void)daylightOffset_sec;
+  (void)server1;
+  (void)server2;
+  (void)server3;
+  if (!g_ntpSet || !g_sntpCb)
+    return;
+  uint64_t us = g_ntpBase * 1000000ULL + (nowMicros() - g_ntpSetUs);
+  timeval tv = {(time_t)(us / 1000000), (suseconds_t)(us % 1000000)};
+  g_sntpCb(&tv);
+}
+
+void configTzTime(const char *tz, const char *server1, const char *server2,
+                  const char *server3) {
+  setenv("TZ", tz, 1);
+  tzset();
+  configTime(0, 0, server1, server2, server3);
+}
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+  g_sntpCb = callback;
+}
+
+int64_t esp_timer_get_time() { return (int64_t)nowMicros(); }
+
+size_t HardwareSerial::print(const char *s) {
+  return s ? emit(s, std::strlen(s)) : 0;
+}
+
+size_t HardwareSerial::print(char c) { return emit(&c, 1); }
+
+size_t HardwareSerial::print(int v) { return printf("%d", v); }
+
+size_t HardwareSerial::print(unsigned int v) { return printf("%u", v); }
+
+size_t HardwareSerial::print(long v) { return printf("%ld", v); }
+
+size_t HardwareSerial::print(unsigned long v) { return printf("%lu", v); }
+
+size_t HardwareSerial::print(double v, int decimals) {
+  return printf("%.*f", decimals, v);
+}
+
+int HardwareSerial::available() { return (int)g_serialIn.size(); }
+
+int HardwareSerial::read() {
+  if (g_serialIn.empty())
+    return -1;
+  char c = g_serialIn.front();
+  g_serialIn.pop_front();
+  return (unsigned char)c;
+}
+
+size_t HardwareSerial::printf(const char *fmt, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, fmt);
+  int n = std::vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  if (n <= 0)
+    return 0;
+  return emit(buf, std::min((size_t)n, sizeof(buf) - 1));
+}
+
+void EspClass::restart() {
+  std::fflush(stdout);
+  std::fprintf(stderr, "[HOST] ESP.restart() requested, exiting\n");
+  std::exit(0);
+}
+
+uint32_t EspClass::getFreeHeap() { return 200 * 1024; }
+
+uint32_t EspClass::getMaxAllocHeap() { return 110 * 1024; }
+
+uint32_t EspClass::getCycleCount() {
+  return (uint32_t)(nowMicros() * getCpuFreqMHz());
+}
+
+void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+  g_isrs[pin] = {isr, mode};
+}
+
+void detachInterrupt(uint8_t pin) { g_isrs.erase(pin); }
+
+namespace host {
+void setSerialEcho(bool on) { g_serialEcho = on; }
+
+void serialInput(const char *s) {
+  while (s && *s)
+    g_serialIn.push_back(*s++);
+}
+
+void advanceMicros(uint64_t us) { advance(us); }
+
+uint64_t nowMicros() { return ::nowMicros(); }
+
+void setRealTimeClock(bool on) {
+  if (on == g_realTime)
+    return;
+  uint64_t real = cpuMicros();
+  if (on)
+    g_virtualUs = g_virtualUs > real ? g_virtualUs - real : 0;
+  else
+    g_virtualUs += real;
+  g_realTime = on;
+}
+
+void setCpuScale(double factor) {
+  uint64_t real = realMicros();
+  g_scaledUs += (uint64_t)((real - g_scaleBase) * g_cpuScale);
+  g_scaleBase = real;
+  g_cpuScale = factor;
+}
+
+void excludeWallTime(uint64_t ns) { g_excludedUs += ns / 1000.0 * g_cpuScale; }
+
+void setYieldMicros(uint32_t us) { g_yieldUs = us; }
+
+void scheduleAt(uint64_t atUs, std::function<void()> fn) {
+  g_events.emplace(std::make_pair(atUs, g_eventSeq++), std::move(fn));
+}
+
+void scheduleIn(uint64_t us, std::function<void()> fn) {
+  scheduleAt(::nowMicros() + us, std::move(fn));
+}
+
+void clearScheduledEvents() { g_events.clear(); }
+
+uint64_t blockedMicros() { return g_blockedUs; }
+
+void setAnalog(uint8_t pin, uint16_t value) { g_analogIn[pin] = value; }
+
+int lastAnalogWrite(uint8_t pin) {
+  auto it = g_analogOut.find(pin);
+  return it == g_analogOut.end() ? -1 : it->second;
+}
+
+void setNtpUnixTime(uint32_t t) {
+  g_ntpSet = true;
+  g_ntpBase = t;
+  g_ntpSetUs = ::nowMicros();
+}
+
+void setDigitalInput(uint8_t pin, uint8_t level) {
+  uint8_t old = digitalRead(pin);
+  g_digital[pin] = level;
+  auto it = g_isrs.find(pin);
+  if (it == g_isrs.end() || old == level)
+    return;
+  int edge = level ? RISING : FALLING;
+  if (it->second.second & edge)
+    it->second.first();
+}
+} // namespace host
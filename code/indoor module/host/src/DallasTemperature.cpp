@@ -0,0 +1,117 @@
+/**
+ * @file DallasTemperature.cpp
+ * @brief Host implementation of the DallasTemperature stand-in.
+ */
+
+#include <DallasTemperature.h>
+#include <vector>
+
+namespace {
+std::vector<float> g_probes = {21.5f}; ///< Simulated probe temperatures.
+uint32_t g_transactions = 0;
+
+void busTransaction() { g_transactions++; }
+} // namespace
+
+namespace host {
+void setProbeTemps(const float *temps, uint8_t count) {
+  g_probes.assign(temps, temps + count);
+}
+
+uint32_t oneWireTransactions() { return g_transactions; }
+
+void oneWireResetStats() { g_transactions = 0; }
+} // namespace host
+
+void DallasTemperature::begin() {
+  busTransaction();
+  // The library takes the resolution the probes report; a fresh DS18B20
+  // powers up at 12 bits.
+  _resolution = 12;
+}
+
+uint8_t DallasTemperature::getDeviceCount() { return (uint8_t)g_probes.size(); }
+
+bool DallasTemperature::getAddress(uint8_t *address, uint8_t index) {
+  busTransaction();
+  if (index >= g_probes.size())
+    return false;
+  const uint8_t rom[8] = {0x28, 0xAA, 0x10, 0x20, 0x30, 0x40, index, 0x5C};
+  std::memcpy(address, rom, sizeof(rom));
+  return true;
+}
+
+bool DallasTemperature::isConnected(const uint8_t *address) {
+  busTransaction();
+  return address && address[0] == 0x28 && address[6] < g_probes.size();
+}
+
+void DallasTemperature::setResolution(uint8_t bits) {
+  _resolution = std::min<uint8_t>(12, std::max<uint8_t>(9, bits));
+}
+
+bool DallasTemperature::setResolution(const uint8_t *address, uint8_t bits) {
+  busTransaction();
+  setResolution(bits);
+  return isConnected(address);
+}
+
+uint16_t DallasTemperature::millisToWaitForConversion(uint8_t bits) const {
+  switch (bits) {
+  case 9:
+    return 94;
+  case 10:
+    return 188;
+  case 11:
+    return 375;
+  default:
+    return 750;
+  }
+}
+
+DallasTemperature::request_t DallasTemperature::requestTemperatures() {
+  busTransaction();
+  _conversionStartMs = millis();
+  _converting = true;
+  if (_waitForConversion) {
+    delay(millisToWaitForConversion(_resolution));
+    _converting = false;
+  }
+  return {true, _conversionStartMs};
+}
+
+DallasTemperature::request_t
+DallasTemperature::requestTemperaturesByAddress(const uint8_t *address) {
+  if (!isConnected(address))
+    return {false, millis()};
+  return requestTemperatures();
+}
+
+DallasTemperature::request_t
+DallasTemperature::requestTemperaturesByIndex(uint8_t index) {
+  if (index >= g_probes.size())
+    return {false, millis()};
+  return requestTemperatures();
+}
+
+bool DallasTemperature::isConversionComplete() {
+  busTransaction();
+  if (_converting && millis() - _conversionStartMs >=
+                         millisToWaitForConversion(_resolution))
+    _converting = false;
+  return !_converting;
+}
+
+float DallasTemperature::getTempC(const uint8_t *address) {
+  busTransaction();
+  if (!address || address[0] != 0x28 || address[6] >= g_probes.size())
+    return DEVICE_DISCONNECTED_C;
+  return g_probes[address[6]];
+}
+
+float DallasTemperature::getTempCByIndex(uint8_t index) {
+  DeviceAddress addr;
+  if (!getAddress(addr, index))
+    return DEVICE_DISCONNECTED_C;
+  return getTempC(addr);
+}
@@ -0,0 +1,189 @@
+/**
+ * @file Drivers.cpp
+ * @brief Host implementation of the ADC continuous and LEDC driver
+ * stand-ins.
+ */
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <driver/ledc.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace {
+/// GPIO of each ADC1 channel.
+const uint8_t kAdc1Pins[ADC1_CHANNEL_MAX] = {36, 37, 38, 39, 32, 33, 34, 35};
+
+bool g_adcInit = false;
+bool g_adcRunning = false;
+uint32_t g_adcStoreBytes = 0;
+uint32_t g_adcHz = 0;
+uint8_t g_adcChannel = 0;
+uint64_t g_adcLastUs = 0;  ///< Conversions are counted from here.
+uint64_t g_adcPending = 0; ///< Conversions not read yet.
+uint64_t g_adcSamples = 0; ///< Conversions produced.
+
+/// @brief Counts the conversions done since the last call.
+void adcCatchUp() {
+  uint64_t now = host::nowMicros();
+  uint64_t n = (now - g_adcLastUs) * g_adcHz / 1000000;
+  if (n == 0)
+    return;
+  g_adcLastUs += n * 1000000 / g_adcHz;
+  g_adcSamples += n;
+  uint64_t keep = g_adcStoreBytes / SOC_ADC_DIGI_RESULT_BYTES;
+  g_adcPending = std::min(keep, g_adcPending + n);
+}
+
+/// @brief One LEDC channel: its pin and duty ramp.
+struct LedcChannel {
+  int gpio = -1;
+  uint32_t from = 0; ///< Duty at fadeStartUs.
+  uint32_t to = 0;   ///< Target duty.
+  uint64_t fadeStartUs = 0;
+  uint64_t fadeUs = 0;  ///< 0: duty is `to`.
+  uint32_t pending = 0; ///< Target of ledc_set_fade_with_time().
+  int pendingMs = 0;
+};
+
+std::map<std::pair<int, int>, LedcChannel> g_ledc;
+uint32_t g_ledcFades = 0;
+
+uint32_t dutyOf(const LedcChannel &c) {
+  uint64_t t = host::nowMicros() - c.fadeStartUs;
+  if (c.fadeUs == 0 || t >= c.fadeUs)
+    return c.to;
+  return (uint32_t)((int64_t)c.from +
+                    ((int64_t)c.to - (int64_t)c.from) * (int64_t)t /
+                        (int64_t)c.fadeUs);
+}
+} // namespace
+
+esp_err_t adc_digi_initialize(const adc_digi_init_config_t *init_config) {
+  if (!init_config || g_adcInit)
+    return ESP_ERR_INVALID_STATE;
+  g_adcInit = true;
+  g_adcStoreBytes = init_config->max_store_buf_size;
+  return ESP_OK;
+}
+
+esp_err_t adc_digi_controller_configure(const adc_digi_configuration_t *config) {
+  if (!g_adcInit || !config || config->pattern_num != 1 ||
+      config->adc_pattern[0].channel >= ADC1_CHANNEL_MAX)
+    return ESP_ERR_INVALID_ARG;
+  if (config->sample_freq_hz < 20000 || config->sample_freq_hz > 2000000)
+    return ESP_ERR_INVALID_ARG;
+  g_adcHz = config->sample_freq_hz;
+  g_adcChannel = config->adc_pattern[0].channel;
+  return ESP_OK;
+}
+
+esp_err_t adc_digi_start() {
+  if (!g_adcInit || !g_adcHz)
+    return ESP_ERR_INVALID_STATE;
+  g_adcRunning = true;
+  g_adcLastUs = host::nowMicros();
+  g_adcPending = 0;
+  return ESP_OK;
+}
+
+esp_err_t adc_digi_stop() {
+  g_adcRunning = false;
+  return ESP_OK;
+}
+
+esp_err_t adc_digi_read_bytes(uint8_t *buf, uint32_t length_max,
+                              uint32_t *out_length, uint32_t timeout_ms) {
+  (void)timeout_ms;
+  *out_length = 0;
+  if (!g_adcRunning)
+    return ESP_ERR_INVALID_STATE;
+  adcCatchUp();
+  uint32_t n = (uint32_t)std::min<uint64_t>(
+      g_adcPending, length_max / SOC_ADC_DIGI_RESULT_BYTES);
+  if (n == 0)
+    return ESP_ERR_TIMEOUT;
+  adc_digi_output_data_t d;
+  d.type1.channel = g_adcChannel;
+  d.type1.data = analogRead(kAdc1Pins[g_adcChannel]) & 0xFFF;
+  for (uint32_t i = 0; i < n; i++)
+    memcpy(buf + i * SOC_ADC_DIGI_RESULT_BYTES, &d.val, sizeof(d.val));
+  g_adcPending -= n;
+  *out_length = n * SOC_ADC_DIGI_RESULT_BYTES;
+  return ESP_OK;
+}
+
+esp_err_t adc_digi_deinitialize() {
+  g_adcInit = g_adcRunning = false;
+  return ESP_OK;
+}
+
+esp_err_t ledc_timer_config(const ledc_timer_config_t *timer_conf) {
+  return timer_conf ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t *ledc_conf) {
+  if (!ledc_conf)
+    return ESP_ERR_INVALID_ARG;
+  LedcChannel &c = g_ledc[{ledc_conf->speed_mode, ledc_conf->channel}];
+  c = LedcChannel();
+  c.gpio = ledc_conf->gpio_num;
+  c.to = ledc_conf->duty;
+  return ESP_OK;
+}
+
+esp_err_t ledc_fade_func_install(int intr_alloc_flags) {
+  (void)intr_alloc_flags;
+  return ESP_OK;
+}
+
+esp_err_t ledc_set_fade_with_time(ledc_mode_t speed_mode,
+                                  ledc_channel_t channel, uint32_t target_duty,
+                                  int max_fade_time_ms) {
+  auto it = g_ledc.find({speed_mode, channel});
+  if (it == g_ledc.end())
+    return ESP_ERR_INVALID_STATE;
+  it->second.pending = target_duty;
+  it->second.pendingMs = max_fade_time_ms;
+  return ESP_OK;
+}
+
+esp_err_t ledc_fade_start(ledc_mode_t speed_mode, ledc_channel_t channel,
+                          ledc_fade_mode_t fade_mode) {
+  auto it = g_ledc.find({speed_mode, channel});
+  if (it == g_ledc.end())
+    return ESP_ERR_INVALID_STATE;
+  LedcChannel &c = it->second;
+  c.from = dutyOf(c);
+  c.to = c.pending;
+  c.fadeStartUs = host::nowMicros();
+  c.fadeUs = (uint64_t)c.pendingMs * 1000;
+  g_ledcFades++;
+  if (fade_mode == LEDC_FADE_WAIT_DONE)
+    host::advanceMicros(c.fadeUs);
+  return ESP_OK;
+}
+
+uint32_t ledc_get_duty(ledc_mode_t speed_mode, ledc_channel_t channel) {
+  auto it = g_ledc.find({speed_mode, channel});
+  return it == g_ledc.end() ? 0 : dutyOf(it->second);
+}
+
+namespace host {
+uint64_t adcDmaSamples() {
+  if (g_adcRunning)
+    adcCatchUp();
+  return g_adcSamples;
+}
+
+uint32_t ledcFades() { return g_ledcFades; }
+
+int ledcPinDuty(int gpio) {
+  for (const auto &kv : g_ledc)
+    if (kv.second.gpio == gpio)
+      return (int)dutyOf(kv.second);
+  return -1;
+}
+} // namespace host
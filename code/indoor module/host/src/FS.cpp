@@ -0,0 +1,234 @@
+/**
+ * @file FS.cpp
+ * @brief Host implementation of the filesystem and LittleFS stand-ins.
+ */
+
+#include <FS.h>
+#include <LittleFS.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+#ifndef HOST_FS_ROOT
+#define HOST_FS_ROOT "data"
+#endif
+
+namespace fs {
+
+/**
+ * @struct FileImpl
+ * @brief Backing state of an open File.
+ */
+struct FileImpl {
+  FS *owner = nullptr;
+  std::string path;                            ///< Path inside the FS.
+  std::string name;                            ///< Last path component.
+  std::FILE *fp = nullptr;                     ///< Host file, if any.
+  std::shared_ptr<std::vector<uint8_t>> mem;   ///< Overlay contents, if any.
+  size_t pos = 0;                              ///< Overlay read position.
+  size_t size = 0;                             ///< File size.
+  bool dir = false;                            ///< Directory handle.
+  std::vector<std::string> entries;            ///< Directory entries.
+  size_t nextEntry = 0;                        ///< openNextFile() cursor.
+
+  ~FileImpl() {
+    if (fp)
+      std::fclose(fp);
+  }
+};
+
+File::operator bool() const { return _impl && (_impl->fp || _impl->mem || _impl->dir); }
+
+size_t File::size() const { return _impl ? _impl->size : 0; }
+
+size_t File::position() const {
+  if (!_impl)
+    return 0;
+  if (_impl->fp)
+    return (size_t)std::ftell(_impl->fp);
+  return _impl->pos;
+}
+
+int File::available() { return (int)(size() - position()); }
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t len) {
+  if (!_impl)
+    return 0;
+  auto t0 = std::chrono::steady_clock::now();
+  size_t n = 0;
+  if (_impl->fp) {
+    n = std::fread(buf, 1, len, _impl->fp);
+  } else if (_impl->mem) {
+    n = std::min(len, _impl->mem->size() - _impl->pos);
+    std::memcpy(buf, _impl->mem->data() + _impl->pos, n);
+    _impl->pos += n;
+  }
+  _impl->owner->noteRead(
+      n, std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - t0)
+             .count());
+  return n;
+}
+
+size_t File::write(const uint8_t *buf, size_t len) {
+  if (!_impl || !_impl->fp)
+    return 0;
+  size_t n = std::fwrite(buf, 1, len, _impl->fp);
+  _impl->size = std::max(_impl->size, position());
+  return n;
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+  if (!_impl)
+    return false;
+  if (_impl->fp)
+    return std::fseek(_impl->fp, (long)pos,
+                      mode == SeekSet   ? SEEK_SET
+                      : mode == SeekCur ? SEEK_CUR
+                                        : SEEK_END) == 0;
+  size_t base = mode == SeekSet ? 0 : mode == SeekCur ? _impl->pos : _impl->size;
+  _impl->pos = std::min(base + pos, _impl->size);
+  return true;
+}
+
+String File::readString() {
+  std::string out;
+  uint8_t buf[256];
+  size_t n;
+  while ((n = read(buf, sizeof(buf))) > 0)
+    out.append((const char *)buf, n);
+  return String(out);
+}
+
+void File::close() { _impl.reset(); }
+
+const char *File::name() const { return _impl ? _impl->name.c_str() : ""; }
+
+const char *File::path() const { return _impl ? _impl->path.c_str() : ""; }
+
+bool File::isDirectory() const { return _impl && _impl->dir; }
+
+File File::openNextFile() {
+  if (!_impl || !_impl->dir || _impl->nextEntry >= _impl->entries.size())
+    return File();
+  std::string child = _impl->path;
+  if (child.empty() || child.back() != '/')
+    child += '/';
+  child += _impl->entries[_impl->nextEntry++];
+  return _impl->owner->open(child.c_str(), "r");
+}
+
+FS::FS(const char *root) : _root(root) {}
+
+std::string FS::hostPath(const char *path) const {
+  std::string p = path ? path : "";
+  if (p.empty() || p[0] != '/')
+    p = "/" + p;
+  return _root + p;
+}
+
+File FS::open(const char *path, const char *mode) {
+  auto impl = std::make_shared<FileImpl>();
+  impl->owner = this;
+  impl->path = path ? path : "/";
+  size_t slash = impl->path.find_last_of('/');
+  impl->name = slash == std::string::npos ? impl->path
+                                          : impl->path.substr(slash + 1);
+
+  bool reading = !mode || mode[0] == 'r';
+  if (reading) {
+    for (auto &entry : _overlay) {
+      if (entry.first == impl->path) {
+        impl->mem = entry.second;
+        impl->size = entry.second->size();
+        _opens++;
+        return File(impl);
+      }
+    }
+  }
+
+  std::string hp = hostPath(path);
+  std::error_code ec;
+  if (reading && std::filesystem::is_directory(hp, ec)) {
+    impl->dir = true;
+    for (auto &e : std::filesystem::directory_iterator(hp, ec))
+      impl->entries.push_back(e.path().filename().string());
+    _opens++;
+    return File(impl);
+  }
+
+  impl->fp = std::fopen(hp.c_str(), reading ? "rb" : mode[0] == 'a' ? "ab" : "wb");
+  if (!impl->fp)
+    return File();
+  std::fseek(impl->fp, 0, SEEK_END);
+  impl->size = (size_t)std::ftell(impl->fp);
+  if (reading)
+    std::fseek(impl->fp, 0, SEEK_SET);
+  _opens++;
+  return File(impl);
+}
+
+bool FS::exists(const char *path) {
+  for (auto &entry : _overlay)
+    if (entry.first == path)
+      return true;
+  std::error_code ec;
+  return std::filesystem::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char *path) {
+  for (auto it = _overlay.begin(); it != _overlay.end(); ++it) {
+    if (it->first == path) {
+      _overlay.erase(it);
+      return true;
+    }
+  }
+  return std::remove(hostPath(path).c_str()) == 0;
+}
+
+void FS::addOverlay(const char *path, const std::string &data) {
+  auto buf = std::make_shared<std::vector<uint8_t>>(data.begin(), data.end());
+  for (auto &entry : _overlay) {
+    if (entry.first == path) {
+      entry.second = buf;
+      return;
+    }
+  }
+  _overlay.emplace_back(path, buf);
+}
+
+void FS::removeOverlay(const char *path) {
+  for (auto it = _overlay.begin(); it != _overlay.end(); ++it) {
+    if (it->first == path) {
+      _overlay.erase(it);
+      return;
+    }
+  }
+}
+
+void FS::clearOverlay() { _overlay.clear(); }
+
+LittleFSFS::LittleFSFS() : FS(HOST_FS_ROOT) {
+  if (const char *root = std::getenv("METEO_FS_ROOT"))
+    setRoot(root);
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath,
+                       uint8_t maxOpenFiles, const char *partitionLabel) {
+  (void)formatOnFail;
+  (void)basePath;
+  (void)maxOpenFiles;
+  (void)partitionLabel;
+  std::error_code ec;
+  return std::filesystem::is_directory(root(), ec);
+}
+
+} // namespace fs
+
+fs::LittleFSFS LittleFS;
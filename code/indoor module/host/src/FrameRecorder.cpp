@@ -0,0 +1,118 @@
+/**
+ * @file FrameRecorder.cpp
+ * @brief Host implementation of the firmware trace hooks.
+ */
+
+#include <FrameRecorder.h>
+#include <LittleFS.h>
+#include <TFT_eSPI.h>
+#include <chrono>
+
+namespace {
+using SteadyClock = std::chrono::steady_clock;
+
+/// Counter values captured when a traced region starts.
+struct Snapshot {
+  SteadyClock::time_point t0;
+  TFT_eSPI::HostStats tft;
+  uint64_t fsBytes;
+  uint32_t fsOpens;
+  uint64_t fsNs;
+  uint32_t pngDecodes;
+  uint64_t inflateNs;
+  uint32_t rleDecodes;
+  uint64_t rleNs;
+  size_t record; ///< Index of the record being filled.
+};
+
+std::vector<host::FrameRecord> g_records;
+std::vector<Snapshot> g_open;
+uint32_t g_pngDecodes = 0;
+uint64_t g_inflateNs = 0;
+uint32_t g_rleDecodes = 0;
+uint64_t g_rleNs = 0;
+Snapshot g_decode; ///< Snapshot of the image decode in progress.
+
+uint64_t nanosSince(SteadyClock::time_point t0) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             SteadyClock::now() - t0)
+      .count();
+}
+
+Snapshot capture() {
+  Snapshot s;
+  s.tft = TFT_eSPI::hostStats();
+  s.fsBytes = LittleFS.bytesRead();
+  s.fsOpens = LittleFS.opens();
+  s.fsNs = LittleFS.readNanos();
+  s.pngDecodes = g_pngDecodes;
+  s.inflateNs = g_inflateNs;
+  s.rleDecodes = g_rleDecodes;
+  s.rleNs = g_rleNs;
+  s.record = 0;
+  s.t0 = SteadyClock::now();
+  return s;
+}
+} // namespace
+
+void traceBegin(TraceId id, int32_t arg) {
+  if (id == TRACE_PNG_DECODE || id == TRACE_RLE_DECODE) {
+    g_decode = capture();
+    return;
+  }
+  Snapshot s = capture();
+  s.record = g_records.size();
+  host::FrameRecord r = {};
+  r.id = id;
+  r.arg = arg;
+  r.depth = (uint8_t)g_open.size();
+  g_records.push_back(r);
+  g_open.push_back(s);
+}
+
+void traceEnd(TraceId id) {
+  if (id == TRACE_PNG_DECODE || id == TRACE_RLE_DECODE) {
+    uint64_t wall = nanosSince(g_decode.t0);
+    uint64_t io = (TFT_eSPI::hostStats().driverNs - g_decode.tft.driverNs) +
+                  (LittleFS.readNanos() - g_decode.fsNs);
+    uint64_t cpu = wall > io ? wall - io : 0;
+    if (id == TRACE_PNG_DECODE) {
+      g_inflateNs += cpu;
+      g_pngDecodes++;
+    } else {
+      g_rleNs += cpu;
+      g_rleDecodes++;
+    }
+    return;
+  }
+  if (g_open.empty())
+    return;
+
+  Snapshot s = g_open.back();
+  g_open.pop_back();
+  const TFT_eSPI::HostStats &tft = TFT_eSPI::hostStats();
+  host::FrameRecord &r = g_records[s.record];
+  r.wallNs = nanosSince(s.t0);
+  r.pixels = tft.pixels - s.tft.pixels;
+  r.pushImageCalls = tft.pushImageCalls - s.tft.pushImageCalls;
+  r.streamCalls = tft.streamCalls - s.tft.streamCalls;
+  r.fillCalls = tft.fillCalls - s.tft.fillCalls;
+  r.fontLoads = tft.fontLoads - s.tft.fontLoads;
+  r.driverNs = tft.driverNs - s.tft.driverNs;
+  r.fsBytes = LittleFS.bytesRead() - s.fsBytes;
+  r.fsOpens = LittleFS.opens() - s.fsOpens;
+  r.fsNs = LittleFS.readNanos() - s.fsNs;
+  r.pngDecodes = g_pngDecodes - s.pngDecodes;
+  r.inflateNs = g_inflateNs - s.inflateNs;
+  r.rleDecodes = g_rleDecodes - s.rleDecodes;
+  r.rleNs = g_rleNs - s.rleNs;
+}
+
+namespace host {
+const std::vector<FrameRecord> &frameRecords() { return g_records; }
+
+void clearFrameRecords() {
+  g_records.clear();
+  g_open.clear();
+}
+} // namespace host
@@ -0,0 +1,37 @@
+/**
+ * @file Heap.cpp
+ * @brief Routes host allocations to the firmware's heap tracker.
+ */
+
+#ifdef METEO_HEAP_TRACK
+
+#include <HeapTracker.h>
+
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+void *operator new(size_t size) {
+  void *p = std::malloc(size ? size : 1);
+  if (!p)
+    throw std::bad_alloc();
+  heapTrackAlloc(malloc_usable_size(p));
+  return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept {
+  if (!p)
+    return;
+  heapTrackFree(malloc_usable_size(p));
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept { operator delete(p); }
+
+void operator delete(void *p, size_t) noexcept { operator delete(p); }
+
+void operator delete[](void *p, size_t) noexcept { operator delete(p); }
+
+#endif
@@ -0,0 +1,154 @@
+/**
+ * @file Mqtt.cpp
+ * @brief Host implementation of the WiFiClientSecure and PubSubClient
+ * stand-ins.
+ */
+
+#include <PubSubClient.h>
+#include <WiFi.h>
+#include <WiFiClientSecure.h>
+#include <string>
+#include <vector>
+
+namespace {
+uint32_t g_tlsHandshakeMs = 1200; ///< Virtual full-handshake time.
+uint32_t g_tlsGeneration = 0;
+uint32_t g_tlsHandshakes = 0;
+uint32_t g_publishes = 0;
+uint32_t g_connects = 0;
+String g_lastTopic;
+String g_lastPayload;
+} // namespace
+
+namespace host {
+void setTlsHandshakeMs(uint32_t ms) { g_tlsHandshakeMs = ms; }
+void tlsDropConnections() { g_tlsGeneration++; }
+uint32_t tlsHandshakeCount() { return g_tlsHandshakes; }
+uint32_t mqttPublishCount() { return g_publishes; }
+uint32_t mqttConnectCount() { return g_connects; }
+const String &mqttLastTopic() { return g_lastTopic; }
+const String &mqttLastPayload() { return g_lastPayload; }
+void mqttResetStats() {
+  g_publishes = 0;
+  g_connects = 0;
+  g_tlsHandshakes = 0;
+}
+} // namespace host
+
+int WiFiClientSecure::connect(const char *host, uint16_t port) {
+  (void)host;
+  (void)port;
+  if (WiFi.status() != WL_CONNECTED || !_ca || !_cert || !_key)
+    return 0;
+  delay(g_tlsHandshakeMs);
+  g_tlsHandshakes++;
+  _generation = g_tlsGeneration;
+  _connected = true;
+  return 1;
+}
+
+uint8_t WiFiClientSecure::connected() {
+  if (_connected &&
+      (WiFi.status() != WL_CONNECTED || _generation != g_tlsGeneration))
+    stop();
+  return _connected;
+}
+
+size_t WiFiClientSecure::write(const uint8_t *buf, size_t size) {
+  (void)buf;
+  return _connected ? size : 0;
+}
+
+PubSubClient &PubSubClient::setServer(const char *domain, uint16_t port) {
+  _domain = domain;
+  _port = port;
+  return *this;
+}
+
+PubSubClient &PubSubClient::setCallback(
+    std::function<void(char *, uint8_t *, unsigned int)> callback) {
+  _callback = std::move(callback);
+  return *this;
+}
+
+PubSubClient &PubSubClient::setClient(Client &client) {
+  _client = &client;
+  return *this;
+}
+
+PubSubClient &PubSubClient::setKeepAlive(uint16_t keepAlive) {
+  _keepAlive = keepAlive;
+  return *this;
+}
+
+PubSubClient &PubSubClient::setSocketTimeout(uint16_t timeout) {
+  _socketTimeout = timeout;
+  return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size) { return size > 0; }
+
+bool PubSubClient::connect(const char *id) {
+  (void)id;
+  if (!_client || !_domain)
+    return false;
+  if (!_client->connected() && !_client->connect(_domain, _port)) {
+    _state = -2;
+    return false;
+  }
+  g_connects++;
+  _connected = true;
+  _state = 0;
+  return true;
+}
+
+void PubSubClient::disconnect() {
+  if (_client)
+    _client->stop();
+  _connected = false;
+  _state = -1;
+}
+
+bool PubSubClient::publish(const char *topic, const char *payload) {
+  return publish(topic, payload, false);
+}
+
+bool PubSubClient::publish(const char *topic, const char *payload,
+                           bool retained) {
+  (void)retained;
+  if (!connected())
+    return false;
+  size_t n = std::strlen(payload);
+  _client->write((const uint8_t *)payload, n);
+  g_publishes++;
+  g_lastTopic = topic;
+  g_lastPayload = payload;
+  return true;
+}
+
+bool PubSubClient::subscribe(const char *topic) {
+  (void)topic;
+  return connected();
+}
+
+bool PubSubClient::unsubscribe(const char *topic) {
+  (void)topic;
+  return connected();
+}
+
+bool PubSubClient::loop() { return connected(); }
+
+bool PubSubClient::connected() {
+  if (_connected && (!_client || !_client->connected()))
+    _connected = false;
+  return _connected;
+}
+
+void PubSubClient::hostDeliver(const char *topic, const uint8_t *payload,
+                               unsigned len) {
+  if (!_callback)
+    return;
+  std::string t(topic);
+  std::vector<uint8_t> p(payload, payload + len);
+  _callback(&t[0], p.data(), len);
+}
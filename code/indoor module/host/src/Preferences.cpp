@@ -0,0 +1,74 @@
+/**
+ * @file Preferences.cpp
+ * @brief Host implementation of the Preferences stand-in.
+ */
+
+#include <Preferences.h>
+#include <map>
+#include <string>
+
+namespace {
+std::map<std::string, std::map<std::string, std::string>> g_nvs;
+}
+
+bool Preferences::begin(const char *name, bool readOnly,
+                        const char *partitionLabel) {
+  (void)partitionLabel;
+  _ns = name;
+  _readOnly = readOnly;
+  _open = true;
+  return true;
+}
+
+void Preferences::end() { _open = false; }
+
+bool Preferences::clear() {
+  if (!_open || _readOnly)
+    return false;
+  g_nvs[_ns.c_str()].clear();
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  if (!_open || _readOnly)
+    return false;
+  return g_nvs[_ns.c_str()].erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+  if (!_open)
+    return false;
+  auto &ns = g_nvs[_ns.c_str()];
+  return ns.find(key) != ns.end();
+}
+
+String Preferences::getString(const char *key, const String &defaultValue) {
+  if (!_open)
+    return defaultValue;
+  auto &ns = g_nvs[_ns.c_str()];
+  auto it = ns.find(key);
+  return it == ns.end() ? defaultValue : String(it->second);
+}
+
+size_t Preferences::putString(const char *key, const String &value) {
+  if (!_open || _readOnly)
+    return 0;
+  g_nvs[_ns.c_str()][key] = value.c_str();
+  return value.length();
+}
+
+uint32_t Preferences::getUInt(const char *key, uint32_t defaultValue) {
+  if (!_open)
+    return defaultValue;
+  auto &ns = g_nvs[_ns.c_str()];
+  auto it = ns.find(key);
+  return it == ns.end() ? defaultValue
+                        : (uint32_t)std::stoul(it->second);
+}
+
+size_t Preferences::putUInt(const char *key, uint32_t value) {
+  if (!_open || _readOnly)
+    return 0;
+  g_nvs[_ns.c_str()][key] = std::to_string(value);
+  return sizeof(value);
+}
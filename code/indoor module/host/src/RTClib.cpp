@@ -0,0 +1,169 @@
+/**
+ * @file RTClib.cpp
+ * @brief Host implementation of the RTClib and Wire stand-ins.
+ */
+
+#include <RTClib.h>
+
+TwoWire Wire;
+
+namespace {
+/// Simulated DS3231 time at g_rtcSetMs: 2026-01-18 12:00:00 UTC.
+uint32_t g_rtcBase = 1768737600UL;
+unsigned long g_rtcSetMs = 0;
+
+int g_intPin = -1;           ///< ESP32 pin on INT/SQW, or -1.
+bool g_intcn = false;        ///< INT/SQW outputs alarms, not the square wave.
+bool g_a2Enabled = false;    ///< Alarm 2 interrupt enabled.
+bool g_a2Flag = false;       ///< A2F: alarm 2 matched since last cleared.
+uint32_t g_a2Generation = 0; ///< Invalidates previously scheduled matches.
+
+/// @brief Drives INT low while an enabled alarm is flagged.
+void updateIntPin() {
+  if (g_intPin >= 0)
+    host::setDigitalInput(g_intPin, g_intcn && g_a2Enabled && g_a2Flag ? LOW
+                                                                       : HIGH);
+}
+
+/// @brief Schedules the next once-per-minute match of alarm 2.
+void scheduleAlarm2() {
+  uint32_t generation = ++g_a2Generation;
+  if (!g_a2Enabled)
+    return;
+  uint32_t t = g_rtcBase + (uint32_t)((millis() - g_rtcSetMs) / 1000);
+  uint32_t next = (t / 60 + 1) * 60;
+  uint64_t atMs = g_rtcSetMs + (uint64_t)(next - g_rtcBase) * 1000;
+  host::scheduleAt(atMs * 1000, [generation] {
+    if (generation != g_a2Generation)
+      return;
+    g_a2Flag = true;
+    updateIntPin();
+    scheduleAlarm2();
+  });
+}
+
+// Howard Hinnant's days-from-civil / civil-from-days.
+int64_t daysFromCivil(int64_t y, unsigned m, unsigned d) {
+  y -= m <= 2;
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const unsigned yoe = (unsigned)(y - era * 400);
+  const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + (int64_t)doe - 719468;
+}
+
+void civilFromDays(int64_t z, int64_t &y, unsigned &m, unsigned &d) {
+  z += 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const unsigned doe = (unsigned)(z - era * 146097);
+  const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  y = (int64_t)yoe + era * 400;
+  const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const unsigned mp = (5 * doy + 2) / 153;
+  d = doy - (153 * mp + 2) / 5 + 1;
+  m = mp < 10 ? mp + 3 : mp - 9;
+  y += m <= 2;
+}
+} // namespace
+
+DateTime::DateTime(uint32_t t) : _unix(t) {
+  int64_t y;
+  unsigned m, d;
+  civilFromDays(t / 86400, y, m, d);
+  uint32_t secs = t % 86400;
+  _y = (uint16_t)y;
+  _m = (uint8_t)m;
+  _d = (uint8_t)d;
+  _hh = secs / 3600;
+  _mm = (secs / 60) % 60;
+  _ss = secs % 60;
+}
+
+DateTime::DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour,
+                   uint8_t min, uint8_t sec)
+    : _y(year < 100 ? year + 2000 : year), _m(month), _d(day), _hh(hour),
+      _mm(min), _ss(sec) {
+  _unix = (uint32_t)(daysFromCivil(_y, _m, _d) * 86400 + hour * 3600 +
+                     min * 60 + sec);
+}
+
+uint8_t DateTime::dayOfTheWeek() const {
+  return (uint8_t)((_unix / 86400 + 4) % 7); // 1970-01-01 was a Thursday.
+}
+
+bool RTC_DS3231::begin(TwoWire *wireInstance) {
+  _wire = wireInstance;
+  _wire->hostTransaction(1);
+  return true;
+}
+
+DateTime RTC_DS3231::now() {
+  _wire->hostTransaction(8); // Register pointer write + 7 time registers.
+  return DateTime(g_rtcBase + (uint32_t)((millis() - g_rtcSetMs) / 1000));
+}
+
+void RTC_DS3231::adjust(const DateTime &dt) {
+  _wire->hostTransaction(8);
+  host::setRtcUnixTime(dt.unixtime());
+}
+
+void RTC_DS3231::writeSqwPinMode(Ds3231SqwPinMode mode) {
+  _wire->hostTransaction(3); // Read-modify-write of the control register.
+  g_intcn = mode == DS3231_OFF;
+  updateIntPin();
+}
+
+void RTC_DS3231::disable32K() { _wire->hostTransaction(3); }
+
+bool RTC_DS3231::setAlarm2(const DateTime &dt, Ds3231Alarm2Mode alarmMode) {
+  (void)dt;
+  _wire->hostTransaction(7); // Alarm registers, then enable A2IE.
+  if (alarmMode != DS3231_A2_PerMinute || !g_intcn)
+    return false; // Only the per-minute mode is simulated.
+  g_a2Enabled = true;
+  scheduleAlarm2();
+  return true;
+}
+
+void RTC_DS3231::disableAlarm(uint8_t alarmNum) {
+  _wire->hostTransaction(3);
+  if (alarmNum == 2) {
+    g_a2Enabled = false;
+    scheduleAlarm2();
+    updateIntPin();
+  }
+}
+
+void RTC_DS3231::clearAlarm(uint8_t alarmNum) {
+  _wire->hostTransaction(3);
+  if (alarmNum == 2) {
+    g_a2Flag = false;
+    updateIntPin();
+    scheduleAlarm2(); // Re-arms after host::clearScheduledEvents().
+  }
+}
+
+bool RTC_DS3231::alarmFired(uint8_t alarmNum) {
+  _wire->hostTransaction(2);
+  return alarmNum == 2 && g_a2Flag;
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+  (void)sda;
+  (void)scl;
+  (void)frequency;
+  return true;
+}
+
+namespace host {
+void setRtcUnixTime(uint32_t t) {
+  g_rtcBase = t;
+  g_rtcSetMs = millis();
+  scheduleAlarm2();
+}
+
+void setRtcIntPin(uint8_t pin) {
+  g_intPin = pin;
+  updateIntPin();
+}
+} // namespace host
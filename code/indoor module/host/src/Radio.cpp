@@ -0,0 +1,491 @@
+/**
+ * @file Radio.cpp
+ * @brief Host implementation of the WiFi, esp_wifi, ESP-NOW and esp_sleep
+ * stand-ins on top of the simulated radio medium (RadioSim.h).
+ */
+
+#include <RadioSim.h>
+#include <WiFi.h>
+#include <esp_now.h>
+#include <esp_sleep.h>
+#include <esp_wifi.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+WiFiClass WiFi;
+
+namespace {
+constexpr uint64_t kForever = UINT64_MAX;
+constexpr uint8_t kMaxChannel = 13;
+const uint8_t kDefaultMac[6] = {0xf4, 0x65, 0x0b, 0xe9, 0x77, 0x78};
+
+/// @brief WiFi/ESP-NOW driver state of one simulated device.
+struct Node {
+  uint8_t mac[6];
+  wifi_mode_t mode = WIFI_OFF;
+  wl_status_t status = WL_IDLE_STATUS;
+  uint64_t connectAtUs = 0; ///< Association completes (0 = not joining).
+  uint8_t channel = 1;      ///< Channel outside of a hop window.
+  uint64_t hopStartUs = 0;  ///< Start of the current channel sweep.
+  uint64_t hopEndUs = 0;    ///< End of the sweep (0 = not hopping).
+  uint8_t hopLand = 1;      ///< Channel the sweep ends on.
+  bool sleep = true;
+  bool espNowReady = false;
+  esp_now_recv_cb_t recvCb = nullptr;
+  esp_now_send_cb_t sendCb = nullptr;
+  bool promiscuous = false;
+  uint32_t promiscFilter = WIFI_PROMIS_FILTER_MASK_ALL;
+  wifi_promiscuous_cb_t promiscCb = nullptr;
+  uint64_t onSinceUs = 0; ///< Radio powered since (valid while mode != OFF).
+  host::RadioStats stats;
+};
+
+std::string g_apSsid;           ///< Simulated AP SSID (empty = none).
+uint8_t g_apChannel = 6;        ///< Simulated AP channel.
+uint32_t g_apJoinMs = 800;      ///< Virtual association time.
+uint32_t g_joinCount = 0;       ///< WiFi.begin() calls.
+uint32_t g_espNowInits = 0;     ///< esp_now_init() calls.
+uint64_t g_sleepUs = 0;         ///< Armed deep-sleep timer.
+
+host::RadioParams g_params;
+std::vector<Node> g_nodes;
+host::NodeId g_current = 0;
+std::map<std::pair<host::NodeId, host::NodeId>, host::LinkParams> g_links;
+std::mt19937 g_rng(1);
+
+std::vector<Node> &nodes() {
+  if (g_nodes.empty()) {
+    g_nodes.emplace_back();
+    memcpy(g_nodes[0].mac, kDefaultMac, 6);
+  }
+  return g_nodes;
+}
+
+Node &node(host::NodeId id) { return nodes()[id]; }
+Node &cur() { return node(g_current); }
+
+bool validNode(host::NodeId id) { return id < nodes().size(); }
+
+uint64_t nowUs() { return host::nowMicros(); }
+
+/// @brief Applies state changes that were due by now (join, end of sweep).
+void settle(Node &n) {
+  uint64_t now = nowUs();
+  if (n.hopEndUs && now >= n.hopEndUs) {
+    n.channel = n.hopLand;
+    n.hopEndUs = 0;
+  }
+  if (n.status == WL_DISCONNECTED && n.connectAtUs && now >= n.connectAtUs) {
+    n.status = WL_CONNECTED;
+    n.connectAtUs = 0;
+    n.channel = g_apChannel;
+  }
+}
+
+/// @brief Channel the node listens on now (0 = radio off).
+uint8_t channelOf(Node &n) {
+  if (n.mode == WIFI_OFF)
+    return 0;
+  settle(n);
+  uint64_t now = nowUs();
+  if (n.hopEndUs && now >= n.hopStartUs) {
+    uint64_t dwellUs = (uint64_t)g_params.hopDwellMs * 1000ULL;
+    return (uint8_t)(1 + ((now - n.hopStartUs) / dwellUs) % kMaxChannel);
+  }
+  return n.channel;
+}
+
+void startHop(Node &n, uint64_t endUs, uint8_t land) {
+  n.channel = channelOf(n) ? channelOf(n) : n.channel;
+  n.hopStartUs = nowUs();
+  n.hopEndUs = endUs;
+  n.hopLand = land;
+  n.stats.hopsStarted++;
+}
+
+void stopHop(Node &n) {
+  if (!n.hopEndUs)
+    return;
+  uint8_t ch = channelOf(n);
+  n.hopEndUs = 0;
+  if (ch)
+    n.channel = ch;
+}
+
+void setMode(Node &n, wifi_mode_t m) {
+  bool wasOn = n.mode != WIFI_OFF;
+  bool on = m != WIFI_OFF;
+  if (!wasOn && on)
+    n.onSinceUs = nowUs();
+  else if (wasOn && !on)
+    n.stats.radioOnUs += nowUs() - n.onSinceUs;
+  n.mode = m;
+}
+
+int findNode(const uint8_t *mac) {
+  for (size_t i = 0; i < nodes().size(); i++)
+    if (memcmp(g_nodes[i].mac, mac, 6) == 0)
+      return (int)i;
+  return -1;
+}
+
+/// @brief Shows an ESP-NOW frame to @p rx's promiscuous callback the way the
+/// driver does: a vendor-specific action frame from @p txMac.
+void sniffEspNow(Node &rx, const uint8_t *txMac, int len, int8_t rssi) {
+  if (!rx.promiscuous || !rx.promiscCb ||
+      !(rx.promiscFilter & WIFI_PROMIS_FILTER_MASK_MGMT))
+    return;
+  uint8_t buf[sizeof(wifi_promiscuous_pkt_t) + 24] = {};
+  wifi_promiscuous_pkt_t *pkt = (wifi_promiscuous_pkt_t *)buf;
+  pkt->rx_ctrl.rssi = rssi;
+  pkt->rx_ctrl.channel = rx.channel;
+  pkt->rx_ctrl.sig_len = 24 + 15 + len; // Header, vendor IE, payload.
+  uint8_t *hdr = pkt->payload;
+  hdr[0] = 0xD0; // Management, subtype action.
+  memset(hdr + 4, 0xFF, 6);
+  memcpy(hdr + 10, txMac, 6);
+  memset(hdr + 16, 0xFF, 6);
+  rx.promiscCb(buf, WIFI_PKT_MGMT);
+}
+
+bool chance(float p) {
+  return p > 0.0f && std::uniform_real_distribution<float>(0.0f, 1.0f)(g_rng) < p;
+}
+} // namespace
+
+// --- esp_wifi ---
+
+esp_err_t esp_wifi_set_promiscuous(bool en) {
+  cur().promiscuous = en;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+  cur().promiscCb = cb;
+  return ESP_OK;
+}
+
+esp_err_t
+esp_wifi_set_promiscuous_filter(const wifi_promiscuous_filter_t *filter) {
+  if (!filter)
+    return ESP_ERR_INVALID_ARG;
+  cur().promiscFilter = filter->filter_mask;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+  (void)second;
+  if (primary < 1 || primary > 14)
+    return ESP_ERR_INVALID_ARG;
+  Node &n = cur();
+  stopHop(n);
+  n.channel = primary;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_get_channel(uint8_t *primary, wifi_second_chan_t *second) {
+  if (primary)
+    *primary = WiFi.channel();
+  if (second)
+    *second = WIFI_SECOND_CHAN_NONE;
+  return ESP_OK;
+}
+
+// --- ESP-NOW ---
+
+esp_err_t esp_now_init() {
+  cur().espNowReady = true;
+  g_espNowInits++;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_deinit() {
+  Node &n = cur();
+  n.espNowReady = false;
+  n.recvCb = nullptr;
+  n.sendCb = nullptr;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t cb) {
+  if (!cur().espNowReady)
+    return ESP_ERR_INVALID_STATE;
+  cur().recvCb = cb;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t cb) {
+  if (!cur().espNowReady)
+    return ESP_ERR_INVALID_STATE;
+  cur().sendCb = cb;
+  return ESP_OK;
+}
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t *peer) {
+  return cur().espNowReady && peer ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+esp_err_t esp_now_send(const uint8_t *peer_addr, const uint8_t *data,
+                       size_t len) {
+  Node &tx = cur();
+  if (!tx.espNowReady || tx.mode == WIFI_OFF)
+    return ESP_ERR_INVALID_STATE;
+  if (!peer_addr || !data || len == 0 || len > ESP_NOW_MAX_DATA_LEN)
+    return ESP_ERR_INVALID_ARG;
+  tx.stats.sends++;
+
+  const host::NodeId txId = g_current;
+  const int rxIdx = findNode(peer_addr);
+  const host::LinkParams fwd =
+      rxIdx >= 0 ? g_links[{txId, (host::NodeId)rxIdx}] : host::LinkParams();
+  const host::LinkParams rev =
+      rxIdx >= 0 ? g_links[{(host::NodeId)rxIdx, txId}] : host::LinkParams();
+  const uint8_t ch = channelOf(tx);
+  const bool rxListening = rxIdx >= 0 && rxIdx != txId &&
+                           node(rxIdx).espNowReady &&
+                           channelOf(node(rxIdx)) == ch;
+
+  // Lay out the MAC-level exchange: frame, SIFS + turnaround, ACK; a missing
+  // ACK costs the ACK timeout before the retransmission.
+  const uint32_t frameUs =
+      g_params.preambleUs +
+      (g_params.macOverheadBytes + (uint32_t)len) * g_params.usPerByte;
+  const uint32_t ackUs =
+      g_params.preambleUs + g_params.ackBytes * g_params.usPerByte;
+  uint64_t t = 0, deliverAt = 0;
+  bool delivered = false, acked = false;
+  for (int attempt = 0; attempt <= fwd.macRetries && !acked; attempt++) {
+    tx.stats.transmissions++;
+    tx.stats.txAirtimeUs += frameUs;
+    t += frameUs;
+    if (!rxListening || chance(fwd.loss)) {
+      t += g_params.ackTimeoutUs;
+      continue;
+    }
+    if (!delivered) {
+      delivered = true;
+      deliverAt = t;
+    }
+    uint32_t turnaround = g_params.sifsUs + fwd.ackLatencyUs;
+    node(rxIdx).stats.txAirtimeUs += ackUs;
+    if (turnaround <= g_params.ackTimeoutUs && !chance(rev.loss)) {
+      acked = true;
+      t += turnaround + ackUs;
+    } else {
+      t += g_params.ackTimeoutUs;
+    }
+  }
+
+  std::vector<uint8_t> frame(data, data + len);
+  uint8_t txMac[6], rxMac[6];
+  memcpy(txMac, tx.mac, 6);
+  memcpy(rxMac, peer_addr, 6);
+  uint64_t now = nowUs();
+  if (delivered) {
+    host::NodeId rxId = (host::NodeId)rxIdx;
+    int8_t rssi = fwd.rssi;
+    host::scheduleAt(now + deliverAt, [rxId, frame, txMac, rssi]() {
+      if (!validNode(rxId))
+        return;
+      Node &rx = node(rxId);
+      if (!rx.espNowReady || !rx.recvCb)
+        return;
+      rx.stats.delivered++;
+      host::NodeScope scope(rxId);
+      sniffEspNow(rx, txMac, (int)frame.size(), rssi);
+      rx.recvCb(txMac, frame.data(), (int)frame.size());
+    });
+  }
+  host::scheduleAt(now + t, [txId, rxMac, acked]() {
+    if (!validNode(txId))
+      return;
+    Node &n = node(txId);
+    if (acked)
+      n.stats.sendSuccess++;
+    if (!n.sendCb)
+      return;
+    host::NodeScope scope(txId);
+    n.sendCb(rxMac, acked ? ESP_NOW_SEND_SUCCESS : ESP_NOW_SEND_FAIL);
+  });
+  return ESP_OK;
+}
+
+// --- esp_sleep ---
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t time_in_us) {
+  g_sleepUs = time_in_us;
+  return ESP_OK;
+}
+
+void esp_deep_sleep_start() {
+  host::radioOff(g_current);
+  throw host::DeepSleep{g_current, g_sleepUs};
+}
+
+namespace host {
+bool espNowInject(const uint8_t *mac, const uint8_t *data, int len,
+                  int8_t rssi) {
+  Node &n = cur();
+  if (!n.espNowReady || !n.recvCb)
+    return false;
+  sniffEspNow(n, mac, len, rssi);
+  n.recvCb(mac, data, len);
+  return true;
+}
+
+uint32_t espNowInitCount() { return g_espNowInits; }
+
+void setAccessPoint(const char *ssid, uint8_t channel, uint32_t joinMs) {
+  g_apSsid = ssid ? ssid : "";
+  g_apChannel = channel;
+  g_apJoinMs = joinMs;
+}
+
+uint32_t wifiJoinCount() { return g_joinCount; }
+
+void setRadioParams(const RadioParams &params) { g_params = params; }
+
+const RadioParams &radioParams() { return g_params; }
+
+NodeId addRadioNode(const uint8_t mac[6]) {
+  nodes().emplace_back();
+  memcpy(g_nodes.back().mac, mac, 6);
+  return (NodeId)(g_nodes.size() - 1);
+}
+
+void setNodeMac(NodeId id, const uint8_t mac[6]) { memcpy(node(id).mac, mac, 6); }
+
+NodeId currentNode() { return g_current; }
+
+void setCurrentNode(NodeId id) {
+  if (validNode(id))
+    g_current = id;
+}
+
+void setLink(NodeId from, NodeId to, const LinkParams &params) {
+  g_links[{from, to}] = params;
+}
+
+uint8_t nodeChannel(NodeId id) { return channelOf(node(id)); }
+
+void startChannelHop(NodeId id, uint32_t durationMs, uint8_t landOn) {
+  Node &n = node(id);
+  uint8_t land = landOn ? landOn : (channelOf(n) ? channelOf(n) : n.channel);
+  startHop(n, nowUs() + (uint64_t)durationMs * 1000ULL, land);
+}
+
+RadioStats radioStats(NodeId id) {
+  Node &n = node(id);
+  RadioStats s = n.stats;
+  if (n.mode != WIFI_OFF)
+    s.radioOnUs += nowUs() - n.onSinceUs;
+  return s;
+}
+
+void resetRadioStats() {
+  for (Node &n : nodes()) {
+    n.stats = RadioStats();
+    n.onSinceUs = nowUs();
+  }
+}
+
+void radioOff(NodeId id) {
+  Node &n = node(id);
+  stopHop(n);
+  n.status = WL_IDLE_STATUS;
+  n.connectAtUs = 0;
+  n.espNowReady = false;
+  n.recvCb = nullptr;
+  n.sendCb = nullptr;
+  setMode(n, WIFI_OFF);
+}
+
+void seedRadio(uint32_t seed) { g_rng.seed(seed); }
+
+void resetRadio() {
+  g_nodes.clear();
+  g_links.clear();
+  g_current = 0;
+  nodes();
+}
+} // namespace host
+
+// --- WiFi ---
+
+bool WiFiClass::mode(wifi_mode_t m) {
+  setMode(cur(), m);
+  return true;
+}
+
+wifi_mode_t WiFiClass::getMode() const { return cur().mode; }
+
+wl_status_t WiFiClass::begin(const char *ssid, const char *pass) {
+  (void)pass;
+  g_joinCount++;
+  Node &n = cur();
+  if (n.mode == WIFI_OFF)
+    setMode(n, WIFI_STA);
+  // The station scans every channel until it finds the AP; without one it
+  // keeps scanning until disconnect().
+  if (!ssid || g_apSsid.empty() || g_apSsid != ssid) {
+    n.status = WL_NO_SSID_AVAIL;
+    n.connectAtUs = 0;
+    startHop(n, kForever, n.channel);
+    return n.status;
+  }
+  n.status = WL_DISCONNECTED;
+  n.connectAtUs = nowUs() + (uint64_t)g_apJoinMs * 1000ULL;
+  startHop(n, n.connectAtUs, g_apChannel);
+  return n.status;
+}
+
+bool WiFiClass::disconnect(bool wifiOff, bool eraseAp) {
+  (void)eraseAp;
+  Node &n = cur();
+  stopHop(n);
+  n.status = WL_DISCONNECTED;
+  n.connectAtUs = 0;
+  if (wifiOff)
+    setMode(n, WIFI_OFF);
+  return true;
+}
+
+wl_status_t WiFiClass::status() {
+  settle(cur());
+  return cur().status;
+}
+
+bool WiFiClass::setSleep(bool enable) {
+  cur().sleep = enable;
+  return true;
+}
+
+uint8_t WiFiClass::channel() const {
+  uint8_t ch = channelOf(cur());
+  return ch ? ch : cur().channel;
+}
+
+bool WiFiClass::softAP(const char *ssid, const char *pass) {
+  (void)ssid;
+  (void)pass;
+  if (cur().mode == WIFI_OFF)
+    setMode(cur(), WIFI_AP);
+  return true;
+}
+
+int16_t WiFiClass::scanNetworks() { return g_apSsid.empty() ? 0 : 1; }
+
+String WiFiClass::SSID(uint8_t i) const {
+  return i == 0 ? String(g_apSsid) : String();
+}
+
+int32_t WiFiClass::RSSI(uint8_t i) const { return i == 0 ? -55 : 0; }
+
+wifi_auth_mode_t WiFiClass::encryptionType(uint8_t i) const {
+  (void)i;
+  return WIFI_AUTH_WPA2_PSK;
+}
@@ -0,0 +1,602 @@
+/**
+ * @file TFT_eSPI.cpp
+ * @brief Host implementation of the TFT_eSPI stand-in.
+ */
+
+#include <LittleFS.h>
+#include <TFT_eSPI.h>
+#include <chrono>
+#include <cstring>
+
+namespace {
+bool g_touchPressed = false;
+uint16_t g_touchX = 0;
+uint16_t g_touchY = 0;
+
+TFT_eSPI::HostStats g_stats;
+size_t g_spriteLimit = 0; ///< Largest sprite createSprite() grants.
+int g_driverDepth = 0; ///< Nesting of timed driver calls.
+
+/**
+ * @brief Times the outermost panel driver call into HostStats::driverNs.
+ * With the bus model on, that wall time is taken off the clock, which is
+ * charged the modelled bus time instead.
+ */
+class DriverTimer {
+public:
+  explicit DriverTimer(bool panel) : _panel(panel) {
+    if (_panel && g_driverDepth++ == 0)
+      _t0 = std::chrono::steady_clock::now();
+  }
+  ~DriverTimer();
+
+private:
+  bool _panel;
+  std::chrono::steady_clock::time_point _t0;
+};
+
+// --- Panel bus model (see TFT_eSPI::hostSetBusModel()) ---
+uint32_t g_busHz = 0;      ///< SPI clock; 0 = transfers take no time.
+uint32_t g_busFixedNs = 0; ///< Fixed cost of each transfer.
+uint64_t g_busFreeNs = 0;  ///< Host clock (ns) at which the bus is idle.
+
+uint64_t busNowNs() { return host::nowMicros() * 1000; }
+
+/// @brief Stalls the caller until the last transfer has finished.
+void busWait() {
+  uint64_t now = busNowNs();
+  if (!g_busHz || g_busFreeNs <= now)
+    return;
+  uint64_t us = (g_busFreeNs - now + 999) / 1000;
+  g_stats.busStallNs += us * 1000;
+  host::advanceMicros(us);
+}
+
+/**
+ * @brief Puts @p pixels on the bus after the previous transfer; a blocking
+ * transfer returns once they are out, a DMA one right away.
+ */
+void busTransfer(uint64_t pixels, bool dma) {
+  if (!g_busHz)
+    return;
+  busWait();
+  uint64_t ns = g_busFixedNs + pixels * 16 * 1000000000ULL / g_busHz;
+  g_stats.busNs += ns;
+  g_busFreeNs = busNowNs() + ns;
+  if (!dma)
+    busWait();
+}
+
+DriverTimer::~DriverTimer() {
+  if (!_panel || --g_driverDepth != 0)
+    return;
+  uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _t0)
+                    .count();
+  g_stats.driverNs += ns;
+  if (g_busHz)
+    host::excludeWallTime(ns); // The modelled bus time replaces it.
+}
+
+inline uint16_t bswap16(uint16_t v) { return (uint16_t)((v << 8) | (v >> 8)); }
+
+uint32_t readBE32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | p[3];
+}
+} // namespace
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) : _width(w), _height(h) {
+  resetViewport();
+}
+
+TFT_eSPI::~TFT_eSPI() = default;
+
+void TFT_eSPI::init(uint8_t tc) {
+  (void)tc;
+  resize(_width, _height);
+}
+
+void TFT_eSPI::setRotation(uint8_t r) {
+  int16_t shortSide = std::min<int16_t>(TFT_WIDTH, TFT_HEIGHT);
+  int16_t longSide = std::max<int16_t>(TFT_WIDTH, TFT_HEIGHT);
+  if (r & 1)
+    resize(longSide, shortSide);
+  else
+    resize(shortSide, longSide);
+}
+
+void TFT_eSPI::resize(int16_t w, int16_t h) {
+  _width = w;
+  _height = h;
+  _fb.assign((size_t)w * h, TFT_BLACK);
+  resetViewport();
+}
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h,
+                           bool vpDatum) {
+  _vpX0 = std::max<int32_t>(x, 0);
+  _vpY0 = std::max<int32_t>(y, 0);
+  _vpX1 = std::min<int32_t>(x + w, _width);
+  _vpY1 = std::min<int32_t>(y + h, _height);
+  _vpDatum = vpDatum;
+  _xDatum = vpDatum ? x : 0;
+  _yDatum = vpDatum ? y : 0;
+}
+
+void TFT_eSPI::resetViewport() {
+  _vpX0 = _vpY0 = 0;
+  _vpX1 = _width;
+  _vpY1 = _height;
+  _vpDatum = false;
+  _xDatum = _yDatum = 0;
+}
+
+bool TFT_eSPI::checkViewport(int32_t x, int32_t y, int32_t w, int32_t h) {
+  x += _xDatum;
+  y += _yDatum;
+  return x < _vpX1 && y < _vpY1 && x + w > _vpX0 && y + h > _vpY0;
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) const {
+  if (x < 0 || y < 0 || x >= _width || y >= _height || _fb.empty())
+    return 0;
+  return stored(_fb[(size_t)y * _width + x]); // Swapping is its own inverse.
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  x += _xDatum;
+  y += _yDatum;
+  if (x < _vpX0 || y < _vpY0 || x >= _vpX1 || y >= _vpY1 || _fb.empty())
+    return;
+  if (_panel) {
+    completeDMA();
+    busTransfer(1, false);
+    g_stats.pixels++;
+  }
+  _fb[(size_t)y * _width + x] = stored((uint16_t)color);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h,
+                        uint32_t color) {
+  x += _xDatum;
+  y += _yDatum;
+  int32_t x0 = std::max<int32_t>(x, _vpX0), y0 = std::max<int32_t>(y, _vpY0);
+  int32_t x1 = std::min<int32_t>(x + w, _vpX1);
+  int32_t y1 = std::min<int32_t>(y + h, _vpY1);
+  if (_fb.empty() || x1 <= x0 || y1 <= y0)
+    return;
+  DriverTimer timer(_panel);
+  if (_panel) {
+    completeDMA();
+    busTransfer((uint64_t)(x1 - x0) * (y1 - y0), false);
+    g_stats.fillCalls++;
+    g_stats.pixels += (uint64_t)(x1 - x0) * (y1 - y0);
+  }
+  uint16_t c = stored((uint16_t)color);
+  for (int32_t row = y0; row < y1; row++)
+    std::fill(_fb.begin() + (size_t)row * _width + x0,
+              _fb.begin() + (size_t)row * _width + x1, c);
+}
+
+void TFT_eSPI::blit(int32_t x, int32_t y, int32_t w, int32_t h,
+                    const uint16_t *data, bool swap, bool useTransparent,
+                    uint16_t transparent) {
+  if (!data || _fb.empty())
+    return;
+  DriverTimer timer(_panel);
+  if (_panel)
+    completeDMA();
+  x += _xDatum;
+  y += _yDatum;
+  uint64_t written = 0;
+  for (int32_t row = 0; row < h; row++) {
+    int32_t dy = y + row;
+    if (dy < _vpY0 || dy >= _vpY1)
+      continue;
+    const uint16_t *src = data + (size_t)row * w;
+    uint16_t *dst = &_fb[(size_t)dy * _width];
+    for (int32_t col = 0; col < w; col++) {
+      int32_t dx = x + col;
+      if (dx < _vpX0 || dx >= _vpX1)
+        continue;
+      uint16_t c = swap ? src[col] : bswap16(src[col]);
+      if (useTransparent && c == transparent)
+        continue;
+      dst[dx] = stored(c);
+      written++;
+    }
+  }
+  if (_panel) {
+    busTransfer(written, false);
+    g_stats.pushImageCalls++;
+    g_stats.pixels += written;
+  }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                         uint16_t *data) {
+  blit(x, y, w, h, data, _swapBytes, false, 0);
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                         const uint16_t *data) {
+  blit(x, y, w, h, data, _swapBytes, false, 0);
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                         uint16_t *data, uint16_t transparent) {
+  blit(x, y, w, h, data, _swapBytes, true, transparent);
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h,
+                         const uint16_t *data, uint16_t transparent) {
+  blit(x, y, w, h, data, _swapBytes, true, transparent);
+}
+
+void TFT_eSPI::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+  if (_panel)
+    completeDMA();
+  _winX = x + _xDatum;
+  _winY = y + _yDatum;
+  _winW = w;
+  _winH = h;
+  _winPos = 0;
+}
+
+void TFT_eSPI::streamPixel(uint16_t color) {
+  if (_winW <= 0 || _winPos >= (uint32_t)_winW * _winH)
+    return; // The panel ignores data past the end of the window.
+  int32_t x = _winX + (int32_t)(_winPos % _winW);
+  int32_t y = _winY + (int32_t)(_winPos / _winW);
+  _winPos++;
+  if (x >= 0 && y >= 0 && x < _width && y < _height && !_fb.empty())
+    _fb[(size_t)y * _width + x] = stored(color);
+}
+
+void TFT_eSPI::pushPixels(const void *data, uint32_t len) {
+  DriverTimer timer(_panel);
+  if (_panel)
+    completeDMA();
+  const uint16_t *src = (const uint16_t *)data;
+  for (uint32_t i = 0; i < len; i++)
+    streamPixel(_swapBytes ? src[i] : bswap16(src[i]));
+  if (_panel) {
+    busTransfer(len, false);
+    g_stats.streamCalls++;
+    g_stats.pixels += len;
+  }
+}
+
+void TFT_eSPI::pushBlock(uint16_t color, uint32_t len) {
+  DriverTimer timer(_panel);
+  if (_panel)
+    completeDMA();
+  for (uint32_t i = 0; i < len; i++)
+    streamPixel(color);
+  if (_panel) {
+    busTransfer(len, false);
+    g_stats.streamCalls++;
+    g_stats.pixels += len;
+  }
+}
+
+bool TFT_eSPI::initDMA(bool ctrl_cs) {
+  (void)ctrl_cs;
+  _dmaReady = _panel;
+  return _dmaReady;
+}
+
+void TFT_eSPI::pushPixelsDMA(uint16_t *image, uint32_t len) {
+  if (!_dmaReady || !image || !len)
+    return;
+  DriverTimer timer(_panel);
+  completeDMA(); // The previous transfer has to finish first.
+  _dmaData = image;
+  _dmaLen = len;
+  _dmaSwap = _swapBytes;
+  busTransfer(len, true);
+  g_stats.dmaCalls++;
+  g_stats.pixels += len;
+}
+
+void TFT_eSPI::pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h,
+                            uint16_t *data, uint16_t *buffer) {
+  if (!_dmaReady || !data || w <= 0 || h <= 0)
+    return;
+  completeDMA();
+  if (buffer) {
+    std::memcpy(buffer, data, (size_t)w * h * sizeof(uint16_t));
+    data = buffer;
+  }
+  setAddrWindow(x, y, w, h);
+  pushPixelsDMA(data, (uint32_t)(w * h));
+}
+
+bool TFT_eSPI::dmaBusy() {
+  if (g_busHz && g_busFreeNs > busNowNs())
+    return true;
+  completeDMA();
+  return false;
+}
+
+void TFT_eSPI::dmaWait() { completeDMA(); }
+
+void TFT_eSPI::completeDMA() {
+  if (!_dmaLen)
+    return;
+  DriverTimer timer(_panel);
+  busWait();
+  const uint16_t *src = _dmaData;
+  uint32_t len = _dmaLen;
+  _dmaData = nullptr;
+  _dmaLen = 0;
+  for (uint32_t i = 0; i < len; i++)
+    streamPixel(_dmaSwap ? src[i] : bswap16(src[i]));
+}
+
+void TFT_eSPI::setTextColor(uint16_t fg, uint16_t bg, bool bgfill) {
+  (void)bgfill;
+  _textColor = fg;
+  _textBgColor = bg;
+}
+
+void TFT_eSPI::loadFont(String fontName, bool flash) {
+  (void)flash;
+  loadFont(fontName, LittleFS);
+}
+
+void TFT_eSPI::loadFont(String fontName, fs::FS &ffs) {
+  if (_fontLoaded)
+    unloadFont();
+  g_stats.fontLoads++;
+
+  String path = "/" + fontName + ".vlw";
+  File f = ffs.open(path.c_str(), "r");
+  if (!f)
+    return;
+
+  _fontData.resize(f.size());
+  f.read(_fontData.data(), _fontData.size());
+  f.close();
+  if (_fontData.size() < 24)
+    return;
+
+  const uint8_t *p = _fontData.data();
+  uint32_t count = readBE32(p);
+  _yAdvance = (uint16_t)readBE32(p + 8);
+  _ascent = (uint16_t)readBE32(p + 16);
+  _descent = (uint16_t)readBE32(p + 20);
+
+  size_t meta = 24;
+  uint32_t bitmap = 24 + count * 28;
+  if (bitmap > _fontData.size())
+    return;
+
+  _glyphs.clear();
+  _glyphs.reserve(count);
+  for (uint32_t i = 0; i < count; i++, meta += 28) {
+    Glyph g;
+    g.code = readBE32(p + meta);
+    g.height = (uint16_t)readBE32(p + meta + 4);
+    g.width = (uint16_t)readBE32(p + meta + 8);
+    g.xAdvance = (int16_t)readBE32(p + meta + 12);
+    g.dY = (int16_t)readBE32(p + meta + 16);
+    g.dX = (int8_t)readBE32(p + meta + 20);
+    g.bitmap = bitmap;
+    bitmap += (uint32_t)g.width * g.height;
+    // Same filters as the library: control codes and the no-break space
+    // carry bogus metrics and must not push every line down.
+    if (((g.code > 0x20 && g.code < 0x7F) || g.code > 0xA0) &&
+        g.dY > (int16_t)_ascent)
+      _ascent = g.dY;
+    if (((g.code > 0x20 && g.code < 0xA0 && g.code != 0x7F) ||
+         g.code > 0xFF) &&
+        (int)g.height - g.dY > (int)_descent)
+      _descent = g.height - g.dY;
+    _glyphs.push_back(g);
+  }
+  _spaceWidth = (_ascent + _descent) * 2 / 7;
+  gFont = {_yAdvance, _ascent, _descent};
+  _fontLoaded = true;
+}
+
+void TFT_eSPI::unloadFont() {
+  _fontData.clear();
+  _fontData.shrink_to_fit();
+  _glyphs.clear();
+  _glyphs.shrink_to_fit();
+  gFont = {0, 0, 0};
+  _fontLoaded = false;
+}
+
+const TFT_eSPI::Glyph *TFT_eSPI::findGlyph(uint32_t code) const {
+  for (const Glyph &g : _glyphs)
+    if (g.code == code)
+      return &g;
+  return nullptr;
+}
+
+uint32_t TFT_eSPI::decodeUTF8(const uint8_t *s, size_t &i, size_t len) {
+  uint8_t c = s[i++];
+  if (c < 0x80)
+    return c;
+  if ((c & 0xE0) == 0xC0 && i < len)
+    return ((c & 0x1F) << 6) | (s[i++] & 0x3F);
+  if ((c & 0xF0) == 0xE0 && i + 1 < len) {
+    uint32_t cp = ((c & 0x0F) << 12) | ((s[i] & 0x3F) << 6) | (s[i + 1] & 0x3F);
+    i += 2;
+    return cp;
+  }
+  return c;
+}
+
+uint16_t TFT_eSPI::alphaBlend(uint8_t alpha, uint16_t fg, uint16_t bg) {
+  uint32_t rxb = bg & 0xF81F;
+  rxb += ((fg & 0xF81F) - rxb) * (alpha >> 2) >> 6;
+  uint32_t xgx = bg & 0x07E0;
+  xgx += ((fg & 0x07E0) - xgx) * alpha >> 8;
+  return (uint16_t)((rxb & 0xF81F) | (xgx & 0x07E0));
+}
+
+int16_t TFT_eSPI::fontHeight() const { return _fontLoaded ? _yAdvance : 8; }
+
+int16_t TFT_eSPI::textWidth(const char *s) {
+  if (!s)
+    return 0;
+  size_t len = std::strlen(s);
+  if (!_fontLoaded)
+    return (int16_t)(len * 6);
+  // Library rule: the last glyph counts with its ink, not its advance.
+  int32_t w = 0;
+  size_t i = 0;
+  while (i < len) {
+    uint32_t code = decodeUTF8((const uint8_t *)s, i, len);
+    const Glyph *g = code == 0x20 ? nullptr : findGlyph(code);
+    if (!g) {
+      w += code == 0x20 ? _spaceWidth : _spaceWidth + 1;
+      continue;
+    }
+    if (w == 0 && g->dX < 0)
+      w -= g->dX;
+    w += i < len ? g->xAdvance : g->dX + g->width;
+  }
+  return (int16_t)w;
+}
+
+void TFT_eSPI::drawGlyph(const Glyph &g, int32_t x, int32_t y) {
+  const uint8_t *bmp = _fontData.data() + g.bitmap;
+  int32_t top = y + _ascent - g.dY;
+  int32_t left = x + g.dX;
+  for (int32_t row = 0; row < g.height; row++) {
+    for (int32_t col = 0; col < g.width; col++) {
+      uint8_t a = bmp[row * g.width + col];
+      if (!a)
+        continue;
+      drawPixel(left + col, top + row,
+                a == 255 ? _textColor
+                         : alphaBlend(a, _textColor, _textBgColor));
+    }
+  }
+}
+
+int16_t TFT_eSPI::drawString(const String &s, int32_t x, int32_t y,
+                             uint8_t font) {
+  return drawString(s.c_str(), x, y, font);
+}
+
+int16_t TFT_eSPI::drawString(const char *s, int32_t x, int32_t y,
+                             uint8_t font) {
+  (void)font;
+  if (!s)
+    return 0;
+  DriverTimer timer(_panel);
+  int16_t w = textWidth(s);
+  int16_t h = fontHeight();
+
+  switch (_textDatum) {
+  case TC_DATUM: x -= w / 2; break;
+  case TR_DATUM: x -= w; break;
+  case ML_DATUM: y -= h / 2; break;
+  case MC_DATUM: x -= w / 2; y -= h / 2; break;
+  case MR_DATUM: x -= w; y -= h / 2; break;
+  case BL_DATUM: y -= h; break;
+  case BC_DATUM: x -= w / 2; y -= h; break;
+  case BR_DATUM: x -= w; y -= h; break;
+  default: break;
+  }
+
+  if (!_fontLoaded) {
+    fillRect(x, y, w, h, _textBgColor);
+    return w;
+  }
+
+  size_t len = std::strlen(s);
+  size_t i = 0;
+  int32_t cx = x;
+  while (i < len) {
+    uint32_t code = decodeUTF8((const uint8_t *)s, i, len);
+    const Glyph *g = findGlyph(code);
+    if (!g) {
+      cx += code == 0x20 ? _spaceWidth : _spaceWidth + 1;
+      continue;
+    }
+    drawGlyph(*g, cx, y);
+    cx += g->xAdvance;
+  }
+  return w;
+}
+
+uint8_t TFT_eSPI::getTouch(uint16_t *x, uint16_t *y, uint16_t threshold) {
+  (void)threshold;
+  g_stats.touchReads++;
+  if (!g_touchPressed)
+    return 0;
+  *x = g_touchX;
+  *y = g_touchY;
+  return 1;
+}
+
+void TFT_eSPI::hostSetTouch(bool pressed, uint16_t x, uint16_t y) {
+  g_touchPressed = pressed;
+  g_touchX = x;
+  g_touchY = y;
+}
+
+const TFT_eSPI::HostStats &TFT_eSPI::hostStats() { return g_stats; }
+
+void TFT_eSPI::hostResetStats() { g_stats = HostStats(); }
+
+void TFT_eSPI::hostSetSpriteLimit(size_t bytes) { g_spriteLimit = bytes; }
+
+void TFT_eSPI::hostSetBusModel(uint32_t spiHz, uint32_t transferNs) {
+  g_busHz = spiHz;
+  g_busFixedNs = transferNs;
+  g_busFreeNs = 0;
+}
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI *tft) : TFT_eSPI(0, 0), _parent(tft) {
+  _panel = false;
+}
+
+void *TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t frames) {
+  (void)frames;
+  if (_created)
+    return _fb.data();
+  if (g_spriteLimit && (size_t)w * h * sizeof(uint16_t) > g_spriteLimit)
+    return nullptr;
+  resize(w, h);
+  _created = true;
+  return _fb.data();
+}
+
+void TFT_eSprite::deleteSprite() {
+  _fb.clear();
+  _fb.shrink_to_fit();
+  _width = _height = 0;
+  _created = false;
+}
+
+void *TFT_eSprite::setColorDepth(int8_t b) {
+  (void)b;
+  return _created ? _fb.data() : nullptr;
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+  if (!_created || !_parent)
+    return;
+  bool swap = _parent->getSwapBytes();
+  _parent->setSwapBytes(false); // The buffer is in panel byte order.
+  _parent->pushImage(x, y, _width, _height, (const uint16_t *)_fb.data());
+  _parent->setSwapBytes(swap);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transparent) {
+  if (!_created || !_parent)
+    return;
+  bool swap = _parent->getSwapBytes();
+  _parent->setSwapBytes(false); // The buffer is in panel byte order.
+  _parent->pushImage(x, y, _width, _height, (const uint16_t *)_fb.data(),
+                     transparent);
+  _parent->setSwapBytes(swap);
+}
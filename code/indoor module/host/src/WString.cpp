@@ -0,0 +1,99 @@
+/**
+ * @file WString.cpp
+ * @brief Host implementation of the Arduino String stand-in.
+ */
+
+#include <WString.h>
+#include <cstdio>
+
+namespace {
+template <typename T> std::string toBase(T v, unsigned char base) {
+  if (base == 10)
+    return std::to_string(v);
+  if (base < 2 || base > 36)
+    base = 10;
+  bool neg = v < 0;
+  unsigned long long u =
+      neg ? (unsigned long long)(-(v + 1)) + 1 : (unsigned long long)v;
+  std::string out;
+  do {
+    unsigned d = (unsigned)(u % base);
+    out.insert(out.begin(), (char)(d < 10 ? '0' + d : 'a' + d - 10));
+    u /= base;
+  } while (u);
+  if (neg)
+    out.insert(out.begin(), '-');
+  return out;
+}
+
+std::string toDecimals(double v, unsigned int decimals) {
+  char buf[48];
+  std::snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+  return buf;
+}
+} // namespace
+
+String::String(unsigned char v, unsigned char base) : _s(toBase(v, base)) {}
+String::String(int v, unsigned char base) : _s(toBase(v, base)) {}
+String::String(unsigned int v, unsigned char base) : _s(toBase(v, base)) {}
+String::String(long v, unsigned char base) : _s(toBase(v, base)) {}
+String::String(unsigned long v, unsigned char base) : _s(toBase(v, base)) {}
+String::String(long long v, unsigned char base) : _s(toBase(v, base)) {}
+String::String(unsigned long long v, unsigned char base)
+    : _s(toBase(v, base)) {}
+String::String(float v, unsigned int decimals) : _s(toDecimals(v, decimals)) {}
+String::String(double v, unsigned int decimals)
+    : _s(toDecimals(v, decimals)) {}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to)
+    std::swap(from, to);
+  if (from >= _s.size())
+    return String();
+  return String(_s.substr(from, to - from));
+}
+
+int String::indexOf(char c, unsigned int from) const {
+  size_t p = _s.find(c, from);
+  return p == std::string::npos ? -1 : (int)p;
+}
+
+int String::indexOf(const char *s, unsigned int from) const {
+  size_t p = _s.find(s, from);
+  return p == std::string::npos ? -1 : (int)p;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t p = _s.rfind(c);
+  return p == std::string::npos ? -1 : (int)p;
+}
+
+bool String::endsWith(const String &suffix) const {
+  return _s.size() >= suffix._s.size() &&
+         _s.compare(_s.size() - suffix._s.size(), suffix._s.size(),
+                    suffix._s) == 0;
+}
+
+String operator+(const String &a, const String &b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+String operator+(const String &a, const char *b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+String operator+(const char *a, const String &b) {
+  String r(a);
+  r += b;
+  return r;
+}
+
+String operator+(const String &a, char b) {
+  String r(a);
+  r += b;
+  return r;
+}
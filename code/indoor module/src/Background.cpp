@@ -4,12 +4,17 @@
  */
 
 #include "Background.h"
+#include "Trace.h"
 #include <LittleFS.h>
 #include <TFT_eSPI.h>
 
-int Background::s_offX = 0;
-int Background::s_offY = 0;
-uint16_t Background::s_lineBuf[480];
+BandWriter *Background::s_band = nullptr;
+Rect Background::s_region = {0, 0, 0, 0};
+int32_t Background::s_imgX = 0;
+int32_t Background::s_imgY = 0;
+uint16_t Background::s_line[BAND_MAX_WIDTH];
+uint32_t Background::s_rowIndex[RLE565_MAX_HEIGHT];
+const Background *Background::s_rowIndexOf = nullptr;
 File Background::s_pngFile;
 TFT_eSPI *Background::s_tft = nullptr;
 PNG *Background::s_png = nullptr;
@@ -46,10 +51,28 @@ int32_t Background::pngSeek(PNGFILE *pFile, int32_t iPosition) {
 }
 
 int Background::pngDraw(PNGDRAW *p) {
-  s_png->getLineAsRGB565(p, s_lineBuf, PNG_RGB565_BIG_ENDIAN, 0xFFFFFFFF);
-  s_tft->pushImage(s_offX, s_offY + p->y, p->iWidth, 1, s_lineBuf);
+  if (s_band) {
+    s_png->getLineAsRGB565(p, s_band->row(), PNG_RGB565_BIG_ENDIAN,
+                           0xFFFFFFFF);
+    s_band->commit();
+    return 1;
+  }
+
+  // drawRegion(): keep only the rows and columns inside s_region.
+  int32_t row = s_imgY + p->y;
+  if (row >= s_region.bottom())
+    return 0; // Stop decoding.
+  if (row < s_region.y)
+    return 1;
+  int32_t x0 = max<int32_t>(s_region.x, s_imgX);
+  int32_t x1 = min<int32_t>(s_region.right(), s_imgX + p->iWidth);
+  if (x0 < x1) {
+    s_png->getLineAsRGB565(p, s_line, PNG_RGB565_BIG_ENDIAN, 0xFFFFFFFF);
+    s_tft->pushImage(x0, row, x1 - x0, 1, s_line + (x0 - s_imgX));
+  }
   return 1;
 }
+
 bool Background::drawPngFullScreen(const char *path, bool center) {
   if (!s_tft || !s_png) {
     return false;
@@ -60,24 +83,114 @@ bool Background::drawPngFullScreen(const char *path, bool center) {
     return false;
   }
 
-  s_offX = s_offY = 0;
+  int iw = s_png->getWidth();
+  int ih = s_png->getHeight();
+  if (iw > s_tft->width() || ih > s_tft->height()) {
+    Serial.printf("[BG] %s: %dx%d does not fit the panel\n", path, iw, ih);
+    s_png->close();
+    return false;
+  }
+
+  int x = 0, y = 0;
   if (center) {
-    int iw = s_png->getWidth();
-    int ih = s_png->getHeight();
-    if (iw < s_tft->width())
-      s_offX = (s_tft->width() - iw) / 2;
-    if (ih < s_tft->height())
-      s_offY = (s_tft->height() - ih) / 2;
+    x = (s_tft->width() - iw) / 2;
+    y = (s_tft->height() - ih) / 2;
   }
 
-  s_png->decode(NULL, 0);
+  {
+    TRACE_SCOPE(TRACE_PNG_DECODE);
+    // PNG_RGB565_BIG_ENDIAN rows are already in panel byte order.
+    BandWriter band(*s_tft, x, y, iw, ih, false);
+    s_band = &band;
+    s_png->decode(NULL, 0);
+    s_band = nullptr;
+  }
   s_png->close();
   return true;
 }
 
+bool Background::drawRleFullScreen(const char *path, bool center) {
+  s_rowIndexOf = nullptr;
+  Rle565Image img;
+  if (!img.open(path))
+    return false;
+
+  int x = 0, y = 0;
+  if (center) {
+    if (img.width() < s_tft->width())
+      x = (s_tft->width() - img.width()) / 2;
+    if (img.height() < s_tft->height())
+      y = (s_tft->height() - img.height()) / 2;
+  }
+  // Keep the row offsets, so drawRegion() can seek to the damaged rows.
+  bool indexed = img.height() <= RLE565_MAX_HEIGHT;
+  if (!img.drawToPanel(*s_tft, x, y, indexed ? s_rowIndex : nullptr))
+    return false;
+  if (indexed)
+    s_rowIndexOf = this;
+  return true;
+}
+
+bool Background::drawPngRegion(const char *path, const Rect &area,
+                               bool center) {
+  if (s_png->open(path, pngOpen, pngClose, pngRead, pngSeek, pngDraw) !=
+      PNG_SUCCESS) {
+    return false;
+  }
+
+  int iw = s_png->getWidth();
+  int ih = s_png->getHeight();
+  if (iw > BAND_MAX_WIDTH) {
+    s_png->close();
+    return false;
+  }
+  s_imgX = center ? (s_tft->width() - iw) / 2 : 0;
+  s_imgY = center ? (s_tft->height() - ih) / 2 : 0;
+  s_region = area;
+
+  {
+    TRACE_SCOPE(TRACE_PNG_DECODE);
+    // PNG_RGB565_BIG_ENDIAN rows are already in panel byte order.
+    bool swap = s_tft->getSwapBytes();
+    s_tft->setSwapBytes(false);
+    s_png->decode(NULL, 0);
+    s_tft->setSwapBytes(swap);
+  }
+  s_png->close();
+  return true;
+}
+
+bool Background::drawRleRegion(const char *path, const Rect &area,
+                               bool center) {
+  Rle565Image img;
+  if (!img.open(path))
+    return false;
+
+  int x = 0, y = 0;
+  if (center) {
+    if (img.width() < s_tft->width())
+      x = (s_tft->width() - img.width()) / 2;
+    if (img.height() < s_tft->height())
+      y = (s_tft->height() - img.height()) / 2;
+  }
+  return img.drawRegion(*s_tft, x, y, area.x, area.y, area.w, area.h,
+                        s_rowIndexOf == this ? s_rowIndex : nullptr);
+}
+
+bool Background::drawRegion(TFT_eSPI &tft, PNG &png, const Rect &area,
+                            bool center) {
+  s_tft = &tft;
+  s_png = &png;
+  if (drawRleRegion(Rle565Image::pathFor(_path).c_str(), area, center))
+    return true;
+  return drawPngRegion(_path.c_str(), area, center);
+}
+
 bool Background::draw(TFT_eSPI &tft, PNG &png, bool center) {
   s_tft = &tft;
   s_png = &png;
+  if (drawRleFullScreen(Rle565Image::pathFor(_path).c_str(), center))
+    return true;
   return drawPngFullScreen(_path.c_str(), center);
 }
 
@@ -90,17 +203,40 @@ void Background::listFS(const char *dir) {
     Serial.printf("%s (%uB)\n", f.name(), (unsigned)f.size());
 }
 
-void Background::addButton(const Button &btn) { _buttons.push_back(btn); }
+void Background::setLayout(const ScreenLayout &layout) {
+  _layout = &layout;
+  for (uint8_t i = 0; i < layout.widgetCount; i++)
+    addWidget(createWidget(layout.widgets[i]));
+}
 
-void Background::clearButtons() { _buttons.clear(); }
+bool Background::handleTouch(const TouchEvent &event) {
+  if (!_layout)
+    return false;
 
-bool Background::handleTouch(int16_t touchX, int16_t touchY,
-                             bool isPressedNow) {
-  bool anyClicked = false;
-  for (auto &b : _buttons) {
-    if (b.updateTouch(touchX, touchY, isPressedNow)) {
-      anyClicked = true;
-    }
+  ButtonCallback swipe = nullptr;
+  switch (event.gesture) {
+  case TOUCH_TAP:
+  case TOUCH_LONG_PRESS: {
+    int8_t i = _layout->grid->find(_layout->hits, event.x, event.y);
+    if (i < 0)
+      return false;
+    const HitArea &hit = _layout->hits[i];
+    hit.cb(hit.id, event.x, event.y);
+    return true;
   }
-  return anyClicked;
-}
\ No newline at end of file
+  case TOUCH_SWIPE_LEFT:
+    swipe = _layout->swipeLeft;
+    break;
+  case TOUCH_SWIPE_RIGHT:
+    swipe = _layout->swipeRight;
+    break;
+  default:
+    break;
+  }
+  if (!swipe)
+    return false;
+  swipe(0xFF, event.x, event.y);
+  return true;
+}
+
+void Background::addWidget(Widget *widget) { _widgets.push_back(widget); }
@@ -11,11 +11,16 @@
 #include <TFT_eSPI.h>
 #include <vector>
 
-#include "Button.h"
+#include "BandWriter.h"
+#include "Damage.h"
+#include "Layout.h"
+#include "Rle565.h"
+#include "TouchInput.h"
 
 /**
  * @class Background
- * @brief Handles loading background PNGs and managing associated touch buttons.
+ * @brief Handles loading background PNGs and the widgets and touch buttons
+ * of its screen.
  */
 class Background {
 public:
@@ -40,6 +45,9 @@ public:
   /**
    * @brief Draws the background image to the TFT screen.
    *
+   * Streams the pre-decoded .rle built from the PNG (see Rle565.h) when it
+   * exists, otherwise decodes the PNG itself.
+   *
    * @param tft Reference to the TFT object.
    * @param png Reference to the PNG decoder object.
    * @param center Whether to center the image on the screen (default: true).
@@ -47,6 +55,21 @@ public:
    */
   bool draw(TFT_eSPI &tft, PNG &png, bool center = true);
 
+  /**
+   * @brief Repaints only @p area of the background (e.g. under a widget
+   * that changed), from the .rle if it exists, otherwise from the PNG.
+   *
+   * Decoding stops after the last row of @p area.
+   *
+   * @param tft Reference to the TFT object.
+   * @param png Reference to the PNG decoder object.
+   * @param area Panel rectangle to repaint.
+   * @param center Must match the flag given to draw().
+   * @return true if drawing was successful, false otherwise.
+   */
+  bool drawRegion(TFT_eSPI &tft, PNG &png, const Rect &area,
+                  bool center = true);
+
   /**
    * @brief Lists files in a directory to Serial for debugging purposes.
    * @param dir Directory path to list (e.g., "/").
@@ -54,42 +77,49 @@ public:
   static void listFS(const char *dir);
 
   /**
-   * @brief Adds an interactive button region to this background.
-   * @param btn The Button object defining the hitbox and callback.
+   * @brief Creates the widgets of @p layout on this background and takes
+   * its buttons. @p layout must outlive the background.
    */
-  void addButton(const Button &btn);
+  void setLayout(const ScreenLayout &layout);
 
   /**
-   * @brief Removes all registered buttons from this background.
+   * @brief Dispatches a gesture to the layout.
+   *
+   * A tap or long press clicks the button under its last sample, looked up
+   * in the layout's TouchGrid; a horizontal swipe runs the layout's swipe
+   * action.
+   *
+   * @param event Gesture from TouchInput.
+   * @return true if a callback ran, false otherwise.
    */
-  void clearButtons();
+  bool handleTouch(const TouchEvent &event);
 
   /**
-   * @brief Processes touch input for all registered buttons.
-   *
-   * Iterates through all buttons added to this background and updates their
-   * state.
-   *
-   * @param touchX X-coordinate of the touch event.
-   * @param touchY Y-coordinate of the touch event.
-   * @param isPressedNow Current state of the touch (true=pressed,
-   * false=released).
-   * @return true if any button was clicked (action triggered), false otherwise.
+   * @brief Adds a widget drawn over this background, above the ones added
+   * before it. The widget must outlive the background.
    */
-  bool handleTouch(int16_t touchX, int16_t touchY, bool isPressedNow);
+  void addWidget(Widget *widget);
+
+  /// @brief Widgets of this screen, bottom to top.
+  const std::vector<Widget *> &widgets() const { return _widgets; }
 
 private:
-  String _path; ///< Path to the background image file.
-  std::vector<Button>
-      _buttons; ///< List of interactive buttons on this background.
+  String _path;                          ///< Path to the background image file.
+  const ScreenLayout *_layout = nullptr; ///< Buttons, or null.
+  std::vector<Widget *> _widgets;        ///< Screen contents in z-order.
 
   // --- Static members for PNGdec callbacks ---
   // These must be static because PNGdec requires C-style function pointers.
 
-  static int s_offX;              ///< X offset for centering the image.
-  static int s_offY;              ///< Y offset for centering the image.
-  static uint16_t s_lineBuf[480]; ///< Buffer for one line of decoded pixels.
-  static File s_pngFile;          ///< Handle to the open PNG file.
+  static BandWriter *s_band; ///< Bands the decoded rows go to.
+  static Rect s_region;      ///< Panel area drawRegion() repaints.
+  static int32_t s_imgX;     ///< Panel X of the image during drawRegion().
+  static int32_t s_imgY;     ///< Panel Y of the image during drawRegion().
+  static uint16_t s_line[BAND_MAX_WIDTH]; ///< Row for drawRegion().
+  /// Offset of each row in the .rle drawn last, for drawRegion().
+  static uint32_t s_rowIndex[RLE565_MAX_HEIGHT];
+  static const Background *s_rowIndexOf; ///< Owner of s_rowIndex, or null.
+  static File s_pngFile;     ///< Handle to the open PNG file.
   static TFT_eSPI *s_tft; ///< Pointer to the display driver used during draw.
   static PNG *s_png;      ///< Pointer to the PNG decoder instance.
 
@@ -107,4 +137,18 @@ private:
    * @return true on success.
    */
   bool drawPngFullScreen(const char *path, bool center);
+
+  /// @brief drawRegion() from the PNG.
+  bool drawPngRegion(const char *path, const Rect &area, bool center);
+
+  /// @brief drawRegion() from the .rle.
+  bool drawRleRegion(const char *path, const Rect &area, bool center);
+
+  /**
+   * @brief Streams a pre-decoded .rle image to the screen.
+   * @param path File path of the .rle.
+   * @param center Centering flag.
+   * @return false if the file is missing or invalid.
+   */
+  bool drawRleFullScreen(const char *path, bool center);
 };
\ No newline at end of file
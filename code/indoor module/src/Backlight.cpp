@@ -0,0 +1,121 @@
+/**
+ * @file Backlight.cpp
+ * @brief Implementation of the Backlight class.
+ */
+
+#include "Backlight.h"
+#include "Globals.h"
+
+Backlight::Backlight(uint8_t sensorPin, uint8_t ledPin)
+    : _sensorPin(sensorPin), _ledPin(ledPin) {}
+
+void Backlight::begin() {
+  ledc_timer_config_t timer = {};
+  timer.speed_mode = MODE;
+  timer.duty_resolution = LEDC_TIMER_8_BIT;
+  timer.timer_num = LEDC_TIMER_0;
+  timer.freq_hz = BACKLIGHT_PWM_HZ;
+  timer.clk_cfg = LEDC_AUTO_CLK;
+  ledc_timer_config(&timer);
+
+  _level = BACKLIGHT_MANUAL_LEVEL;
+  ledc_channel_config_t ch = {};
+  ch.gpio_num = _ledPin;
+  ch.speed_mode = MODE;
+  ch.channel = CHANNEL;
+  ch.intr_type = LEDC_INTR_DISABLE;
+  ch.timer_sel = LEDC_TIMER_0;
+  ch.duty = _level;
+  ledc_channel_config(&ch);
+  ledc_fade_func_install(0);
+
+  int8_t channel = digitalPinToAnalogChannel(_sensorPin);
+  if (channel < 0 || channel >= ADC1_CHANNEL_MAX) {
+    Serial.println("[BL] Light sensor is not on ADC1, auto level disabled");
+    return;
+  }
+  _channel = channel;
+
+  adc_digi_init_config_t init = {};
+  const uint32_t frameBytes =
+      BACKLIGHT_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES;
+  init.max_store_buf_size = 4 * frameBytes;
+  init.conv_num_each_intr = frameBytes;
+  init.adc1_chan_mask = 1 << _channel;
+  adc_digi_pattern_config_t pattern = {};
+  pattern.atten = ADC_ATTEN_DB_11;
+  pattern.channel = _channel;
+  pattern.unit = 0; // ADC1
+  pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+  adc_digi_configuration_t config = {};
+  config.conv_limit_en = true; // Required on the ESP32.
+  config.conv_limit_num = 250;
+  config.pattern_num = 1;
+  config.adc_pattern = &pattern;
+  config.sample_freq_hz = BACKLIGHT_SAMPLE_HZ;
+  config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+  esp_err_t err = adc_digi_initialize(&init);
+  if (err == ESP_OK)
+    err = adc_digi_controller_configure(&config);
+  if (err == ESP_OK)
+    err = adc_digi_start();
+  _adcRunning = err == ESP_OK;
+  if (!_adcRunning)
+    Serial.printf("[BL] ADC DMA start failed (%d)\n", err);
+}
+
+void Backlight::update() {
+  if (_adcRunning)
+    readSamples();
+
+  // A fade in flight is not retargeted; the next update picks up from it.
+  if ((int32_t)(millis() - _fadeEndMs) < 0)
+    return;
+  uint8_t level = target();
+  bool modeChanged = autoBrightness != _auto;
+  if (!modeChanged && abs((int)level - (int)_level) < BACKLIGHT_HYSTERESIS)
+    return;
+
+  _auto = autoBrightness;
+  _level = level;
+  ledc_set_fade_with_time(MODE, CHANNEL, level, BACKLIGHT_FADE_MS);
+  ledc_fade_start(MODE, CHANNEL, LEDC_FADE_NO_WAIT);
+  _fadeEndMs = millis() + BACKLIGHT_FADE_MS;
+}
+
+int16_t Backlight::ambient() const {
+  return _filtered < 0 ? -1 : (int16_t)(_filtered >> FILTER_FRAC);
+}
+
+void Backlight::readSamples() {
+  uint8_t buf[BACKLIGHT_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES];
+  uint32_t len = 0;
+  while (adc_digi_read_bytes(buf, sizeof(buf), &len, 0) == ESP_OK && len) {
+    uint32_t sum = 0, count = 0;
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len;
+         i += SOC_ADC_DIGI_RESULT_BYTES) {
+      const adc_digi_output_data_t *d =
+          reinterpret_cast<const adc_digi_output_data_t *>(buf + i);
+      if (d->type1.channel != _channel)
+        continue;
+      sum += d->type1.data;
+      count++;
+    }
+    if (count == 0)
+      continue;
+    int32_t mean = (int32_t)((sum << FILTER_FRAC) / count);
+    if (_filtered < 0)
+      _filtered = mean;
+    else
+      _filtered += (mean - _filtered) >> BACKLIGHT_FILTER_SHIFT;
+  }
+}
+
+uint8_t Backlight::target() const {
+  if (!autoBrightness || _filtered < 0)
+    return BACKLIGHT_MANUAL_LEVEL;
+  int level = (ambient() - 400) / 16;
+  return (uint8_t)constrain(level, BACKLIGHT_MIN_LEVEL, 255);
+}
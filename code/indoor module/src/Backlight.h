@@ -0,0 +1,53 @@
+/**
+ * @file Backlight.h
+ * @brief Ambient-light driven backlight on the ADC DMA and LEDC fader.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <driver/ledc.h>
+
+#include "Config.h"
+
+/**
+ * @class Backlight
+ * @brief Filters the light sensor and fades the TFT backlight to match.
+ */
+class Backlight {
+public:
+  Backlight(uint8_t sensorPin = FOTORESISTOR_PIN,
+            uint8_t ledPin = TFT_LED_PIN);
+
+  /// @brief Starts the ADC DMA and the LEDC channel at the manual level.
+  void begin();
+
+  /// @brief Filters new samples and fades to a new level if needed.
+  void update();
+
+  /// @brief Level the backlight is at or fading to (0-255).
+  uint8_t level() const { return _level; }
+
+  /// @brief Filtered sensor reading (12-bit), or -1 before the first one.
+  int16_t ambient() const;
+
+private:
+  static constexpr uint8_t FILTER_FRAC = 4; ///< Fraction bits of _filtered.
+  static constexpr ledc_mode_t MODE = LEDC_HIGH_SPEED_MODE;
+  static constexpr ledc_channel_t CHANNEL = LEDC_CHANNEL_0;
+
+  /// @brief Feeds all complete DMA frames through the filter.
+  void readSamples();
+
+  /// @brief Level for the current mode and filtered light.
+  uint8_t target() const;
+
+  uint8_t _sensorPin;       ///< Photoresistor (ADC1 pin).
+  uint8_t _ledPin;          ///< Backlight PWM output.
+  uint8_t _channel = 0;     ///< ADC1 channel of _sensorPin.
+  bool _adcRunning = false; ///< DMA sampling started.
+  int32_t _filtered = -1;   ///< Low-passed reading << FILTER_FRAC.
+  uint8_t _level = 0;       ///< Last fade target.
+  bool _auto = false;       ///< autoBrightness at the last fade.
+  uint32_t _fadeEndMs = 0;  ///< millis() when the running fade ends.
+};
@@ -0,0 +1,64 @@
+/**
+ * @file BandWriter.cpp
+ * @brief Implementation of the BandWriter class.
+ */
+
+#include "BandWriter.h"
+#include <esp_attr.h>
+
+// Internal DRAM, which the SPI DMA can read.
+DMA_ATTR uint16_t BandWriter::s_band[2][BG_BAND_LINES * BAND_MAX_WIDTH];
+uint8_t BandWriter::s_lines = BG_BAND_LINES;
+bool BandWriter::s_dma = true;
+bool BandWriter::s_dmaReady = false;
+
+void BandWriter::begin(TFT_eSPI &tft) {
+  s_dmaReady = tft.initDMA();
+  Serial.printf("[UI] Background bands: %u rows, DMA %s\n", BG_BAND_LINES,
+                s_dmaReady ? "on" : "unavailable");
+}
+
+void BandWriter::configure(uint8_t lines, bool dma) {
+  s_lines = constrain(lines, 1, BG_BAND_LINES);
+  s_dma = dma;
+}
+
+BandWriter::BandWriter(TFT_eSPI &tft, int32_t x, int32_t y, uint16_t width,
+                       uint16_t height, bool swap)
+    : _tft(tft), _width(min<uint16_t>(width, BAND_MAX_WIDTH)),
+      _swap(tft.getSwapBytes()) {
+  _tft.setSwapBytes(swap);
+  _tft.startWrite();
+  _tft.setAddrWindow(x, y, _width, height);
+}
+
+void BandWriter::commit() {
+  if (++_rows >= s_lines)
+    flush();
+}
+
+void BandWriter::flush() {
+  if (!_rows)
+    return;
+  uint32_t len = (uint32_t)_rows * _width;
+  if (s_dma && s_dmaReady) {
+    // The other buffer is refilled next; its transfer must be over.
+    _tft.dmaWait();
+    _tft.pushPixelsDMA(s_band[_buf], len);
+    _buf ^= 1;
+  } else {
+    _tft.pushPixels(s_band[_buf], len);
+  }
+  _rows = 0;
+}
+
+void BandWriter::finish() {
+  if (!_open)
+    return;
+  flush();
+  if (s_dmaReady)
+    _tft.dmaWait();
+  _tft.endWrite();
+  _tft.setSwapBytes(_swap);
+  _open = false;
+}
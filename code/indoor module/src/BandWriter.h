@@ -0,0 +1,64 @@
+/**
+ * @file BandWriter.h
+ * @brief Streams decoded image rows to the panel in double-buffered bands.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#include "Config.h"
+
+#define BAND_MAX_WIDTH 480 ///< Widest row a band holds (panel width).
+
+/**
+ * @class BandWriter
+ * @brief One image streamed into an address window, band by band.
+ *
+ * Uses static buffers (one image is drawn at a time, from the loop task).
+ */
+class BandWriter {
+public:
+  /// @brief Enables DMA on @p tft; call once after tft.init().
+  static void begin(TFT_eSPI &tft);
+
+  /**
+   * @brief Rows per band (1..BG_BAND_LINES) and whether full bands go out
+   * by DMA (only if begin() could enable it).
+   */
+  static void configure(uint8_t lines, bool dma);
+
+  /**
+   * @brief Opens the window (@p x, @p y, @p width x @p height), which must
+   * lie on the panel, for a transaction lasting until finish().
+   * @param swap true for native RGB565 rows, false for panel byte order.
+   */
+  BandWriter(TFT_eSPI &tft, int32_t x, int32_t y, uint16_t width,
+             uint16_t height, bool swap);
+  ~BandWriter() { finish(); }
+
+  /// @brief Buffer for the next row (width pixels).
+  uint16_t *row() { return s_band[_buf] + (size_t)_rows * _width; }
+
+  /// @brief Queues the row written into row().
+  void commit();
+
+  /// @brief Pushes the partial band, waits for the bus, ends the
+  /// transaction. Safe to call twice.
+  void finish();
+
+private:
+  void flush();
+
+  static uint16_t s_band[2][BG_BAND_LINES * BAND_MAX_WIDTH];
+  static uint8_t s_lines; ///< Rows per band.
+  static bool s_dma;      ///< Full bands go out by DMA.
+  static bool s_dmaReady; ///< initDMA() succeeded.
+
+  TFT_eSPI &_tft;    ///< Panel being written.
+  uint16_t _width;   ///< Row width.
+  uint8_t _buf = 0;  ///< Band being filled.
+  uint8_t _rows = 0; ///< Rows in it so far.
+  bool _swap;        ///< Byte order setting to restore.
+  bool _open = true; ///< Transaction not finished yet.
+};
@@ -0,0 +1,82 @@
+/**
+ * @file ClockScheduler.cpp
+ * @brief Implementation of the ClockScheduler class.
+ */
+
+#include "ClockScheduler.h"
+
+#include <esp_timer.h>
+
+ClockScheduler *ClockScheduler::s_instance = nullptr;
+
+ClockScheduler::ClockScheduler(RTC_DS3231 &rtc, SystemClock &clock,
+                               uint8_t intPin)
+    : _rtc(rtc), _clock(clock), _pin(intPin) {}
+
+void ClockScheduler::begin() {
+  s_instance = this;
+  pinMode(_pin, INPUT); // Open drain; the RTC module has the pull-up.
+
+  // INT/SQW carries alarms only while the square wave is off.
+  _rtc.disable32K();
+  _rtc.writeSqwPinMode(DS3231_OFF);
+  _rtc.disableAlarm(1);
+  _rtc.clearAlarm(1);
+  _rtc.clearAlarm(2);
+  _armed = _rtc.setAlarm2(_clock.now(), DS3231_A2_PerMinute);
+  if (_armed)
+    attachInterrupt(digitalPinToInterrupt(_pin), onAlarm, FALLING);
+  else
+    Serial.println("[CLK] RTC alarm unavailable, re-reading the RTC");
+
+  _lastSyncMs = millis();
+  now = _clock.now();
+  _minute = now.unixtime() / 60;
+}
+
+void IRAM_ATTR ClockScheduler::onAlarm() {
+  if (s_instance)
+    s_instance->_edges.push(esp_timer_get_time());
+}
+
+uint8_t ClockScheduler::poll() {
+  _clock.update();
+
+  int64_t edgeUs;
+  bool edge = false;
+  while (_edges.pop(edgeUs)) {
+    _clock.markMinute(edgeUs);
+    edge = true;
+  }
+  uint32_t ms = millis();
+  if (edge) {
+    _rtc.clearAlarm(2); // Releases INT for the next edge.
+    _lastSyncMs = ms;
+  } else if (ms - _lastSyncMs >=
+             (_armed ? 60000UL + CLOCK_ALARM_GRACE_MS : CLOCK_RTC_SYNC_MS)) {
+    // No alarm, or a missed one left INT low: clear it and re-read.
+    if (_armed)
+      _rtc.clearAlarm(2);
+    _clock.syncFromRtc();
+    _lastSyncMs = ms;
+  }
+
+  uint32_t minute = _clock.unixTime() / 60;
+  if (minute == _minute)
+    return 0;
+
+  DateTime last = now;
+  now = _clock.now();
+  _minute = minute;
+  uint8_t events = CLOCK_MINUTE;
+  if (now.day() != last.day() || now.month() != last.month() ||
+      now.year() != last.year())
+    events |= CLOCK_DAY;
+  return events;
+}
+
+uint32_t ClockScheduler::msUntilDue() const {
+  if (!_edges.empty())
+    return 0;
+  return _clock.msToNextMinute();
+}
@@ -0,0 +1,60 @@
+/**
+ * @file ClockScheduler.h
+ * @brief Wakes the clock redraw at minute and day boundaries.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <RTClib.h>
+
+#include "Config.h"
+#include "Globals.h"
+#include "SpscRing.h"
+#include "SystemClock.h"
+
+/**
+ * @enum ClockEvent
+ * @brief Boundaries reported by ClockScheduler::poll() (bit flags).
+ */
+enum ClockEvent : uint8_t {
+  CLOCK_MINUTE = 1 << 0, ///< The minute changed.
+  CLOCK_DAY = 1 << 1     ///< The date changed.
+};
+
+/**
+ * @class ClockScheduler
+ * @brief Owns the global `now` and reports when it crosses a boundary.
+ */
+class ClockScheduler {
+public:
+  ClockScheduler(RTC_DS3231 &rtc, SystemClock &clock,
+                 uint8_t intPin = RTC_INT_PIN);
+
+  /// @brief Arms the per-minute alarm; call after SystemClock::begin().
+  void begin();
+
+  /**
+   * @brief Cheap unless a boundary or an alarm is due; call once per loop.
+   * @return ClockEvent bits of the boundaries passed, usually 0.
+   */
+  uint8_t poll();
+
+  /// @brief Milliseconds until poll() next has work (idle/sleep budget).
+  uint32_t msUntilDue() const;
+
+  /// @brief True if the RTC alarm disciplines the clock.
+  bool alarmArmed() const { return _armed; }
+
+private:
+  static void IRAM_ATTR onAlarm();
+
+  static ClockScheduler *s_instance; ///< Target of onAlarm().
+
+  RTC_DS3231 &_rtc;            ///< Alarm source.
+  SystemClock &_clock;         ///< Time source.
+  uint8_t _pin;                ///< Input on the DS3231 INT/SQW pin.
+  bool _armed = false;         ///< Alarm 2 set up and its interrupt attached.
+  SpscRing<int64_t, 4> _edges; ///< esp_timer time of alarm edges.
+  uint32_t _lastSyncMs = 0;    ///< millis() of the last alarm or RTC read.
+  uint32_t _minute = 0;        ///< Unix minute `now` shows.
+};
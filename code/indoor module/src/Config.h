@@ -12,14 +12,79 @@
 #define I2C_SDA 25          ///< I2C SDA Pin
 #define I2C_SCL 26          ///< I2C SCL Pin
 #define TFT_LED_PIN 2       ///< TFT backlight control pin
+#define TOUCH_IRQ_PIN 27    ///< XPT2046 PENIRQ (low while touched)
+#define RTC_INT_PIN 34      ///< DS3231 INT/SQW (low on alarm, module pull-up)
+
+// --- Diagnostics ---
+#ifndef LOOP_PROFILER_ENABLED
+#define LOOP_PROFILER_ENABLED 1 ///< Per-stage loop latency histograms
+#endif
+#define PROFILER_DUMP_KEY 'p'   ///< Serial command: print profiler report
+#define PROFILER_RESET_KEY 'r'  ///< Serial command: clear diagnostics
+#define HEAP_DUMP_KEY 'h'       ///< Serial command: print heap tracker
+#define ICON_CACHE_DUMP_KEY 'i' ///< Serial command: print icon cache
 
 // --- Fonts ---
 #define EXTRA_SMALL_FONT_NAME "fonts/Lato-Regular-18"
 #define SMALL_FONT_NAME "fonts/Lato-Regular-24"
-#define TIME_FONT_NAME "fonts/Lato-Regular-92"
+// The clock has no font on LittleFS: its digits are the atlas in
+// src/ClockGlyphs.h, rendered from fonts/Lato-Regular-92.vlw at build time.
 #define MEDIUM_BOLD_FONT_NAME "fonts/Lato-Semibold-32"
 
+// --- Icon Cache ---
+#define ICON_CACHE_BUDGET_BYTES (64 * 1024) ///< Resident icon sprite RAM
+#define ICON_CACHE_MAX_ENTRIES 8            ///< Resident icons at most
+
+// --- Screen Layout ---
+#define SCREEN_WIDTH 480   ///< Panel width after setRotation(1)
+#define SCREEN_HEIGHT 320  ///< Panel height after setRotation(1)
+#define TOUCH_GRID_CELL 32 ///< Cell size of the touch hit-test grid (px)
+
+// --- Touch ---
+#define TOUCH_DEBOUNCE_MS 20    ///< Contact must hold/stay off this long
+#define TOUCH_LONG_PRESS_MS 600 ///< Hold time of a long press
+#define TOUCH_SWIPE_MIN_PX 60   ///< Travel that makes a release a swipe
+
+// --- Clock ---
+#define CLOCK_ALARM_GRACE_MS 1500  ///< Re-read the RTC if its alarm is late
+#define CLOCK_RTC_SYNC_MS 600000UL ///< RTC re-read interval without alarm
+#define LOCAL_TZ "CET-1CEST,M3.5.0,M10.5.0/3" ///< POSIX TZ of the RTC's time
+
+// --- Backlight ---
+#define BACKLIGHT_SAMPLE_HZ 20000   ///< Light sensor ADC DMA rate (ESP32 min)
+#define BACKLIGHT_FRAME_SAMPLES 256 ///< Samples averaged per filter step
+#define BACKLIGHT_FILTER_SHIFT 5    ///< Low-pass weight 1/2^n per step
+#define BACKLIGHT_HYSTERESIS 8      ///< Level change (of 255) worth a fade
+#define BACKLIGHT_FADE_MS 400       ///< LEDC hardware fade time
+#define BACKLIGHT_PWM_HZ 5000       ///< Backlight PWM frequency
+#define BACKLIGHT_MIN_LEVEL 70      ///< Darkest automatic level
+#define BACKLIGHT_MANUAL_LEVEL 220  ///< Level with auto brightness off
+
+// --- Indoor Sensor ---
+#define DS18B20_RESOLUTION 12         ///< Bits: 9..12 = 94..750 ms conversion
+#define INDOOR_TEMP_INTERVAL_MS 10000 ///< Start a conversion this often
+#define MAX_TEMP_PROBES 4             ///< DS18B20s read on ONE_WIRE_BUS
+
+// --- Sensor Snapshot ---
+// Oldest cached reading each consumer takes as current; an older indoor
+// temperature starts a conversion, an older outdoor payload counts as lost.
+#define INDOOR_MAX_AGE_UI_MS 30000       ///< Home screen indoor temperature
+#define INDOOR_MAX_AGE_PUBLISH_MS 30000  ///< Indoor temperature sent to AWS
+#define OUTDOOR_MAX_AGE_UI_MS 120000     ///< Link icon goes red after this
+#define OUTDOOR_MAX_AGE_PUBLISH_MS 60000 ///< Outdoor payload sent to AWS
+
+// --- ESP-NOW ---
+#define ESPNOW_RX_RING 8    ///< Frames queued for loop() (power of two)
+#define ESPNOW_FRAME_MAX 32 ///< Longest payload kept; longer ones dropped
+#define MAX_OUTDOOR_NODES 4 ///< Stations tracked by MAC (power of two)
+
+// --- MQTT Session ---
+#define NET_PERSISTENT_SESSION 1    ///< Stay on WiFi+MQTT (0 = join per reading)
+#define NET_RECONNECT_MIN_MS 5000   ///< First retry after the session drops
+#define NET_RECONNECT_MAX_MS 300000 ///< Retry interval ceiling (doubling)
+
 // --- Background Images ---
+#define BG_BAND_LINES 8 ///< Rows per DMA band (two 480 px wide bands resident)
 #define BG_HOME_PATH "/images/main_screen-min.png"
 #define BG_SETTINGS_PATH "/images/settings_screen-min.png"
 #define BG_ACCOUNT_PATH "/images/app-connecting-screen-min.png"
@@ -29,8 +94,20 @@ const char *const AWS_ENDPOINT =
     "an7hi8lzvqru3-ats.iot.eu-north-1.amazonaws.com";
 const int AWS_PORT = 8883;
 const char *const CLIENT_ID = "station-001";
+// Readings go to [users/<owner>/]stations/<THING_NAME>/data for the first
+// outdoor node heard, as before multi-node support, and to
+// .../nodes/<mac>/data for every further node.
 const char *const THING_NAME = "station-001";
 
+// --- TLS Credentials ---
+// Read once on the first connection and kept resident (see connectAWS()).
+// RSA and ECDSA device certificates both work; the ECC root lets the broker
+// pick an ECDSA chain for itself too.
+#define TLS_CA_PATH "/certs/AmazonRootCA1.pem"     ///< RSA root, required
+#define TLS_CA_ECC_PATH "/certs/AmazonRootCA3.pem" ///< ECC root, optional
+#define TLS_CERT_PATH "/certs/certificate.pem.crt" ///< Device certificate
+#define TLS_KEY_PATH "/certs/private.pem.key"      ///< Device private key
+
 // --- Application States ---
 /**
  * @enum SCREEN
@@ -0,0 +1,73 @@
+/**
+ * @file Damage.cpp
+ * @brief Implementation of the damage tracking helpers.
+ */
+
+#include "Damage.h"
+
+Rect Rect::united(const Rect &o) const {
+  if (o.empty())
+    return *this;
+  if (empty())
+    return o;
+  int16_t x0 = min(x, o.x), y0 = min(y, o.y);
+  int32_t x1 = max(right(), o.right()), y1 = max(bottom(), o.bottom());
+  return {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+Rect Rect::intersected(const Rect &o) const {
+  if (!intersects(o))
+    return {0, 0, 0, 0};
+  int16_t x0 = max(x, o.x), y0 = max(y, o.y);
+  int32_t x1 = min(right(), o.right()), y1 = min(bottom(), o.bottom());
+  return {x0, y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+Rect TextDamage::update(const TextFace &face, const String &text, int16_t x,
+                        int16_t y, const Rect &bounds) {
+  if (unchanged(text))
+    return {0, 0, 0, 0};
+
+  int16_t fh = face.lineHeight();
+  int16_t margin = fh / 8 + 2; // Glyph overhang past the pen position.
+  int16_t width = face.textWidth(text.c_str());
+  int16_t left = x - width / 2;
+  Rect box = {(int16_t)(left - margin), (int16_t)(y - fh / 2 - 2),
+              (int16_t)(width + 2 * margin), (int16_t)(face.inkHeight() + 4)};
+
+  Rect damage;
+  if (!_valid) {
+    damage = box.united(bounds);
+  } else if (width != _width || box.y != _box.y) {
+    // Everything moves when the centred string changes width.
+    damage = box.united(_box);
+  } else {
+    // Same width: only the span between the common prefix and suffix moved.
+    unsigned len = text.length(), oldLen = _text.length();
+    unsigned pre = 0;
+    while (pre < len && pre < oldLen && text[pre] == _text[pre])
+      pre++;
+    while (pre > 0 && (text[pre] & 0xC0) == 0x80)
+      pre--; // Back to a UTF-8 character boundary.
+    unsigned suf = 0;
+    while (suf < len - pre && suf < oldLen - pre &&
+           text[len - 1 - suf] == _text[oldLen - 1 - suf])
+      suf++;
+    while (suf > 0 && (text[len - suf] & 0xC0) == 0x80)
+      suf--;
+
+    int32_t x0 = left + face.advance(text.c_str(), pre);
+    int32_t x1 = left + width;
+    if (suf)
+      x1 = max(left + face.advance(text.c_str(), len - suf),
+               left + face.advance(_text.c_str(), oldLen - suf));
+    damage = {(int16_t)(x0 - margin), box.y,
+              (int16_t)(x1 - x0 + 2 * margin), box.h};
+  }
+
+  _text = text;
+  _box = box;
+  _width = width;
+  _valid = true;
+  return damage;
+}
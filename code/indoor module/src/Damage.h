@@ -0,0 +1,88 @@
+/**
+ * @file Damage.h
+ * @brief Damage tracking for dynamic text drawn over an eraser image.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#include "TextFace.h"
+
+/**
+ * @struct Rect
+ * @brief Screen rectangle; empty when w or h is not positive.
+ */
+struct Rect {
+  int16_t x; ///< Left edge.
+  int16_t y; ///< Top edge.
+  int16_t w; ///< Width.
+  int16_t h; ///< Height.
+
+  constexpr bool empty() const { return w <= 0 || h <= 0; }
+  constexpr int32_t right() const { return x + w; }
+  constexpr int32_t bottom() const { return y + h; }
+  constexpr int32_t area() const { return empty() ? 0 : (int32_t)w * h; }
+
+  /// @brief True if the two rectangles share at least one pixel.
+  constexpr bool intersects(const Rect &o) const {
+    return !empty() && !o.empty() && x < o.right() && o.x < right() &&
+           y < o.bottom() && o.y < bottom();
+  }
+
+  /// @brief True if every pixel of @p o lies inside this rectangle.
+  constexpr bool contains(const Rect &o) const {
+    return !o.empty() && o.x >= x && o.y >= y && o.right() <= right() &&
+           o.bottom() <= bottom();
+  }
+
+  /// @brief Smallest rectangle containing both (empty ones are ignored).
+  Rect united(const Rect &o) const;
+
+  /// @brief The part shared with @p o (empty if none).
+  Rect intersected(const Rect &o) const;
+};
+
+/**
+ * @class TextDamage
+ * @brief Tracks one string drawn with MC_DATUM in a smooth font.
+ */
+class TextDamage {
+public:
+  /**
+   * @brief Records @p text as drawn and returns the area to redraw.
+   *
+   * After invalidate() the whole @p bounds (the eraser) plus the text is
+   * damaged.
+   *
+   * @param face Font the text is drawn with.
+   * @param text New string.
+   * @param x Anchor X (MC_DATUM).
+   * @param y Anchor Y (MC_DATUM).
+   * @param bounds Rectangle of the eraser image under the text.
+   * @return Damaged rectangle, empty if @p text was already on screen.
+   */
+  Rect update(const TextFace &face, const String &text, int16_t x, int16_t y,
+              const Rect &bounds);
+
+  /// @brief Area the string on screen may have inked (empty if none).
+  const Rect &box() const { return _box; }
+
+  /// @brief String on screen (valid after update()).
+  const String &text() const { return _text; }
+
+  /// @brief True if @p text is what is on screen.
+  bool unchanged(const String &text) const { return _valid && text == _text; }
+
+  /// @brief Forgets the drawn text (the screen under it was repainted).
+  void invalidate() {
+    _valid = false;
+    _box = {0, 0, 0, 0};
+  }
+
+private:
+  String _text;             ///< String on screen.
+  Rect _box = {0, 0, 0, 0}; ///< Area it may have inked.
+  int16_t _width = 0;       ///< Its textWidth().
+  bool _valid = false;      ///< _text is on screen.
+};
@@ -0,0 +1,63 @@
+/**
+ * @file GlyphAtlas.cpp
+ * @brief Implementation of the GlyphAtlas class.
+ */
+
+#include "GlyphAtlas.h"
+
+const AtlasGlyph *GlyphAtlas::find(char c) const {
+  for (uint8_t i = 0; i < _font.count; i++)
+    if (_font.glyphs[i].code == (uint8_t)c)
+      return &_font.glyphs[i];
+  return nullptr;
+}
+
+bool GlyphAtlas::covers(const String &s) const {
+  for (unsigned i = 0; i < s.length(); i++)
+    if (!find(s[i]))
+      return false;
+  return true;
+}
+
+int16_t GlyphAtlas::textWidth(const char *s) const {
+  int16_t w = 0;
+  for (; *s; s++) {
+    const AtlasGlyph *g = find(*s);
+    if (!g)
+      continue;
+    if (w == 0 && g->dX < 0)
+      w -= g->dX;
+    w += s[1] ? g->xAdvance : g->dX + g->width;
+  }
+  return w;
+}
+
+int16_t GlyphAtlas::advance(const char *s, unsigned bytes) const {
+  int16_t pen = 0;
+  for (unsigned i = 0; i < bytes && s[i]; i++)
+    if (const AtlasGlyph *g = find(s[i]))
+      pen += g->xAdvance;
+  return pen;
+}
+
+int16_t GlyphAtlas::inkHeight() const {
+  return max<int16_t>(_font.yAdvance, _font.maxAscent + _font.maxDescent);
+}
+
+void GlyphAtlas::drawCentred(TFT_eSPI &tft, const String &s, int32_t x,
+                             int32_t y) const {
+  int32_t pen = x - textWidth(s.c_str()) / 2;
+  int32_t top = y - _font.yAdvance / 2;
+
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(true); // Atlas pixels are native RGB565.
+  for (unsigned i = 0; i < s.length(); i++) {
+    const AtlasGlyph *g = find(s[i]);
+    if (!g)
+      continue;
+    tft.pushImage(pen + g->dX, top + _font.maxAscent - g->dY, g->width,
+                  g->height, _font.pixels + g->offset, _font.key);
+    pen += g->xAdvance;
+  }
+  tft.setSwapBytes(swap);
+}
@@ -0,0 +1,59 @@
+/**
+ * @file GlyphAtlas.h
+ * @brief Pre-rendered glyphs of a smooth font, drawn as keyed image blits.
+ *
+ * Generated at build time by tools/vlw2atlas.py.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "TextFace.h"
+
+/// @brief One glyph of an atlas (metrics as in the .vlw file).
+struct AtlasGlyph {
+  uint16_t code;    ///< Character (ASCII).
+  uint8_t width;    ///< Bitmap width.
+  uint8_t height;   ///< Bitmap height.
+  int16_t xAdvance; ///< Pen advance.
+  int8_t dX;        ///< Left offset from the pen.
+  int16_t dY;       ///< Top of the bitmap above the baseline.
+  uint32_t offset;  ///< First pixel in AtlasFont::pixels.
+};
+
+/// @brief A generated atlas (see tools/vlw2atlas.py).
+struct AtlasFont {
+  uint16_t yAdvance;        ///< Line height of the source font.
+  uint16_t maxAscent;       ///< Baseline offset from the line top.
+  uint16_t maxDescent;      ///< Deepest glyph of the source font.
+  uint16_t fg;              ///< Text colour the glyphs were rendered in.
+  uint16_t bg;              ///< Colour their edges were blended into.
+  uint16_t key;             ///< Transparent pixel value.
+  const AtlasGlyph *glyphs; ///< Glyph table.
+  uint8_t count;            ///< Entries in glyphs.
+  const uint16_t *pixels;   ///< RGB565 bitmaps (PROGMEM), native order.
+};
+
+/**
+ * @class GlyphAtlas
+ * @brief TextFace over an AtlasFont.
+ */
+class GlyphAtlas : public TextFace {
+public:
+  explicit GlyphAtlas(const AtlasFont &font) : _font(font) {}
+
+  /// @brief True if every character of @p s is in the atlas.
+  bool covers(const String &s) const;
+
+  int16_t textWidth(const char *s) const override;
+  int16_t advance(const char *s, unsigned bytes) const override;
+  int16_t lineHeight() const override { return _font.yAdvance; }
+  int16_t inkHeight() const override;
+  void drawCentred(TFT_eSPI &tft, const String &s, int32_t x,
+                   int32_t y) const override;
+
+private:
+  const AtlasGlyph *find(char c) const;
+
+  const AtlasFont &_font; ///< Generated glyph data.
+};
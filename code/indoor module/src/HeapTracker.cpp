@@ -0,0 +1,163 @@
+/**
+ * @file HeapTracker.cpp
+ * @brief Implementation of the heap tracker and the device allocator hooks.
+ */
+
+#include "HeapTracker.h"
+
+#ifdef METEO_HEAP_TRACK
+
+#include <Arduino.h>
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+HeapTracker heapTracker;
+
+namespace {
+const char *const kSiteNames[HEAP_SITE_COUNT] = {
+    "publishToAWS", "connectAWS", "drawDynamic", "drawClock", "Icon::load",
+};
+
+void *currentTask() {
+#ifdef ESP_PLATFORM
+  return xTaskGetCurrentTaskHandle();
+#else
+  return nullptr;
+#endif
+}
+} // namespace
+
+void heapTrackAlloc(size_t size) { heapTracker.noteAlloc(size); }
+
+void heapTrackFree(size_t size) { heapTracker.noteFree(size); }
+
+const char *HeapTracker::siteName(HeapSite site) { return kSiteNames[site]; }
+
+void HeapTracker::enter(HeapSite site) {
+  if (_depth == 0)
+    _task = currentTask();
+  if (_depth < MAX_DEPTH)
+    _stack[_depth] = {site, 0, 0, ESP.getMaxAllocHeap()};
+  _depth++;
+}
+
+void HeapTracker::exit() {
+  if (_depth == 0)
+    return;
+  _depth--;
+  if (_depth >= MAX_DEPTH)
+    return;
+  const Frame &f = _stack[_depth];
+  HeapSiteStats &s = _stats[f.site];
+  uint32_t largest = ESP.getMaxAllocHeap();
+  uint32_t freeHeap = ESP.getFreeHeap();
+  if (s.calls == 0 || largest < s.minLargestFree)
+    s.minLargestFree = largest;
+  if (s.calls == 0 || freeHeap < s.minFreeHeap)
+    s.minFreeHeap = freeHeap;
+  int32_t loss = (int32_t)f.largestFree - (int32_t)largest;
+  if (loss > s.worstBlockLoss)
+    s.worstBlockLoss = loss;
+  if (f.peak > s.peakLive)
+    s.peakLive = f.peak;
+  s.calls++;
+}
+
+void HeapTracker::noteAlloc(size_t size) {
+  if (_depth == 0 || currentTask() != _task)
+    return;
+  uint8_t n = _depth < MAX_DEPTH ? _depth : MAX_DEPTH;
+  for (uint8_t i = 0; i < n; i++) {
+    Frame &f = _stack[i];
+    HeapSiteStats &s = _stats[f.site];
+    s.allocs++;
+    s.bytes += size;
+    s.retained += (int64_t)size;
+    f.live += size;
+    if (f.live > f.peak)
+      f.peak = f.live;
+  }
+}
+
+void HeapTracker::noteFree(size_t size) {
+  if (_depth == 0 || currentTask() != _task)
+    return;
+  uint8_t n = _depth < MAX_DEPTH ? _depth : MAX_DEPTH;
+  for (uint8_t i = 0; i < n; i++) {
+    Frame &f = _stack[i];
+    HeapSiteStats &s = _stats[f.site];
+    s.frees++;
+    s.retained -= (int64_t)size;
+    // Blocks from before the scope may be freed inside it.
+    f.live = f.live > size ? f.live - size : 0;
+  }
+}
+
+void HeapTracker::dump() const {
+  Serial.printf("[HEAP] %-13s %6s %8s %9s %7s %9s %10s %8s %9s\n", "site",
+                "calls", "allocs/c", "bytes/c", "peak", "retained",
+                "minLargest", "minFree", "blockLoss");
+  for (uint8_t i = 0; i < HEAP_SITE_COUNT; i++) {
+    const HeapSiteStats &s = _stats[i];
+    if (s.calls == 0)
+      continue;
+    Serial.printf("[HEAP] %-13s %6lu %8.1f %9.0f %7lu %9lld %10lu %8lu %9ld\n",
+                  kSiteNames[i], (unsigned long)s.calls,
+                  (double)s.allocs / s.calls, (double)s.bytes / s.calls,
+                  (unsigned long)s.peakLive, (long long)s.retained,
+                  (unsigned long)s.minLargestFree,
+                  (unsigned long)s.minFreeHeap, (long)s.worstBlockLoss);
+  }
+}
+
+void HeapTracker::reset() { memset(_stats, 0, sizeof(_stats)); }
+
+#ifdef ESP_PLATFORM
+// Linked with -Wl,--wrap=malloc,... (env esp32doit-devkit-v1-heap): every
+// allocation in the image, including the core's String and operator new,
+// goes through these.
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size) {
+  void *p = __real_malloc(size);
+  if (p)
+    heapTrackAlloc(heap_caps_get_allocated_size(p));
+  return p;
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  void *p = __real_calloc(n, size);
+  if (p)
+    heapTrackAlloc(heap_caps_get_allocated_size(p));
+  return p;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  size_t old = ptr ? heap_caps_get_allocated_size(ptr) : 0;
+  void *p = __real_realloc(ptr, size);
+  if (p || size == 0) {
+    if (old)
+      heapTrackFree(old);
+    if (p)
+      heapTrackAlloc(heap_caps_get_allocated_size(p));
+  }
+  return p;
+}
+
+void __wrap_free(void *ptr) {
+  if (ptr)
+    heapTrackFree(heap_caps_get_allocated_size(ptr));
+  __real_free(ptr);
+}
+}
+#endif
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file HeapTracker.h
+ * @brief Debug-build allocation and fragmentation tracker for hot paths.
+ *
+ * Compiled out unless METEO_HEAP_TRACK is defined (see HeapTracker.cpp).
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @enum HeapSite
+ * @brief Tracked call sites.
+ */
+typedef enum : uint8_t {
+  HEAP_SITE_PUBLISH,      ///< NetworkManager::publishToAWS.
+  HEAP_SITE_CONNECT_AWS,  ///< NetworkManager::connectAWS.
+  HEAP_SITE_DRAW_DYNAMIC, ///< Home screen redraw after new sensor data.
+  HEAP_SITE_DRAW_CLOCK,   ///< Minute or status redraw (clock, icons).
+  HEAP_SITE_ICON_LOAD,    ///< Icon::loadFromFS.
+  HEAP_SITE_COUNT
+} HeapSite;
+
+/**
+ * @struct HeapSiteStats
+ * @brief Counters of one call site, accumulated over all its calls.
+ */
+struct HeapSiteStats {
+  uint32_t calls;          ///< Completed scopes.
+  uint32_t allocs;         ///< Allocations (realloc = free + alloc).
+  uint32_t frees;          ///< Frees.
+  uint64_t bytes;          ///< Bytes allocated.
+  uint32_t peakLive;       ///< Highest in-scope live bytes of one call.
+  int64_t retained;        ///< Bytes allocated but not freed inside.
+  uint32_t minLargestFree; ///< Smallest largest-free-block at scope exit.
+  uint32_t minFreeHeap;    ///< Smallest free heap at scope exit.
+  int32_t worstBlockLoss;  ///< Largest drop of the largest free block.
+};
+
+#ifdef METEO_HEAP_TRACK
+
+/// @brief Reports an allocation of @p size usable bytes.
+void heapTrackAlloc(size_t size);
+/// @brief Reports a free of @p size usable bytes.
+void heapTrackFree(size_t size);
+
+/**
+ * @class HeapTracker
+ * @brief Per-site allocation statistics.
+ */
+class HeapTracker {
+public:
+  void enter(HeapSite site);
+  void exit();
+
+  void noteAlloc(size_t size);
+  void noteFree(size_t size);
+
+  const HeapSiteStats &stats(HeapSite site) const { return _stats[site]; }
+  static const char *siteName(HeapSite site);
+
+  /// @brief Prints the per-site table to Serial.
+  void dump() const;
+  void reset();
+
+private:
+  static constexpr uint8_t MAX_DEPTH = 4;
+
+  struct Frame {
+    HeapSite site;
+    uint32_t live;        ///< Live bytes allocated in this call.
+    uint32_t peak;        ///< Peak of live.
+    uint32_t largestFree; ///< Largest free block at entry.
+  };
+
+  HeapSiteStats _stats[HEAP_SITE_COUNT] = {};
+  Frame _stack[MAX_DEPTH] = {};
+  uint8_t _depth = 0;
+  void *_task = nullptr; ///< Task that opened the outermost scope.
+};
+
+extern HeapTracker heapTracker;
+
+/**
+ * @class HeapTrackScope
+ * @brief Charges the enclosing block's allocations to a site.
+ */
+class HeapTrackScope {
+public:
+  explicit HeapTrackScope(HeapSite site) { heapTracker.enter(site); }
+  ~HeapTrackScope() { heapTracker.exit(); }
+};
+
+#define HEAP_CONCAT_(a, b) a##b
+#define HEAP_CONCAT(a, b) HEAP_CONCAT_(a, b)
+#define HEAP_TRACK_SCOPE(s) HeapTrackScope HEAP_CONCAT(_heapTrack, __LINE__)(s)
+
+#else
+
+#define HEAP_TRACK_SCOPE(s)                                                    \
+  do {                                                                         \
+  } while (0)
+
+#endif
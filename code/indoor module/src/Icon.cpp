@@ -1,4 +1,7 @@
 #include "Icon.h"
+#include "HeapTracker.h"
+#include "Rle565.h"
+#include "Trace.h"
 
 extern PNG png;
 Icon *Icon::_active = nullptr;
@@ -43,6 +46,46 @@ int32_t Icon::_pngSeek(PNGFILE *file, int32_t pos) {
   return pos;
 }
 
+/// @brief Two pixels of @p p as one word (any alignment).
+static inline uint32_t loadPair(const uint16_t *p) {
+  uint32_t w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+/// @brief True if either half of @p v is zero.
+static inline bool hasZeroHalf(uint32_t v) {
+  return ((v - 0x00010001u) & ~v & 0x80008000u) != 0;
+}
+
+uint16_t Icon::copyOpaqueSpans(uint16_t *dst, const uint16_t *src,
+                               uint16_t count, uint16_t key) {
+  const uint32_t keys = key | (uint32_t)key << 16;
+  uint16_t copied = 0;
+  uint16_t x = 0;
+  while (x < count) {
+    // Skip the transparent run, a pair at a time.
+    while (x + 1 < count && loadPair(src + x) == keys)
+      x += 2;
+    while (x < count && src[x] == key)
+      x++;
+    if (x == count)
+      break;
+
+    // Find the end of the opaque run: the first pair holding a key pixel.
+    uint16_t end = x + 1;
+    while (end + 1 < count && !hasZeroHalf(loadPair(src + end) ^ keys))
+      end += 2;
+    while (end < count && src[end] != key)
+      end++;
+
+    memcpy(dst + x, src + x, (end - x) * sizeof(uint16_t));
+    copied += end - x;
+    x = end;
+  }
+  return copied;
+}
+
 int Icon::_pngDrawToSprite(PNGDRAW *pDraw) {
   if (!_active)
     return 0;
@@ -55,24 +98,66 @@ int Icon::_pngDrawToSprite(PNGDRAW *pDraw) {
     return 0;
   }
 
-  png.getLineAsRGB565(pDraw, lineBuf, PNG_RGB565_LITTLE_ENDIAN, 0x0000);
+  // 16-bit sprites store pixels in panel byte order, so decode the row in
+  // that order and copy its opaque runs straight into the sprite buffer.
+  png.getLineAsRGB565(pDraw, lineBuf, PNG_RGB565_BIG_ENDIAN, 0x0000);
+  uint16_t key = (self->_transparent565 >> 8) | (self->_transparent565 << 8);
+  uint16_t *pixels = (uint16_t *)self->_sprite.getPointer();
+  copyOpaqueSpans(pixels + pDraw->y * self->_w, lineBuf, pDraw->iWidth, key);
 
-  for (int x = 0; x < pDraw->iWidth; x++) {
-    uint16_t c = lineBuf[x];
-    if (c != self->_transparent565) {
-      self->_sprite.drawPixel(x, pDraw->y, c);
-    }
+  return 1;
+}
+IconLoad Icon::loadFromRle(Rle565Image &img) {
+  // Transparency is baked into the skip runs; they must match our key.
+  if (!img.keyed() || img.key() != _transparent565) {
+    img.close();
+    return ICON_NO_IMAGE;
   }
 
-  return 1;
+  _w = img.width();
+  _h = img.height();
+  _sprite.setColorDepth(16);
+  if (!_sprite.createSprite(_w, _h)) {
+    Serial.println("[Icon] createSprite FAILED (RAM?)");
+    return ICON_NO_MEMORY;
+  }
+
+  if (!img.drawToSprite(_sprite)) {
+    _sprite.deleteSprite();
+    return ICON_NO_IMAGE; // Try the PNG.
+  }
+  return ICON_LOADED;
+}
+
+IconLoad Icon::loadFromFS() {
+  HEAP_TRACK_SCOPE(HEAP_SITE_ICON_LOAD);
+  Rle565Image img;
+  bool rle = img.open(Rle565Image::pathFor(_path).c_str());
+  IconLoad result = load(rle ? &img : nullptr);
+  img.close();
+  return result;
+}
+
+IconLoad Icon::loadFromFS(Rle565Image *rle) {
+  HEAP_TRACK_SCOPE(HEAP_SITE_ICON_LOAD);
+  return load(rle);
 }
-bool Icon::loadFromFS() {
 
+IconLoad Icon::load(Rle565Image *img) {
   if (_loaded) {
     _sprite.deleteSprite();
     _loaded = false;
   }
 
+  IconLoad rle = img ? loadFromRle(*img) : ICON_NO_IMAGE;
+  if (rle == ICON_LOADED) {
+    _loaded = true;
+    Serial.printf("[Icon] Loaded '%s' (%dx%d, rle)\n", _path.c_str(), _w, _h);
+    return ICON_LOADED;
+  }
+  if (rle == ICON_NO_MEMORY)
+    return ICON_NO_MEMORY; // The PNG needs the same sprite.
+
   Icon::_active = this;
 
   int res = png.open(_path.c_str(), Icon::_pngOpen, Icon::_pngClose,
@@ -82,7 +167,7 @@ bool Icon::loadFromFS() {
     Serial.printf("[Icon] PNG open failed for '%s' (err=%d)\n", _path.c_str(),
                   res);
     Icon::_active = nullptr;
-    return false;
+    return ICON_NO_IMAGE;
   }
 
   _w = png.getWidth();
@@ -94,11 +179,14 @@ bool Icon::loadFromFS() {
     Serial.println("[Icon] createSprite FAILED (RAM?)");
     png.close();
     Icon::_active = nullptr;
-    return false;
+    return ICON_NO_MEMORY;
   }
 
   _sprite.fillSprite(_transparent565);
-  png.decode(NULL, 0);
+  {
+    TRACE_SCOPE(TRACE_PNG_DECODE);
+    png.decode(NULL, 0);
+  }
   png.close();
 
   _loaded = true;
@@ -106,7 +194,7 @@ bool Icon::loadFromFS() {
 
   Serial.printf("[Icon] Loaded '%s' (%dx%d)\n", _path.c_str(), _w, _h);
 
-  return true;
+  return ICON_LOADED;
 }
 
 void Icon::draw(int16_t x, int16_t y, uint16_t bgColor) {
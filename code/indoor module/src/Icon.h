@@ -13,6 +13,17 @@
 #include <TFT_eSPI.h>
 
 extern PNG png;
+class Rle565Image;
+
+/**
+ * @enum IconLoad
+ * @brief Outcome of Icon::loadFromFS().
+ */
+enum IconLoad : uint8_t {
+  ICON_LOADED,   ///< Decoded into the sprite.
+  ICON_NO_IMAGE, ///< No usable .rle, and the PNG would not open.
+  ICON_NO_MEMORY ///< The sprite could not be allocated.
+};
 
 /**
  * @class Icon
@@ -33,9 +44,20 @@ public:
 
   /**
    * @brief Loads the PNG image from LittleFS into a sprite.
-   * @return true if loading was successful, false otherwise.
+   *
+   * Uses the pre-decoded .rle built from the PNG (see Rle565.h) when it
+   * exists and was keyed on this icon's transparent colour.
+   *
+   * @return ICON_LOADED, or why the icon is not loaded.
    */
-  bool loadFromFS();
+  IconLoad loadFromFS();
+
+  /**
+   * @brief loadFromFS() with the .rle already opened by the caller.
+   * @param rle The open .rle of this icon, or nullptr if it has none. It
+   * stays open after ICON_NO_MEMORY, so a retry decodes the same handle.
+   */
+  IconLoad loadFromFS(Rle565Image *rle);
 
   /**
    * @brief Draws the icon at the specified coordinates.
@@ -63,6 +85,24 @@ public:
    */
   int16_t height() const { return _h; }
 
+  /**
+   * @brief Gets the file path of the icon image.
+   * @return Path in LittleFS.
+   */
+  const String &path() const { return _path; }
+
+  /**
+   * @brief Copies the pixels of @p src that are not @p key into @p dst.
+   *
+   * Scans two pixels per 32-bit word, so a transparent stretch costs one
+   * compare per pair, and copies each opaque run with one memcpy(). Both
+   * rows and the key must be in the same byte order.
+   *
+   * @return Number of pixels copied.
+   */
+  static uint16_t copyOpaqueSpans(uint16_t *dst, const uint16_t *src,
+                                  uint16_t count, uint16_t key);
+
 private:
   static Icon *_active; ///< Pointer to the active Icon instance for callbacks.
 
@@ -73,6 +113,13 @@ private:
   static int32_t _pngSeek(PNGFILE *file, int32_t pos);
   static int _pngDrawToSprite(PNGDRAW *pDraw);
 
+  /// @brief loadFromFS() without the heap tracker scope.
+  IconLoad load(Rle565Image *rle);
+
+  /// @brief Decodes @p img, the open .rle variant of _path; ICON_NO_IMAGE
+  /// if it is not usable.
+  IconLoad loadFromRle(Rle565Image &img);
+
   static uint16_t rgb888To565(uint8_t r, uint8_t g, uint8_t b);
 
   TFT_eSPI *_tft;           ///< Pointer to the display driver.
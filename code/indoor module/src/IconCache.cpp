@@ -0,0 +1,124 @@
+/**
+ * @file IconCache.cpp
+ * @brief Implementation of the IconCache class.
+ */
+
+#include "IconCache.h"
+
+IconCache::IconCache(TFT_eSPI *tft, size_t budgetBytes, uint8_t maxEntries)
+    : _tft(tft), _budget(budgetBytes), _maxEntries(maxEntries) {
+  _entries.reserve(maxEntries);
+}
+
+IconCache::~IconCache() { clear(); }
+
+bool IconCache::draw(const char *path, int16_t x, int16_t y,
+                     uint16_t bgColor) {
+  for (Entry &e : _entries) {
+    if (e.icon->path() == path) {
+      _stats.hits++;
+      e.lastUse = ++_tick;
+      e.icon->draw(x, y, bgColor);
+      return true;
+    }
+  }
+
+  _stats.misses++;
+  // One open of the .rle serves the header check and the decode.
+  Rle565Image img;
+  bool rle = img.open(Rle565Image::pathFor(path).c_str());
+  if (rle && bgColor == TFT_BLACK && drawsUncached(img)) {
+    _stats.bypasses++;
+    return img.drawKeyed(*_tft, x, y, bgColor);
+  }
+
+  Icon *icon = load(path, rle ? &img : nullptr);
+  img.close();
+  if (!icon)
+    return false;
+  icon->draw(x, y, bgColor);
+
+  size_t bytes = (size_t)icon->width() * icon->height() * sizeof(uint16_t);
+  if (tooBig(bytes)) {
+    _stats.bypasses++;
+    delete icon;
+    return true;
+  }
+
+  makeRoom(bytes);
+  _entries.push_back({icon, bytes, ++_tick});
+  _bytes += bytes;
+  if (_bytes > _stats.peakBytes)
+    _stats.peakBytes = _bytes;
+  return true;
+}
+
+Icon *IconCache::load(const char *path, Rle565Image *rle) {
+  Icon *icon = new Icon(_tft, path, 0, 0, 0);
+  IconLoad result = icon->loadFromFS(rle);
+
+  // Out of RAM for the sprite: give back ours and retry once.
+  if (result == ICON_NO_MEMORY && !_entries.empty()) {
+    Serial.printf("[ICON] No RAM for '%s', flushing %u cached bytes\n", path,
+                  (unsigned)_bytes);
+    while (!_entries.empty())
+      evictLru();
+    result = icon->loadFromFS(rle);
+  }
+  if (result == ICON_LOADED)
+    return icon;
+  delete icon;
+  return nullptr;
+}
+
+bool IconCache::drawsUncached(const Rle565Image &img) const {
+  // Only a .rle Icon would use: keyed on black, as the sprite is.
+  size_t bytes = (size_t)img.width() * img.height() * sizeof(uint16_t);
+  return tooBig(bytes) && img.keyed() && img.key() == TFT_BLACK;
+}
+
+void IconCache::evictLru() {
+  auto lru = _entries.begin();
+  for (auto it = _entries.begin(); it != _entries.end(); ++it)
+    if (it->lastUse < lru->lastUse)
+      lru = it;
+  _bytes -= lru->bytes;
+  delete lru->icon;
+  _entries.erase(lru);
+  _stats.evictions++;
+}
+
+void IconCache::makeRoom(size_t bytes) {
+  while (!_entries.empty() &&
+         (_bytes + bytes > _budget || _entries.size() >= _maxEntries))
+    evictLru();
+}
+
+void IconCache::clear() {
+  for (Entry &e : _entries)
+    delete e.icon;
+  _entries.clear();
+  _bytes = 0;
+}
+
+void IconCache::resetStats() {
+  _stats = {};
+  _stats.peakBytes = _bytes;
+}
+
+void IconCache::dump() const {
+  uint32_t lookups = _stats.hits + _stats.misses;
+  Serial.printf("[ICON] hits %lu misses %lu (%.1f%% hit) evictions %lu "
+                "bypasses %lu\n",
+                (unsigned long)_stats.hits, (unsigned long)_stats.misses,
+                lookups ? 100.0 * _stats.hits / lookups : 0.0,
+                (unsigned long)_stats.evictions,
+                (unsigned long)_stats.bypasses);
+  Serial.printf("[ICON] resident %u/%u B (peak %u B), %u/%u entries\n",
+                (unsigned)_bytes, (unsigned)_budget,
+                (unsigned)_stats.peakBytes, (unsigned)_entries.size(),
+                (unsigned)_maxEntries);
+  for (const Entry &e : _entries)
+    Serial.printf("[ICON]   %-40s %6u B  last %lu\n", e.icon->path().c_str(),
+                  (unsigned)e.bytes, (unsigned long)e.lastUse);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file IconCache.h
+ * @brief Path-keyed cache of decoded icon sprites with an LRU RAM budget.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <vector>
+
+#include "Icon.h"
+#include "Rle565.h"
+
+/**
+ * @class IconCache
+ * @brief Resident icon sprites shared by all screens.
+ */
+class IconCache {
+public:
+  /// @brief Hit/miss and residency counters.
+  struct Stats {
+    uint32_t hits;      ///< Draws served from a resident sprite.
+    uint32_t misses;    ///< Draws that had to decode the image.
+    uint32_t evictions; ///< Sprites freed to make room.
+    uint32_t bypasses;  ///< Misses too large to keep resident.
+    size_t peakBytes;   ///< Highest resident sprite RAM.
+  };
+
+  /**
+   * @param tft Display the sprites are pushed to.
+   * @param budgetBytes Sprite RAM the cache may keep resident.
+   * @param maxEntries Resident icons at most.
+   */
+  IconCache(TFT_eSPI *tft, size_t budgetBytes, uint8_t maxEntries);
+  ~IconCache();
+
+  /**
+   * @brief Draws the icon at @p path (transparent key black), decoding it
+   * on a miss.
+   * @return false if the image could not be loaded.
+   */
+  bool draw(const char *path, int16_t x, int16_t y,
+            uint16_t bgColor = TFT_BLACK);
+
+  /// @brief Frees every resident sprite.
+  void clear();
+
+  size_t residentBytes() const { return _bytes; }
+  uint8_t residentCount() const { return (uint8_t)_entries.size(); }
+  const Stats &stats() const { return _stats; }
+  void resetStats();
+
+  /// @brief Prints counters and resident entries to Serial.
+  void dump() const;
+
+private:
+  struct Entry {
+    Icon *icon;       ///< Loaded icon (owns its sprite).
+    size_t bytes;     ///< Sprite RAM.
+    uint32_t lastUse; ///< _tick of the last draw.
+  };
+
+  /// @brief Decodes @p path into a new Icon from @p rle, its open .rle
+  /// (nullptr: none), or the PNG.
+  Icon *load(const char *path, Rle565Image *rle);
+  /// @brief True if the open @p img is to be drawn uncached.
+  bool drawsUncached(const Rle565Image &img) const;
+  bool tooBig(size_t bytes) const {
+    return bytes > _budget / 2 || _maxEntries == 0;
+  }
+  void evictLru();
+  void makeRoom(size_t bytes);
+
+  TFT_eSPI *_tft;              ///< Display the sprites are pushed to.
+  size_t _budget;              ///< Resident byte budget.
+  uint8_t _maxEntries;         ///< Resident entry limit.
+  std::vector<Entry> _entries; ///< Resident icons.
+  size_t _bytes = 0;           ///< Resident sprite RAM.
+  uint32_t _tick = 0;          ///< Draw counter for LRU order.
+  Stats _stats = {};
+};
@@ -0,0 +1,39 @@
+/**
+ * @file Layout.cpp
+ * @brief Runtime side of the screen layout tables.
+ */
+
+#include "Layout.h"
+
+int8_t TouchGrid::find(const HitArea *hits, int16_t tx, int16_t ty) const {
+  if (tx < 0 || ty < 0)
+    return -1;
+  int16_t c = tx / TOUCH_GRID_CELL, r = ty / TOUCH_GRID_CELL;
+  if (c >= COLS || r >= ROWS)
+    return -1;
+
+  for (uint8_t mask = cells[r][c]; mask; mask &= mask - 1) {
+    int8_t i = __builtin_ctz(mask);
+    if (hits[i].contains(tx, ty))
+      return i;
+  }
+  return -1;
+}
+
+Widget *createWidget(const WidgetDef &def) {
+  switch (def.kind) {
+  case WIDGET_LABEL:
+    if (def.source)
+      return new LabelWidget(def.rect.x, def.rect.y, def.font, def.fg,
+                             def.bg, def.source, def.atlas);
+    return new LabelWidget(def.rect.x, def.rect.y, def.font, def.fg, def.bg,
+                           def.text, def.visible);
+  case WIDGET_IMAGE:
+    return new ImageWidget(def.text, def.rect, def.opaque);
+  case WIDGET_SPRITE:
+    return new SpriteWidget(def.pixels, def.rect);
+  case WIDGET_ICON:
+    return new IconWidget(def.frames, def.frameCount, def.state, def.rect);
+  }
+  return nullptr;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file Layout.h
+ * @brief Compile-time description of the screens: widgets and touch areas.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "Config.h"
+#include "Damage.h"
+#include "Widget.h"
+
+/**
+ * @brief Callback function type for button events.
+ * @param id Button ID.
+ * @param x X-coordinate of the touch.
+ * @param y Y-coordinate of the touch.
+ */
+using ButtonCallback = void (*)(uint8_t id, int16_t x, int16_t y);
+
+/**
+ * @struct HitArea
+ * @brief A button: a touch rectangle and what a click on it does.
+ *
+ * The area is in getTouch() coordinates, which are not the panel's (Y runs
+ * the other way), and includes its right and bottom edge.
+ */
+struct HitArea {
+  uint8_t id;        ///< Button ID passed to the callback.
+  Rect area;         ///< Touch rectangle.
+  ButtonCallback cb; ///< Called on a tap or long press inside the area.
+
+  constexpr bool contains(int16_t tx, int16_t ty) const {
+    return tx >= area.x && tx <= area.right() && ty >= area.y &&
+           ty <= area.bottom();
+  }
+
+  constexpr bool overlaps(const HitArea &o) const {
+    return area.x <= o.area.right() && o.area.x <= area.right() &&
+           area.y <= o.area.bottom() && o.area.y <= area.bottom();
+  }
+};
+
+/**
+ * @struct TouchGrid
+ * @brief Which hit areas of a screen meet each TOUCH_GRID_CELL square.
+ */
+struct TouchGrid {
+  static constexpr int16_t COLS = SCREEN_WIDTH / TOUCH_GRID_CELL + 1;
+  static constexpr int16_t ROWS = SCREEN_HEIGHT / TOUCH_GRID_CELL + 1;
+  static constexpr uint8_t MAX_AREAS = 8; ///< Bits in a cell.
+
+  uint8_t cells[ROWS][COLS]; ///< Bit i set: hit area i meets the cell.
+
+  /**
+   * @brief Finds the hit area containing a touch.
+   * @param hits The areas the grid was made from.
+   * @return Index into @p hits, or -1 if none contains (@p tx, @p ty).
+   */
+  int8_t find(const HitArea *hits, int16_t tx, int16_t ty) const;
+};
+
+/// @brief Sorts @p hits into a TouchGrid (evaluated at compile time).
+template <size_t N>
+constexpr TouchGrid makeTouchGrid(const HitArea (&hits)[N]) {
+  static_assert(N <= TouchGrid::MAX_AREAS, "Too many hit areas for a cell");
+  TouchGrid grid = {};
+  for (size_t i = 0; i < N; i++) {
+    const Rect &a = hits[i].area;
+    int32_t c0 = a.x < 0 ? 0 : a.x / TOUCH_GRID_CELL;
+    int32_t r0 = a.y < 0 ? 0 : a.y / TOUCH_GRID_CELL;
+    int32_t c1 = a.right() / TOUCH_GRID_CELL;
+    int32_t r1 = a.bottom() / TOUCH_GRID_CELL;
+    for (int32_t r = r0; r <= r1 && r < TouchGrid::ROWS; r++)
+      for (int32_t c = c0; c <= c1 && c < TouchGrid::COLS; c++)
+        grid.cells[r][c] |= 1 << i;
+  }
+  return grid;
+}
+
+/**
+ * @enum WidgetKind
+ * @brief Widget class a WidgetDef stands for.
+ */
+enum WidgetKind : uint8_t {
+  WIDGET_LABEL,  ///< LabelWidget.
+  WIDGET_IMAGE,  ///< ImageWidget.
+  WIDGET_SPRITE, ///< SpriteWidget.
+  WIDGET_ICON    ///< IconWidget.
+};
+
+/**
+ * @struct WidgetDef
+ * @brief Constructor arguments of one widget; made with the layout::
+ * helpers below.
+ */
+struct WidgetDef {
+  WidgetKind kind;               ///< Widget class.
+  Rect rect;                     ///< Label: anchor (x, y); else bounds.
+  Rect opaque;                   ///< Image: opaque part, relative to rect.
+  const char *font;              ///< Label font.
+  uint16_t fg;                   ///< Label text colour.
+  uint16_t bg;                   ///< Label background colour.
+  const char *text;              ///< Label fixed text, or image path.
+  TextSource source;             ///< Bound label text.
+  Condition visible;             ///< Label visibility.
+  const GlyphAtlas *atlas;       ///< Label glyph atlas.
+  const uint16_t *pixels;        ///< Sprite bitmap.
+  const uint16_t *const *frames; ///< Icon bitmaps.
+  uint8_t frameCount;            ///< Entries in frames.
+  StateSource state;             ///< Icon frame selector.
+};
+
+/// @brief Creates the widget @p def describes.
+Widget *createWidget(const WidgetDef &def);
+
+/**
+ * @struct ScreenLayout
+ * @brief Everything on one screen apart from its background image.
+ */
+struct ScreenLayout {
+  const WidgetDef *widgets;  ///< Bottom to top.
+  uint8_t widgetCount;       ///< Entries in widgets.
+  const HitArea *hits;       ///< Buttons.
+  uint8_t hitCount;          ///< Entries in hits.
+  const TouchGrid *grid;     ///< makeTouchGrid(hits).
+  ButtonCallback swipeLeft;  ///< Right-to-left swipe, or null.
+  ButtonCallback swipeRight; ///< Left-to-right swipe, or null.
+};
+
+namespace layout {
+
+/// @brief Label with fixed @p text, shown while @p visible (if given).
+constexpr WidgetDef label(int16_t x, int16_t y, const char *font,
+                          uint16_t fg, uint16_t bg, const char *text,
+                          Condition visible = nullptr) {
+  return {WIDGET_LABEL, {x, y, 0, 0}, {0, 0, 0, 0}, font, fg, bg, text,
+          nullptr, visible, nullptr, nullptr, nullptr, 0, nullptr};
+}
+
+/// @brief Label showing @p source, from @p atlas when it covers the text
+/// or @p font is nullptr.
+constexpr WidgetDef label(int16_t x, int16_t y, const char *font,
+                          uint16_t fg, uint16_t bg, TextSource source,
+                          const GlyphAtlas *atlas = nullptr) {
+  return {WIDGET_LABEL, {x, y, 0, 0}, {0, 0, 0, 0}, font, fg, bg, nullptr,
+          source, nullptr, atlas, nullptr, nullptr, 0, nullptr};
+}
+
+/// @brief LittleFS image; see ImageWidget for @p opaque.
+constexpr WidgetDef image(const char *path, Rect bounds,
+                          Rect opaque = {0, 0, 0, 0}) {
+  return {WIDGET_IMAGE, bounds, opaque, nullptr, 0, 0, path, nullptr,
+          nullptr, nullptr, nullptr, nullptr, 0, nullptr};
+}
+
+/// @brief Fixed bitmap from flash.
+constexpr WidgetDef sprite(const uint16_t *pixels, Rect bounds) {
+  return {WIDGET_SPRITE, bounds, {0, 0, 0, 0}, nullptr, 0, 0, nullptr,
+          nullptr, nullptr, nullptr, pixels, nullptr, 0, nullptr};
+}
+
+/// @brief Status icon showing frames[@p state()].
+template <size_t N>
+constexpr WidgetDef icon(const uint16_t *const (&frames)[N],
+                         StateSource state, Rect bounds) {
+  return {WIDGET_ICON, bounds, {0, 0, 0, 0}, nullptr, 0, 0, nullptr,
+          nullptr, nullptr, nullptr, nullptr, frames, N, state};
+}
+
+/// @brief Builds a ScreenLayout from its tables and swipe actions.
+template <size_t W, size_t H>
+constexpr ScreenLayout screen(const WidgetDef (&widgets)[W],
+                              const HitArea (&hits)[H], const TouchGrid &grid,
+                              ButtonCallback swipeLeft = nullptr,
+                              ButtonCallback swipeRight = nullptr) {
+  return {widgets, W, hits, H, &grid, swipeLeft, swipeRight};
+}
+
+/// @brief True if every widget lies on the panel.
+template <size_t N>
+constexpr bool widgetsOnScreen(const WidgetDef (&defs)[N]) {
+  const Rect panel = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+  for (const WidgetDef &d : defs) {
+    if (d.kind == WIDGET_LABEL) {
+      if (d.rect.x < 0 || d.rect.x >= SCREEN_WIDTH || d.rect.y < 0 ||
+          d.rect.y >= SCREEN_HEIGHT)
+        return false;
+      continue;
+    }
+    if (!panel.contains(d.rect))
+      return false;
+    if (!d.opaque.empty() &&
+        !Rect{0, 0, d.rect.w, d.rect.h}.contains(d.opaque))
+      return false;
+  }
+  return true;
+}
+
+/// @brief True if the buttons have callbacks, unique IDs and no overlap.
+template <size_t N>
+constexpr bool hitAreasValid(const HitArea (&hits)[N]) {
+  for (size_t i = 0; i < N; i++) {
+    if (hits[i].area.empty() || !hits[i].cb)
+      return false;
+    for (size_t j = i + 1; j < N; j++)
+      if (hits[i].id == hits[j].id || hits[i].overlaps(hits[j]))
+        return false;
+  }
+  return true;
+}
+
+} // namespace layout
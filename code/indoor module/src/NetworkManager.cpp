@@ -4,16 +4,47 @@
  */
 
 #include "NetworkManager.h"
+#include "HeapTracker.h"
+#include "Profiler.h"
 #include "SensorManager.h"
+#include "SystemClock.h"
 
 static NetworkManager *netInstance = nullptr;
 
+// The IDF 4.4 ESP-NOW callback has no RSSI. The driver shows each ESP-NOW
+// frame to the promiscuous callback first (as a vendor action frame), in
+// the same WiFi task, so remember its sender and signal for the next one.
+static uint8_t s_sniffMac[6];
+static int8_t s_sniffRssi = 0;
+
+static void onPromiscuousRx(void *buf, wifi_promiscuous_pkt_type_t type) {
+  if (type != WIFI_PKT_MGMT)
+    return;
+  const wifi_promiscuous_pkt_t *pkt = (const wifi_promiscuous_pkt_t *)buf;
+  if (pkt->rx_ctrl.sig_len < 24 || pkt->payload[0] != 0xD0) // Action.
+    return;
+  memcpy(s_sniffMac, pkt->payload + 10, sizeof(s_sniffMac));
+  s_sniffRssi = pkt->rx_ctrl.rssi;
+}
+
 void OnDataRecvWrapper(const uint8_t *mac, const uint8_t *incomingData,
                        int len) {
-  memcpy(&Data, incomingData, sizeof(Data));
-  lastDataReceivedMs = millis();
-  newDataReceived = true;
-  screenDataDirty = true;
+  // Runs in the WiFi task: queue a copy for loop(), touch nothing shared.
+  NetworkManager *n = netInstance;
+  if (!n)
+    return;
+  n->_rxFrames++;
+  if (len < 0 || len > ESPNOW_FRAME_MAX) {
+    n->_rxOversize++;
+    return;
+  }
+  EspNowFrame f;
+  f.rxMs = millis();
+  memcpy(f.mac, mac, sizeof(f.mac));
+  f.rssi = memcmp(s_sniffMac, mac, sizeof(s_sniffMac)) == 0 ? s_sniffRssi : 0;
+  f.len = (uint8_t)len;
+  memcpy(f.data, incomingData, len);
+  n->_rx.push(f);
 }
 
 void mqttCallbackWrapper(char *topic, byte *payload, unsigned int len) {
@@ -46,34 +77,93 @@ void NetworkManager::begin() {
 
   if (!tryConnectSaved(1000)) {
     Serial.println("[NET] Started in Local Mode");
+  } else if (_persistent) {
+    startRssiSniffer();
   } else {
     WiFi.disconnect();
     initEspNow();
   }
 }
 
+void NetworkManager::setPersistentSession(bool persistent) {
+  if (_persistent == persistent)
+    return;
+  _persistent = persistent;
+  _retryAtMs = millis();
+  _retryDelayMs = NET_RECONNECT_MIN_MS;
+  if (!persistent && !_configPortalActive) {
+    client.disconnect();
+    WiFi.disconnect();
+    initEspNow();
+  }
+}
+
+bool NetworkManager::maintainSession() {
+  if (WiFi.status() == WL_CONNECTED && client.connected())
+    return true;
+  if (_configPortalActive || (int32_t)(millis() - _retryAtMs) < 0)
+    return false;
+
+  bool up = WiFi.status() == WL_CONNECTED;
+  if (!up) {
+    client.disconnect();
+    up = tryConnectSaved(3000);
+    if (up)
+      startRssiSniffer();
+    else
+      initEspNow();
+  }
+  up = up && connectAWS();
+  setConnectionGood(up);
+  if (up) {
+    Serial.println("[NET] Session up");
+    _retryDelayMs = NET_RECONNECT_MIN_MS;
+    return true;
+  }
+
+  Serial.printf("[NET] Session down, retry in %u s\n",
+                (unsigned)(_retryDelayMs / 1000));
+  _retryAtMs = millis() + _retryDelayMs;
+  _retryDelayMs = _retryDelayMs * 2 > NET_RECONNECT_MAX_MS
+                      ? NET_RECONNECT_MAX_MS
+                      : _retryDelayMs * 2;
+  return false;
+}
+
 void NetworkManager::loop() {
   if (WiFi.status() == WL_CONNECTED && client.connected()) {
+    PROFILE_SITE(PROFILE_SITE_MQTT_LOOP);
     client.loop();
   }
 
-  if (newDataReceived && !_sendingToAws) {
+  if (pollEspNow())
+    _publishPending = true;
+
+  if (_persistent) {
+    if (maintainSession() && _publishPending) {
+      _publishPending = false;
+      publishToAWS();
+      setConnectionGood(true);
+    }
+    showWifiState();
+    return;
+  }
+
+  // Readings queued during a publish go out together in the next one.
+  if (_publishPending && !_sendingToAws) {
     _sendingToAws = true;
-    newDataReceived = false;
+    _publishPending = false;
 
     if (tryConnectSaved(3000)) {
       if (connectAWS()) {
         publishToAWS();
         client.loop();
-        if (!connectionGood)
-          connectionGood = true;
+        setConnectionGood(true);
       } else {
-        if (connectionGood)
-          connectionGood = false;
+        setConnectionGood(false);
       }
     } else {
-      if (connectionGood)
-        connectionGood = false;
+      setConnectionGood(false);
     }
 
     if (!_configPortalActive) {
@@ -84,25 +174,107 @@ void NetworkManager::loop() {
     }
     _sendingToAws = false;
   }
+  showWifiState();
+}
+
+bool NetworkManager::pollEspNow() {
+  bool recorded = false;
+  EspNowFrame f;
+  while (_rx.pop(f)) {
+    // Only a sender whose frame decodes gets a station: other ESP-NOW
+    // traffic must not fill the table.
+    WireReading r;
+    WireStatus status = wireDecode(f.data, f.len, r);
+    if (status != WIRE_OK) {
+      Station *known = _sensorMgr->knownStation(f.mac);
+      if (status == WIRE_BAD_CRC) {
+        _rxCorrupt++;
+        if (known)
+          known->corrupt++;
+      } else {
+        _rxMalformed++;
+        if (known)
+          known->malformed++;
+      }
+      continue;
+    }
+    Station *st = _sensorMgr->station(f.mac);
+    if (!st) {
+      _rxUnknown++;
+      continue;
+    }
+    st->lastSeenMs = f.rxMs;
+    st->rssi = f.rssi;
+    if (r.version >= 2) {
+      int32_t lost = st->trackSeq(r.seq, r.flags & WIRE_FLAG_RESTART);
+      if (lost < 0)
+        continue;
+      if (lost > 0)
+        Serial.printf("[NET] %02x:%02x:%02x:%02x:%02x:%02x: %u reading(s) "
+                      "lost\n",
+                      st->mac[0], st->mac[1], st->mac[2], st->mac[3],
+                      st->mac[4], st->mac[5], (unsigned)lost);
+    }
+    _sensorMgr->recordOutdoor(*st, r.data, f.rxMs);
+    recorded = true;
+  }
+  if (recorded)
+    screenDataDirty = true;
+
+  uint32_t dropped = espNowDropped();
+  if (dropped != _rxDropsLogged) {
+    Serial.printf("[NET] ESP-NOW frames dropped: %u\n", (unsigned)dropped);
+    _rxDropsLogged = dropped;
+  }
+  return recorded;
+}
+
+void NetworkManager::setConnectionGood(bool good) {
+  if (connectionGood == good)
+    return;
+  connectionGood = good;
+  statusDirty = true;
+}
+
+void NetworkManager::showWifiState() {
+  bool wifi = WiFi.status() == WL_CONNECTED;
+  if (wifi == _wifiShown)
+    return;
+  _wifiShown = wifi;
+  statusDirty = true;
 }
 
 bool NetworkManager::initEspNow() {
+  PROFILE_SITE(PROFILE_SITE_ESPNOW_INIT);
   WiFi.mode(WIFI_STA);
   WiFi.disconnect();
   if (esp_now_init() != ESP_OK)
     return false;
   esp_now_register_recv_cb(OnDataRecvWrapper);
+  startRssiSniffer();
   return true;
 }
 
+void NetworkManager::startRssiSniffer() {
+  // Management frames only, for the RSSI of ESP-NOW senders.
+  const wifi_promiscuous_filter_t filter = {WIFI_PROMIS_FILTER_MASK_MGMT};
+  esp_wifi_set_promiscuous_filter(&filter);
+  esp_wifi_set_promiscuous_rx_cb(onPromiscuousRx);
+  esp_wifi_set_promiscuous(true);
+}
+
 bool NetworkManager::tryConnectSaved(unsigned timeoutMs) {
-  connectionGood = false;
+  PROFILE_SITE(PROFILE_SITE_WIFI_JOIN);
+  setConnectionGood(false);
   prefs.begin("net", true);
   String ssid = prefs.getString("ssid", "");
   String pass = prefs.getString("pass", "");
   prefs.end();
 
-  WiFi.mode(WIFI_AP_STA);
+  // The soft-AP stays up only while the config portal needs it: a
+  // persistent session would otherwise keep it beaconing.
+  esp_wifi_set_promiscuous(false);
+  WiFi.mode(_configPortalActive ? WIFI_AP_STA : WIFI_STA);
 
   if (ssid.isEmpty()) {
     esp_wifi_set_promiscuous(true);
@@ -119,7 +291,7 @@ bool NetworkManager::tryConnectSaved(unsigned timeoutMs) {
 
   if (WiFi.status() == WL_CONNECTED) {
     WiFi.setSleep(false);
-    connectionGood = true;
+    setConnectionGood(true);
     return true;
   } else {
     WiFi.disconnect();
@@ -130,17 +302,67 @@ bool NetworkManager::tryConnectSaved(unsigned timeoutMs) {
   }
 }
 
-String NetworkManager::loadFile(const char *path) {
-  File f = LittleFS.open(path, "r");
-  if (!f)
-    return String();
-  String s = f.readString();
-  f.close();
-  return s;
+/// @brief Reads the existing files of @p paths into one NUL-terminated
+/// new[] buffer, or null if the first one is missing or all are empty.
+static char *readFiles(std::initializer_list<const char *> paths) {
+  size_t total = 0;
+  for (const char *path : paths) {
+    if (LittleFS.exists(path))
+      total += LittleFS.open(path, "r").size();
+    else if (path == *paths.begin())
+      return nullptr;
+  }
+  if (!total)
+    return nullptr;
+
+  char *buf = new char[total + 1];
+  size_t len = 0;
+  for (const char *path : paths) {
+    if (!LittleFS.exists(path))
+      continue;
+    File f = LittleFS.open(path, "r");
+    len += f.read((uint8_t *)buf + len, total - len);
+  }
+  buf[len] = '\0';
+  return buf;
+}
+
+bool NetworkManager::loadCredentials() {
+  if (_tlsKey)
+    return true;
+  _tlsCa = readFiles({TLS_CA_PATH, TLS_CA_ECC_PATH});
+  _tlsCert = readFiles({TLS_CERT_PATH});
+  _tlsKey = readFiles({TLS_KEY_PATH});
+  if (!_tlsCa || !_tlsCert || !_tlsKey) {
+    Serial.println("[NET] TLS credentials missing");
+    forgetCredentials();
+    return false;
+  }
+  Serial.printf("[NET] TLS credentials loaded (%u B)\n",
+                (unsigned)(strlen(_tlsCa) + strlen(_tlsCert) +
+                           strlen(_tlsKey)));
+
+  net.setCACert(_tlsCa);
+  net.setCertificate(_tlsCert);
+  net.setPrivateKey(_tlsKey);
+  client.setServer(AWS_ENDPOINT, AWS_PORT);
+  client.setKeepAlive(60);
+  client.setSocketTimeout(2);
+  client.setCallback(mqttCallbackWrapper);
+  return true;
+}
+
+void NetworkManager::forgetCredentials() {
+  delete[] _tlsCa;
+  delete[] _tlsCert;
+  delete[] _tlsKey;
+  _tlsCa = _tlsCert = _tlsKey = nullptr;
 }
 
 bool NetworkManager::connectAWS() {
-  configTime(0, 0, "pool.ntp.org", "time.google.com");
+  PROFILE_SITE(PROFILE_SITE_CONNECT_AWS);
+  HEAP_TRACK_SCOPE(HEAP_SITE_CONNECT_AWS);
+  configTzTime(LOCAL_TZ, "pool.ntp.org", "time.google.com");
   time_t now = time(nullptr);
   int retries = 0;
   while (now < 1700000000 && retries < 5) {
@@ -151,49 +373,70 @@ bool NetworkManager::connectAWS() {
 
   if (client.connected())
     return true;
-
-  String ca = loadFile("/certs/AmazonRootCA1.pem");
-  String crt = loadFile("/certs/certificate.pem.crt");
-  String key = loadFile("/certs/private.pem.key");
-
-  if (ca.isEmpty() || crt.isEmpty() || key.isEmpty()) {
+  if (!loadCredentials())
     return false;
-  }
-
-  net.setCACert(ca.c_str());
-  net.setCertificate(crt.c_str());
-  net.setPrivateKey(key.c_str());
-  client.setServer(AWS_ENDPOINT, AWS_PORT);
-  client.setKeepAlive(60);
-  client.setSocketTimeout(2);
-  client.setCallback(mqttCallbackWrapper);
-
   return client.connect(CLIENT_ID);
 }
 
 void NetworkManager::publishToAWS() {
-  float indoorTemp = _sensorMgr->readIndoorTemp();
-  if (!isnan(indoorTemp)) {
-    homeTemperatureRead = indoorTemp;
+  PROFILE_SITE(PROFILE_SITE_PUBLISH);
+  HEAP_TRACK_SCOPE(HEAP_SITE_PUBLISH);
+  // The same cached readings the home screen shows.
+  SensorSnapshot s = _sensorMgr->read(SENSOR_CONSUMER_PUBLISH);
+
+  String indoorJson;
+  const Reading<float> &indoor = s.indoorTemp();
+  if (indoor.valid && !indoor.stale)
+    indoorJson = "\"indoorTemperatureRead\":" + String(indoor.value) + ",";
+  indoorJson += "\"probeTemperatures\":[";
+  for (uint8_t i = 0; i < s.tempCount; i++) {
+    const Reading<float> &t = s.temps[i];
+    if (i)
+      indoorJson += ",";
+    indoorJson += (t.valid && !t.stale) ? String(t.value) : String("null");
   }
-
-  DateTime rtcNow = rtc.now();
-  long long timestamp_ms = ((long long)rtcNow.unixtime() - 3600LL) * 1000LL;
-
-  String payload =
-      String("{\"indoorTemperatureRead\":") + String(homeTemperatureRead) +
-      ",\"humidityRead\":" + String(Data.humidityRead) +
-      ",\"outdoorTemperatureRead\":" + String(Data.outdoorTemperatureRead) +
-      ",\"pressureRead\":" + String(Data.pressureRead) +
-      ",\"uvIndexRead\":" + String(Data.uvIndexRead) +
-      ",\"ts\":" + String(timestamp_ms) + "}";
-
-  String topic = ownerIdentityId.length()
-                     ? "users/" + ownerIdentityId + "/stations/" +
-                           String(THING_NAME) + "/data"
-                     : String("stations/") + THING_NAME + "/data";
-
-  client.publish(topic.c_str(), payload.c_str());
+  indoorJson += "],";
+
+  String base = ownerIdentityId.length()
+                    ? "users/" + ownerIdentityId + "/stations/" +
+                          String(THING_NAME)
+                    : String("stations/") + THING_NAME;
+
+  // One message per station with a reading not sent yet.
+  uint8_t sent = 0;
+  for (uint8_t i = 0; i < s.stations.count(); i++) {
+    const Station &st = s.stations[i];
+    if (st.frames == _published[i])
+      continue;
+    _published[i] = st.frames;
+    if (!st.reading.valid || st.reading.stale)
+      continue;
+
+    const struct_message &out = st.reading.value;
+    long long timestamp_ms =
+        (long long)SystemClock::toUtc(st.reading.capturedAt) * 1000LL;
+    String payload = "{" + indoorJson;
+    payload += "\"humidityRead\":" + String(out.humidityRead) +
+               ",\"outdoorTemperatureRead\":" +
+               String(out.outdoorTemperatureRead) +
+               ",\"pressureRead\":" + String(out.pressureRead) +
+               ",\"uvIndexRead\":" + String(out.uvIndexRead) +
+               ",\"rssi\":" + String(st.rssi) +
+               ",\"ts\":" + String(timestamp_ms) + "}";
+    // The first node keeps the single-node topic existing rules read.
+    String topic = base;
+    if (i) {
+      char node[13];
+      snprintf(node, sizeof(node), "%02x%02x%02x%02x%02x%02x", st.mac[0],
+               st.mac[1], st.mac[2], st.mac[3], st.mac[4], st.mac[5]);
+      topic += String("/nodes/") + node;
+    }
+    topic += "/data";
+    client.publish(topic.c_str(), payload.c_str());
+    sent++;
+  }
+  if (!sent)
+    Serial.println("[NET] No recent outdoor reading, not publishing");
 }
 
 void NetworkManager::generateAppConnectionKey() {
@@ -205,6 +448,7 @@ void NetworkManager::generateAppConnectionKey() {
              (unsigned long)r2);
     AppConnectionKey = String(buf).substring(0, 8);
     appConnectionKeyReady = true;
+    statusDirty = true;
   }
 }
 
@@ -253,6 +497,7 @@ void NetworkManager::handleMqttMessage(char *topic, byte *payload,
     return;
 
   ownerIdentityId = String(id);
+  statusDirty = true;
   prefs.begin("claim", false);
   prefs.putString("ownerId", ownerIdentityId);
   prefs.end();
@@ -19,9 +19,22 @@
 
 #include "Config.h"
 #include "Globals.h"
+#include "SpscRing.h"
 
 class SensorManager;
 
+/**
+ * @struct EspNowFrame
+ * @brief One ESP-NOW packet, as the receive callback queued it.
+ */
+struct EspNowFrame {
+  uint32_t rxMs;                  ///< millis() at reception.
+  uint8_t mac[6];                 ///< Sender.
+  int8_t rssi;                    ///< Signal strength, dBm (0 = unknown).
+  uint8_t len;                    ///< Bytes used in data.
+  uint8_t data[ESPNOW_FRAME_MAX]; ///< Payload.
+};
+
 /**
  * @class NetworkManager
  * @brief Handles all network-related operations.
@@ -41,9 +54,22 @@ public:
 
   /**
    * @brief Main network loop handling MQTT and data transmission.
+   *
+   * In a persistent session the module stays associated and the MQTT
+   * connection stays open, ESP-NOW receiving on the AP's channel, so a
+   * reading costs one PUBLISH. A dropped session is re-established with a
+   * doubling back-off. Otherwise every reading joins WiFi, connects,
+   * publishes and leaves again.
    */
   void loop();
 
+  /// @brief Chooses the session mode (NET_PERSISTENT_SESSION at start-up).
+  void setPersistentSession(bool persistent);
+
+  /// @brief Drops the resident TLS credentials; the next connection reads
+  /// them from /certs again (after new ones were written there).
+  void forgetCredentials();
+
   /**
    * @brief Attempts to connect to saved WiFi credentials.
    * @param timeoutMs Connection timeout in milliseconds.
@@ -67,6 +93,26 @@ public:
    */
   bool initEspNow();
 
+  /**
+   * @brief Moves the frames the receive callback queued into the sensor
+   * snapshot, oldest first, and marks the home screen dirty.
+   *
+   * v1 and v2 frames are accepted (see MeteoWire.h). For v2 the sequence
+   * number drops retransmissions and counts lost readings per station.
+   * @return true if a reading was recorded.
+   */
+  bool pollEspNow();
+
+  /// @brief ESP-NOW frames received since start-up, dropped ones included.
+  uint32_t espNowFrames() const { return _rxFrames; }
+
+  /// @brief Frames lost to a full ring, oversize, a bad length or CRC, or
+  /// a full station table. Retransmissions are not counted.
+  uint32_t espNowDropped() const {
+    return _rx.dropped() + _rxOversize + _rxMalformed + _rxCorrupt +
+           _rxUnknown;
+  }
+
   bool isConfigPortalActive();
   bool isWifiConnected();
   bool isAwsConnected();
@@ -81,13 +127,46 @@ private:
 
   bool _configPortalActive = false;   ///< Flag indicating active portal.
   bool _sendingToAws = false;         ///< Flag for transmission state.
+  bool _publishPending = false;       ///< A reading is not published yet.
   bool appConnectionKeyReady = false; ///< Flag for nonce generation state.
+  bool _wifiShown = false;            ///< WiFi state the UI last saw.
+  bool _persistent = NET_PERSISTENT_SESSION; ///< See loop().
+  uint32_t _retryAtMs = 0;                    ///< Next session attempt.
+  uint32_t _retryDelayMs = NET_RECONNECT_MIN_MS; ///< Current back-off.
+
+  SpscRing<EspNowFrame, ESPNOW_RX_RING> _rx; ///< Callback -> loop().
+  volatile uint32_t _rxFrames = 0;           ///< Frames the callback saw.
+  volatile uint32_t _rxOversize = 0;         ///< Longer than EspNowFrame.
+  uint32_t _rxMalformed = 0;                 ///< Not a v1 or v2 frame.
+  uint32_t _rxCorrupt = 0;                   ///< v2 frames failing the CRC.
+  uint32_t _rxUnknown = 0;                   ///< Sender not in the table.
+  uint32_t _rxDropsLogged = 0;               ///< espNowDropped() last logged.
+  uint32_t _published[MAX_OUTDOOR_NODES] = {}; ///< Station::frames sent.
+
+  // WiFiClientSecure keeps the pointers and parses them on every connect.
+  char *_tlsCa = nullptr;   ///< Root CA bundle (PEM).
+  char *_tlsCert = nullptr; ///< Device certificate (PEM).
+  char *_tlsKey = nullptr;  ///< Device private key (PEM).
 
   bool connectAWS();
   void publishToAWS();
+  /// @brief Joins WiFi and connects MQTT if they are down and the back-off
+  /// allows; true if the session is up.
+  bool maintainSession();
+  /// @brief Reads per-frame RSSI through the promiscuous callback.
+  void startRssiSniffer();
+  /// @brief Updates connectionGood and flags the status icons on change.
+  void setConnectionGood(bool good);
+  /// @brief Flags the status icons when the WiFi link changed since the UI
+  /// last drew it.
+  void showWifiState();
   void generateAppConnectionKey();
-  String loadFile(const char *path);
+  /// @brief Reads the TLS credentials and hands them to the client, once;
+  /// true if they are resident.
+  bool loadCredentials();
   void handleMqttMessage(char *topic, byte *payload, unsigned int len);
 
   friend void mqttCallbackWrapper(char *topic, byte *payload, unsigned int len);
+  friend void OnDataRecvWrapper(const uint8_t *mac,
+                                const uint8_t *incomingData, int len);
 };
\ No newline at end of file
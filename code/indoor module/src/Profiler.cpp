@@ -0,0 +1,168 @@
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the loop profiler.
+ */
+
+#include "Profiler.h"
+
+LoopProfiler loopProfiler;
+
+namespace {
+const char *const kStageNames[PROFILE_STAGE_COUNT] = {"net", "sensor", "ui"};
+
+const char *const kSiteNames[PROFILE_SITE_COUNT] = {
+    "mqttLoop",     "tryConnectSaved", "connectAWS",  "publishToAWS",
+    "initEspNow",   "indoorTemp",      "rtcNow",      "backlight",
+    "touch",        "changeScreen",    "drawDynamic", "drawClock",
+};
+
+float toMs(uint32_t cycles) {
+  return cycles / (ESP.getCpuFreqMHz() * 1000.0f);
+}
+} // namespace
+
+// --- LatencyHistogram ---
+
+uint16_t LatencyHistogram::bucketOf(uint32_t cycles) {
+  if (cycles < (1u << SUB_BITS))
+    return (uint16_t)cycles;
+  uint8_t e = 31 - __builtin_clz(cycles);
+  uint8_t sub = (cycles >> (e - SUB_BITS)) & ((1u << SUB_BITS) - 1);
+  return (uint16_t)(((e - SUB_BITS + 1) << SUB_BITS) + sub);
+}
+
+uint32_t LatencyHistogram::bucketLow(uint16_t bucket) {
+  if (bucket < (1u << SUB_BITS))
+    return bucket;
+  uint8_t e = (bucket >> SUB_BITS) + SUB_BITS - 1;
+  uint32_t sub = bucket & ((1u << SUB_BITS) - 1);
+  return ((1u << SUB_BITS) + sub) << (e - SUB_BITS);
+}
+
+void LatencyHistogram::record(uint32_t cycles) {
+  uint16_t b = bucketOf(cycles);
+  if (_buckets[b] == UINT16_MAX) {
+    _count = 0;
+    for (uint16_t &n : _buckets) {
+      n >>= 1;
+      _count += n;
+    }
+  }
+  _buckets[b]++;
+  _count++;
+  if (cycles > _max)
+    _max = cycles;
+}
+
+void LatencyHistogram::reset() {
+  memset(_buckets, 0, sizeof(_buckets));
+  _count = 0;
+  _max = 0;
+}
+
+uint32_t LatencyHistogram::percentile(uint16_t permille) const {
+  if (_count == 0)
+    return 0;
+  uint32_t rank = (uint32_t)(((uint64_t)_count * permille + 999) / 1000);
+  if (rank == 0)
+    rank = 1;
+  uint32_t seen = 0;
+  for (uint16_t b = 0; b < BUCKETS; b++) {
+    seen += _buckets[b];
+    if (seen >= rank) {
+      uint32_t high = b + 1 < BUCKETS ? bucketLow(b + 1) - 1 : UINT32_MAX;
+      return min(high, _max);
+    }
+  }
+  return _max;
+}
+
+// --- LoopProfiler ---
+
+void LoopProfiler::beginStage(ProfileStage stage) {
+  _stage = stage;
+  _depth = 0;
+  memset(_current.siteCycles, 0, sizeof(_current.siteCycles));
+  _stageStart = cycles();
+}
+
+void LoopProfiler::endStage() {
+  if (_stage >= PROFILE_STAGE_COUNT)
+    return;
+  uint32_t elapsed = cycles() - _stageStart;
+  _hist[_stage].record(elapsed);
+  if (elapsed > _worst[_stage].cycles) {
+    _current.cycles = elapsed;
+    _current.atMs = millis();
+    _worst[_stage] = _current;
+  }
+  _stage = PROFILE_STAGE_COUNT;
+}
+
+void LoopProfiler::enterSite(ProfileSite site) {
+  if (_stage >= PROFILE_STAGE_COUNT)
+    return;
+  // Past MAX_DEPTH the time stays with the enclosing site.
+  if (_depth < MAX_DEPTH)
+    _stack[_depth] = {site, cycles(), 0};
+  _depth++;
+}
+
+void LoopProfiler::exitSite() {
+  if (_stage >= PROFILE_STAGE_COUNT || _depth == 0)
+    return;
+  _depth--;
+  if (_depth >= MAX_DEPTH)
+    return;
+  Frame &f = _stack[_depth];
+  uint32_t elapsed = cycles() - f.start;
+  _current.siteCycles[f.site] += elapsed - f.child;
+  if (_depth > 0)
+    _stack[_depth - 1].child += elapsed;
+}
+
+ProfileSite LoopProfiler::culprit(const Outlier &o) {
+  ProfileSite best = PROFILE_SITE_COUNT;
+  uint32_t bestCycles = o.cycles;
+  for (uint8_t s = 0; s < PROFILE_SITE_COUNT; s++)
+    bestCycles -= min(bestCycles, o.siteCycles[s]);
+  // bestCycles now holds the stage's own (unattributed) time.
+  for (uint8_t s = 0; s < PROFILE_SITE_COUNT; s++) {
+    if (o.siteCycles[s] > bestCycles) {
+      bestCycles = o.siteCycles[s];
+      best = (ProfileSite)s;
+    }
+  }
+  return best;
+}
+
+void LoopProfiler::dump() const {
+  Serial.printf("[PROF] %-7s %8s %10s %10s %10s\n", "stage", "count",
+                "p50_ms", "p99_ms", "max_ms");
+  for (uint8_t s = 0; s < PROFILE_STAGE_COUNT; s++) {
+    const LatencyHistogram &h = _hist[s];
+    Serial.printf("[PROF] %-7s %8lu %10.3f %10.3f %10.3f\n", kStageNames[s],
+                  (unsigned long)h.count(), toMs(h.percentile(500)),
+                  toMs(h.percentile(990)), toMs(h.max()));
+  }
+  for (uint8_t s = 0; s < PROFILE_STAGE_COUNT; s++) {
+    const Outlier &o = _worst[s];
+    if (o.cycles == 0)
+      continue;
+    ProfileSite c = culprit(o);
+    Serial.printf("[PROF] worst %s: %.3f ms at %lu ms, caused by %s\n",
+                  kStageNames[s], toMs(o.cycles), (unsigned long)o.atMs,
+                  c < PROFILE_SITE_COUNT ? kSiteNames[c] : "(stage body)");
+    for (uint8_t i = 0; i < PROFILE_SITE_COUNT; i++) {
+      if (o.siteCycles[i])
+        Serial.printf("[PROF]   %-16s %10.3f ms\n", kSiteNames[i],
+                      toMs(o.siteCycles[i]));
+    }
+  }
+}
+
+void LoopProfiler::reset() {
+  for (LatencyHistogram &h : _hist)
+    h.reset();
+  memset(_worst, 0, sizeof(_worst));
+}
@@ -0,0 +1,166 @@
+/**
+ * @file Profiler.h
+ * @brief Cycle-counter latency profiler for the stages of the main loop.
+ *
+ * Compiled out unless LOOP_PROFILER_ENABLED is set in Config.h.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "Config.h"
+
+/**
+ * @enum ProfileStage
+ * @brief Top-level stages of loop().
+ */
+typedef enum : uint8_t {
+  PROFILE_STAGE_NET,    ///< NetworkManager::loop.
+  PROFILE_STAGE_SENSOR, ///< SensorManager::update.
+  PROFILE_STAGE_UI,     ///< UIManager::update.
+  PROFILE_STAGE_COUNT
+} ProfileStage;
+
+/**
+ * @enum ProfileSite
+ * @brief Sub-calls that can stall a stage.
+ */
+typedef enum : uint8_t {
+  PROFILE_SITE_MQTT_LOOP,     ///< PubSubClient::loop.
+  PROFILE_SITE_WIFI_JOIN,     ///< NetworkManager::tryConnectSaved.
+  PROFILE_SITE_CONNECT_AWS,   ///< NetworkManager::connectAWS.
+  PROFILE_SITE_PUBLISH,       ///< NetworkManager::publishToAWS.
+  PROFILE_SITE_ESPNOW_INIT,   ///< NetworkManager::initEspNow.
+  PROFILE_SITE_INDOOR_TEMP,   ///< DS18B20 conversion start/read.
+  PROFILE_SITE_RTC_READ,      ///< RTC_DS3231::now.
+  PROFILE_SITE_BACKLIGHT,     ///< Brightness read and PWM write.
+  PROFILE_SITE_TOUCH,         ///< Touch poll and dispatch.
+  PROFILE_SITE_CHANGE_SCREEN, ///< UIManager::changeScreen.
+  PROFILE_SITE_DRAW_DYNAMIC,  ///< Home screen redraw after new sensor data.
+  PROFILE_SITE_DRAW_CLOCK,    ///< Minute or status redraw (clock, icons).
+  PROFILE_SITE_COUNT
+} ProfileSite;
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear histogram of cycle counts (8 sub-buckets per octave,
+ * <= 12.5 % bucket width).
+ *
+ * Counters are 16-bit; when one saturates all of them are halved, which keeps
+ * the shape of the distribution while bounding RAM to 480 bytes.
+ */
+class LatencyHistogram {
+public:
+  static constexpr uint8_t SUB_BITS = 3;
+  static constexpr uint16_t BUCKETS = (32 - SUB_BITS + 1) << SUB_BITS;
+
+  void record(uint32_t cycles);
+  void reset();
+
+  /// @brief Upper bound of the bucket holding the @p permille quantile.
+  uint32_t percentile(uint16_t permille) const;
+  uint32_t max() const { return _max; }
+  uint32_t count() const { return _count; }
+
+private:
+  static uint16_t bucketOf(uint32_t cycles);
+  static uint32_t bucketLow(uint16_t bucket);
+
+  uint16_t _buckets[BUCKETS] = {};
+  uint32_t _count = 0; ///< Samples represented by _buckets (decays).
+  uint32_t _max = 0;
+};
+
+/**
+ * @class LoopProfiler
+ * @brief Per-stage histograms plus the worst iteration of every stage.
+ */
+class LoopProfiler {
+public:
+  /// @brief Worst iteration of one stage and its per-site breakdown.
+  struct Outlier {
+    uint32_t cycles;                         ///< Stage latency.
+    uint32_t atMs;                           ///< millis() at the end.
+    uint32_t siteCycles[PROFILE_SITE_COUNT]; ///< Exclusive time per site.
+  };
+
+  static uint32_t cycles() { return ESP.getCycleCount(); }
+
+  void beginStage(ProfileStage stage);
+  void endStage();
+  void enterSite(ProfileSite site);
+  void exitSite();
+
+  /// @brief Prints histograms and worst-case breakdowns to Serial.
+  void dump() const;
+  void reset();
+
+  const LatencyHistogram &histogram(ProfileStage stage) const {
+    return _hist[stage];
+  }
+  const Outlier &worst(ProfileStage stage) const { return _worst[stage]; }
+
+  /// @brief Site with the largest exclusive time in @p o, or
+  /// PROFILE_SITE_COUNT if the stage's own code dominated.
+  static ProfileSite culprit(const Outlier &o);
+
+private:
+  static constexpr uint8_t MAX_DEPTH = 6;
+
+  struct Frame {
+    ProfileSite site;
+    uint32_t start;
+    uint32_t child; ///< Time spent in nested sites.
+  };
+
+  LatencyHistogram _hist[PROFILE_STAGE_COUNT];
+  Outlier _worst[PROFILE_STAGE_COUNT] = {};
+  Outlier _current = {};
+  ProfileStage _stage = PROFILE_STAGE_COUNT; ///< Active stage, if any.
+  uint32_t _stageStart = 0;
+  Frame _stack[MAX_DEPTH];
+  uint8_t _depth = 0;
+};
+
+extern LoopProfiler loopProfiler;
+
+#if LOOP_PROFILER_ENABLED
+
+/**
+ * @class ProfileStageScope
+ * @brief Measures the enclosing block as one loop stage.
+ */
+class ProfileStageScope {
+public:
+  explicit ProfileStageScope(ProfileStage stage) {
+    loopProfiler.beginStage(stage);
+  }
+  ~ProfileStageScope() { loopProfiler.endStage(); }
+};
+
+/**
+ * @class ProfileSiteScope
+ * @brief Attributes the enclosing block to a site of the active stage.
+ */
+class ProfileSiteScope {
+public:
+  explicit ProfileSiteScope(ProfileSite site) { loopProfiler.enterSite(site); }
+  ~ProfileSiteScope() { loopProfiler.exitSite(); }
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_STAGE(s)                                                       \
+  ProfileStageScope PROFILE_CONCAT(_profStage, __LINE__)(s)
+#define PROFILE_SITE(s) ProfileSiteScope PROFILE_CONCAT(_profSite, __LINE__)(s)
+
+#else
+
+#define PROFILE_STAGE(s)                                                       \
+  do {                                                                         \
+  } while (0)
+#define PROFILE_SITE(s)                                                        \
+  do {                                                                         \
+  } while (0)
+
+#endif
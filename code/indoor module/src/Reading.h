@@ -0,0 +1,21 @@
+/**
+ * @file Reading.h
+ * @brief A cached sensor value with its capture time.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+/**
+ * @struct Reading
+ * @brief A cached sensor value and when it was captured.
+ */
+template <typename T> struct Reading {
+  T value{};               ///< Last good value.
+  uint32_t capturedMs = 0; ///< millis() at capture.
+  uint32_t capturedAt = 0; ///< Local time at capture (SystemClock).
+  bool valid = false;      ///< value has been captured at least once.
+  bool stale = false;      ///< Older than the reader's max age.
+
+  uint32_t ageMs() const { return millis() - capturedMs; }
+};
@@ -0,0 +1,90 @@
+/**
+ * @file Renderer.cpp
+ * @brief Implementation of the Renderer class.
+ */
+
+#include "Renderer.h"
+
+Renderer::Renderer(TFT_eSPI &tft, PNG &png, IconCache &icons)
+    : _tft(tft), _png(png), _icons(icons), _fontFace(tft) {}
+
+void Renderer::useFont(const char *name) {
+  if (_residentFont && strcmp(_residentFont, name) == 0)
+    return;
+  _tft.loadFont(name, LittleFS);
+  _residentFont = name;
+}
+
+void Renderer::releaseFont() {
+  if (!_residentFont)
+    return;
+  _tft.unloadFont();
+  _residentFont = nullptr;
+}
+
+void Renderer::drawImage(const char *path, int16_t x, int16_t y) {
+  _icons.draw(path, x, y, TFT_BLACK);
+}
+
+bool Renderer::drawAll(Background &bg) {
+  if (!bg.draw(_tft, _png, true))
+    return false;
+  // Poll and draw one widget at a time, so fonts load in z-order only once.
+  for (Widget *w : bg.widgets()) {
+    w->invalidate();
+    w->poll(*this);
+    w->draw(*this);
+  }
+  return true;
+}
+
+void Renderer::drawChanges(Background &bg) {
+  const Rect screen = {0, 0, _tft.width(), _tft.height()};
+  Rect damage[MAX_DAMAGE];
+  uint8_t count = 0;
+  for (Widget *w : bg.widgets()) {
+    Rect d = w->poll(*this).intersected(screen);
+    if (d.empty())
+      continue;
+    if (count < MAX_DAMAGE)
+      damage[count++] = d;
+    else
+      damage[MAX_DAMAGE - 1] = damage[MAX_DAMAGE - 1].united(d);
+  }
+
+  for (uint8_t i = 0; i < count; i++)
+    composite(bg, damage[i]);
+}
+
+void Renderer::composite(Background &bg, const Rect &area) {
+  _tft.setViewport(area.x, area.y, area.w, area.h, false);
+
+  // Opaque widgets repaint what they cover; the background is only needed
+  // around the one that covers most of the area.
+  Rect cover = {0, 0, 0, 0};
+  for (Widget *w : bg.widgets()) {
+    Rect in = w->opaque().intersected(area);
+    if (in.area() > cover.area())
+      cover = in;
+  }
+  if (cover.empty()) {
+    bg.drawRegion(_tft, _png, area);
+  } else {
+    const Rect around[] = {
+        {area.x, area.y, area.w, (int16_t)(cover.y - area.y)},
+        {area.x, (int16_t)cover.bottom(), area.w,
+         (int16_t)(area.bottom() - cover.bottom())},
+        {area.x, cover.y, (int16_t)(cover.x - area.x), cover.h},
+        {(int16_t)cover.right(), cover.y,
+         (int16_t)(area.right() - cover.right()), cover.h}};
+    for (const Rect &r : around)
+      if (!r.empty())
+        bg.drawRegion(_tft, _png, r);
+  }
+
+  for (Widget *w : bg.widgets())
+    if (w->bounds().intersects(area))
+      w->draw(*this);
+
+  _tft.resetViewport();
+}
@@ -0,0 +1,58 @@
+/**
+ * @file Renderer.h
+ * @brief Draws a Background and its widget tree, in full or by damage.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <PNGdec.h>
+#include <TFT_eSPI.h>
+
+#include "Background.h"
+#include "IconCache.h"
+#include "TextFace.h"
+#include "Widget.h"
+
+/**
+ * @class Renderer
+ * @brief Owns the drawing resources widgets share (panel, fonts, icons).
+ */
+class Renderer {
+public:
+  Renderer(TFT_eSPI &tft, PNG &png, IconCache &icons);
+
+  TFT_eSPI &tft() { return _tft; }
+
+  /// @brief Makes @p name the loaded font; a no-op if it already is.
+  void useFont(const char *name);
+
+  /// @brief Unloads the resident font (frees its metrics).
+  void releaseFont();
+
+  /// @brief The loaded smooth font (see useFont()).
+  const TextFace &fontFace() const { return _fontFace; }
+
+  /// @brief Draws a LittleFS image through the icon cache.
+  void drawImage(const char *path, int16_t x, int16_t y);
+
+  /**
+   * @brief Draws @p bg and all of its widgets.
+   * @return false if the background image could not be drawn.
+   */
+  bool drawAll(Background &bg);
+
+  /// @brief Re-composites the widgets of @p bg whose sources changed.
+  void drawChanges(Background &bg);
+
+private:
+  static constexpr uint8_t MAX_DAMAGE = 16; ///< Rects per drawChanges().
+
+  /// @brief Redraws everything inside @p area.
+  void composite(Background &bg, const Rect &area);
+
+  TFT_eSPI &_tft;                      ///< Panel.
+  PNG &_png;                           ///< Decoder for background repaints.
+  IconCache &_icons;                   ///< Decoded LittleFS images.
+  TftFace _fontFace;                   ///< Measures/draws the loaded font.
+  const char *_residentFont = nullptr; ///< Smooth font loaded in _tft.
+};
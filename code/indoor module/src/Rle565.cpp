@@ -0,0 +1,206 @@
+/**
+ * @file Rle565.cpp
+ * @brief Implementation of the Rle565Image streamer.
+ */
+
+#include "Rle565.h"
+#include "BandWriter.h"
+#include "Trace.h"
+#include <LittleFS.h>
+
+uint8_t Rle565Image::s_readBuf[READ_BUF];
+uint16_t Rle565Image::s_palette[256];
+uint16_t Rle565Image::s_line[RLE565_MAX_WIDTH];
+
+String Rle565Image::pathFor(const String &pngPath) {
+  int dot = pngPath.lastIndexOf('.');
+  return (dot < 0 ? pngPath : pngPath.substring(0, dot)) + ".rle";
+}
+
+bool Rle565Image::open(const char *path) {
+  close();
+  if (!LittleFS.exists(path))
+    return false;
+  _file = LittleFS.open(path, "r");
+  if (!_file)
+    return false;
+
+  if (_file.read((uint8_t *)&_hdr, sizeof(_hdr)) != sizeof(_hdr) ||
+      memcmp(_hdr.magic, RLE565_MAGIC, 4) != 0 ||
+      _hdr.version != RLE565_VERSION || _hdr.width == 0 ||
+      _hdr.width > RLE565_MAX_WIDTH || _hdr.height == 0 ||
+      _hdr.paletteSize > 256 ||
+      (_hdr.paletteSize != 0) != !!(_hdr.flags & RLE565_FLAG_INDEXED))
+    return fail("bad header");
+
+  size_t palBytes = _hdr.paletteSize * sizeof(uint16_t);
+  if (_file.read((uint8_t *)s_palette, palBytes) != palBytes)
+    return fail("truncated palette");
+  return true;
+}
+
+void Rle565Image::close() {
+  if (_file)
+    _file.close();
+  _bufPos = _bufLen = 0;
+}
+
+bool Rle565Image::fail(const char *what) {
+  Serial.printf("[RLE] %s: %s\n", _file ? _file.name() : "?", what);
+  close();
+  return false;
+}
+
+bool Rle565Image::fill() {
+  _bufLen = _file.read(s_readBuf, READ_BUF);
+  _bufPos = 0;
+  return _bufLen > 0;
+}
+
+bool Rle565Image::readByte(uint8_t &b) {
+  if (_bufPos == _bufLen && !fill())
+    return false;
+  b = s_readBuf[_bufPos++];
+  return true;
+}
+
+bool Rle565Image::readValues(uint16_t *dst, uint8_t count) {
+  bool indexed = _hdr.flags & RLE565_FLAG_INDEXED;
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t lo, hi;
+    if (!readByte(lo))
+      return false;
+    if (indexed) {
+      if (lo >= _hdr.paletteSize)
+        return false;
+      dst[i] = s_palette[lo];
+      continue;
+    }
+    if (!readByte(hi))
+      return false;
+    dst[i] = lo | (uint16_t)hi << 8;
+  }
+  return true;
+}
+
+bool Rle565Image::decodeRow(uint16_t *line) {
+  for (uint16_t x = 0; x < _hdr.width;) {
+    uint8_t op;
+    if (!readByte(op))
+      return fail("truncated");
+    uint8_t n = (op & ~RLE565_OP_MASK) + 1;
+    if (x + n > _hdr.width)
+      return fail("run crosses row end");
+
+    uint16_t *dst = line + x;
+    switch (op & RLE565_OP_MASK) {
+    case RLE565_OP_LITERAL:
+      if (!readValues(dst, n))
+        return fail("bad literal");
+      break;
+    case RLE565_OP_REPEAT:
+      if (!readValues(dst, 1))
+        return fail("bad repeat");
+      std::fill(dst + 1, dst + n, dst[0]);
+      break;
+    case RLE565_OP_SKIP:
+      std::fill(dst, dst + n, _hdr.key);
+      break;
+    default:
+      return fail("bad opcode");
+    }
+    x += n;
+  }
+  return true;
+}
+
+bool Rle565Image::drawToPanel(TFT_eSPI &tft, int32_t x, int32_t y,
+                              uint32_t *rowIndex) {
+  if (!_file)
+    return false;
+  if (x < 0 || y < 0 || x + _hdr.width > tft.width() ||
+      y + _hdr.height > tft.height())
+    return fail("does not fit the panel");
+
+  TRACE_SCOPE(TRACE_RLE_DECODE);
+  // Rows are native RGB565.
+  BandWriter band(tft, x, y, _hdr.width, _hdr.height, true);
+  bool ok = true;
+  for (uint16_t row = 0; ok && row < _hdr.height; row++) {
+    if (rowIndex)
+      rowIndex[row] = offset();
+    ok = decodeRow(band.row());
+    if (ok)
+      band.commit();
+  }
+  band.finish();
+  close();
+  return ok;
+}
+
+bool Rle565Image::drawRegion(TFT_eSPI &tft, int32_t x, int32_t y, int32_t rx,
+                             int32_t ry, int32_t rw, int32_t rh,
+                             const uint32_t *rowIndex) {
+  if (!_file)
+    return false;
+  int32_t x0 = max(rx, x), x1 = min(rx + rw, x + (int32_t)_hdr.width);
+  int32_t y1 = min(ry + rh, y + (int32_t)_hdr.height);
+
+  int32_t row = y;
+  if (rowIndex && ry > y && ry < y1) {
+    // Packets never cross a row end, so every row starts a packet.
+    row = ry;
+    _file.seek(rowIndex[row - y]);
+    _bufPos = _bufLen = 0;
+  }
+
+  TRACE_SCOPE(TRACE_RLE_DECODE);
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(true);
+  bool ok = true;
+  for (; ok && row < y1; row++) {
+    ok = decodeRow(s_line);
+    if (ok && row >= ry && x0 < x1)
+      tft.pushImage(x0, row, x1 - x0, 1, s_line + (x0 - x));
+  }
+  tft.setSwapBytes(swap);
+  close();
+  return ok;
+}
+
+bool Rle565Image::drawToSprite(TFT_eSprite &spr) {
+  if (!_file)
+    return false;
+
+  TRACE_SCOPE(TRACE_RLE_DECODE);
+  bool swap = spr.getSwapBytes();
+  spr.setSwapBytes(true);
+  bool ok = true;
+  for (uint16_t row = 0; ok && row < _hdr.height; row++) {
+    ok = decodeRow(s_line);
+    if (ok)
+      spr.pushImage(0, row, _hdr.width, 1, s_line);
+  }
+  spr.setSwapBytes(swap);
+  close();
+  return ok;
+}
+
+bool Rle565Image::drawKeyed(TFT_eSPI &tft, int32_t x, int32_t y,
+                            uint16_t transparent) {
+  if (!_file)
+    return false;
+
+  TRACE_SCOPE(TRACE_RLE_DECODE);
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(true);
+  bool ok = true;
+  for (uint16_t row = 0; ok && row < _hdr.height; row++) {
+    ok = decodeRow(s_line);
+    if (ok)
+      tft.pushImage(x, y + row, _hdr.width, 1, s_line, transparent);
+  }
+  tft.setSwapBytes(swap);
+  close();
+  return ok;
+}
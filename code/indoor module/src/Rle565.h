@@ -0,0 +1,124 @@
+/**
+ * @file Rle565.h
+ * @brief Pre-decoded, run-length encoded RGB565 images.
+ *
+ * Built from data/images by tools/png2rle.py.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <FS.h>
+#include <TFT_eSPI.h>
+
+#define RLE565_MAGIC "R565"
+#define RLE565_VERSION 1
+#define RLE565_FLAG_KEYED 0x01   ///< SKIP packets stand for the key colour.
+#define RLE565_FLAG_INDEXED 0x02 ///< Values are palette indices.
+
+#define RLE565_OP_MASK 0xC0
+#define RLE565_OP_LITERAL 0x00
+#define RLE565_OP_REPEAT 0x40
+#define RLE565_OP_SKIP 0x80
+#define RLE565_MAX_RUN 64
+#define RLE565_MAX_WIDTH 480
+#define RLE565_MAX_HEIGHT 320 ///< Tallest image a row index covers.
+
+/**
+ * @struct Rle565Header
+ * @brief File header, shared with tools/png2rle.py.
+ *
+ * Layout (little endian):
+ *   Rle565Header
+ *   uint16_t palette[paletteSize]    RGB565, only with RLE565_FLAG_INDEXED
+ *   packets, row by row; a packet never crosses the end of a row:
+ *     uint8_t op | (count - 1)       count = 1..64
+ *     LITERAL: count values          value = palette index (1 byte) or
+ *     REPEAT:  one value, count times          RGB565 (2 bytes)
+ *     SKIP:    count key pixels, no data
+ */
+struct __attribute__((packed)) Rle565Header {
+  char magic[4];        ///< RLE565_MAGIC.
+  uint8_t version;      ///< RLE565_VERSION.
+  uint8_t flags;        ///< RLE565_FLAG_*.
+  uint16_t width;       ///< Image width.
+  uint16_t height;      ///< Image height.
+  uint16_t key;         ///< Colour of SKIP runs (RGB565).
+  uint16_t paletteSize; ///< Palette entries following the header.
+};
+static_assert(sizeof(Rle565Header) == 14,
+              "Rle565Header must match struct.pack in tools/png2rle.py");
+
+/**
+ * @class Rle565Image
+ * @brief Streams a .rle file to the panel or into a sprite.
+ *
+ * Uses static buffers (one image is drawn at a time, from the loop task).
+ * SKIP runs are written in the key colour, so a keyed image drawn into a
+ * sprite can be pushed with the key as its transparent colour.
+ */
+class Rle565Image {
+public:
+  /// @brief Path of the .rle built from @p pngPath ("x.png" -> "x.rle").
+  static String pathFor(const String &pngPath);
+
+  /**
+   * @brief Opens @p path and validates its header and palette.
+   * @return false if the file is missing or not a valid .rle.
+   */
+  bool open(const char *path);
+  void close();
+
+  uint16_t width() const { return _hdr.width; }
+  uint16_t height() const { return _hdr.height; }
+  uint16_t key() const { return _hdr.key; }
+  bool keyed() const { return _hdr.flags & RLE565_FLAG_KEYED; }
+
+  /**
+   * @brief Streams the image into one address window at (@p x, @p y),
+   * decoding each band while the previous one is sent (BandWriter).
+   * The image must fit on the panel.
+   * @param rowIndex If given, receives the file offset of each row
+   * (height() entries) for drawRegion().
+   */
+  bool drawToPanel(TFT_eSPI &tft, int32_t x, int32_t y,
+                   uint32_t *rowIndex = nullptr);
+
+  /**
+   * @brief Repaints the part of the image drawn at (@p x, @p y) that lies
+   * in the panel rectangle (@p rx, @p ry, @p rw, @p rh). Rows below it
+   * are not decoded.
+   * @param rowIndex Row offsets from drawToPanel(); with it, decoding
+   * starts at the first row of the region, without it at the top.
+   */
+  bool drawRegion(TFT_eSPI &tft, int32_t x, int32_t y, int32_t rx,
+                  int32_t ry, int32_t rw, int32_t rh,
+                  const uint32_t *rowIndex = nullptr);
+
+  /// @brief Decodes the image into the top-left corner of @p spr.
+  bool drawToSprite(TFT_eSprite &spr);
+
+  /// @brief Draws the image at (@p x, @p y) row by row, leaving pixels of
+  /// colour @p transparent as they are (no sprite needed).
+  bool drawKeyed(TFT_eSPI &tft, int32_t x, int32_t y, uint16_t transparent);
+
+private:
+  /// @brief Expands the next row into @p dst (width() pixels).
+  bool decodeRow(uint16_t *dst);
+  /// @brief File offset of the next packet.
+  uint32_t offset() const { return _file.position() - (_bufLen - _bufPos); }
+  bool fill();
+  bool readByte(uint8_t &b);
+  bool readValues(uint16_t *dst, uint8_t count);
+  bool fail(const char *what);
+
+  static constexpr size_t READ_BUF = 512;
+
+  static uint8_t s_readBuf[READ_BUF];       ///< File read buffer.
+  static uint16_t s_palette[256];           ///< Palette (native RGB565).
+  static uint16_t s_line[RLE565_MAX_WIDTH]; ///< Row for drawRegion()/drawToSprite()/drawKeyed().
+
+  File _file;             ///< Open .rle file.
+  Rle565Header _hdr = {}; ///< Header of the open file.
+  size_t _bufPos = 0;     ///< Next byte in s_readBuf.
+  size_t _bufLen = 0;     ///< Valid bytes in s_readBuf.
+};
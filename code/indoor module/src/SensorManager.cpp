@@ -4,38 +4,142 @@
  */
 
 #include "SensorManager.h"
+#include "Profiler.h"
+#include "SystemClock.h"
 
 SensorManager::SensorManager() : oneWire(ONE_WIRE_BUS), sensors(&oneWire) {}
 
 void SensorManager::begin() {
-  pinMode(FOTORESISTOR_PIN, INPUT);
-  pinMode(TFT_LED_PIN, OUTPUT);
+  backlight.begin();
   Wire.begin(I2C_SDA, I2C_SCL);
 
   if (!rtc.begin()) {
     Serial.println("[SENS] RTC Not Found");
   }
+  sysClock.begin();
 
-  sensors.begin();
+  scanProbes();
+  conversionMs = sensors.millisToWaitForConversion(DS18B20_RESOLUTION);
+  conversionStartMs = millis() - INDOOR_TEMP_INTERVAL_MS;
 }
 
 void SensorManager::update() {
-  now = rtc.now();
-  int brightness = getBrightness();
-  analogWrite(TFT_LED_PIN, brightness);
+  PROFILE_SITE(PROFILE_SITE_BACKLIGHT);
+  backlight.update();
+  updateIndoorTemp();
+}
+
+SensorSnapshot SensorManager::read(SensorConsumer who) {
+  struct MaxAge {
+    uint32_t indoorMs;
+    uint32_t outdoorMs;
+  };
+  static constexpr MaxAge kMaxAge[SENSOR_CONSUMER_COUNT] = {
+      {INDOOR_MAX_AGE_UI_MS, OUTDOOR_MAX_AGE_UI_MS},
+      {INDOOR_MAX_AGE_PUBLISH_MS, OUTDOOR_MAX_AGE_PUBLISH_MS},
+  };
+
+  SensorSnapshot s = snap;
+  bool stale = false;
+  for (uint8_t i = 0; i < s.tempCount; i++) {
+    s.temps[i].stale = s.temps[i].ageMs() > kMaxAge[who].indoorMs;
+    stale |= s.temps[i].stale;
+  }
+  for (uint8_t i = 0; i < s.stations.count(); i++) {
+    Reading<struct_message> &r = s.stations[i].reading;
+    r.stale = r.ageMs() > kMaxAge[who].outdoorMs;
+  }
+  if (stale && !converting &&
+      millis() - conversionStartMs >= kMaxAge[who].indoorMs) {
+    // Let the next update() start a conversion.
+    conversionStartMs = millis() - INDOOR_TEMP_INTERVAL_MS;
+  }
+  return s;
+}
+
+Station *SensorManager::station(const uint8_t *mac) {
+  uint8_t known = snap.stations.count();
+  Station *st = snap.stations.findOrAdd(mac);
+  if (st && snap.stations.count() != known) {
+    Serial.printf("[SENS] Station %u: %02x:%02x:%02x:%02x:%02x:%02x\n",
+                  snap.stations.count(), mac[0], mac[1], mac[2], mac[3],
+                  mac[4], mac[5]);
+  }
+  return st;
 }
 
-float SensorManager::readIndoorTemp() {
-  sensors.requestTemperatures();
-  float t = sensors.getTempCByIndex(0);
-  return (t == DEVICE_DISCONNECTED_C) ? NAN : t;
+void SensorManager::recordOutdoor(Station &st, const struct_message &data,
+                                  uint32_t receivedMs) {
+  st.reading.value = data;
+  st.reading.capturedMs = receivedMs;
+  st.reading.capturedAt =
+      sysClock.unixTime() - (millis() - receivedMs) / 1000;
+  st.reading.valid = true;
+  st.frames++;
 }
 
-int SensorManager::getBrightness() {
-  if (autoBrightness) {
-    int read = analogRead(FOTORESISTOR_PIN);
-    return max(70, (read - 400) / 16);
-  } else {
-    return 220;
+void SensorManager::scanProbes() {
+  uint8_t before = probeCount;
+  sensors.begin();
+  // begin() reads the resolution back from the probes; a hot-plugged one
+  // still has its EEPROM setting. Conversions run in the background and
+  // update() collects the result.
+  sensors.setWaitForConversion(false);
+  sensors.setResolution(DS18B20_RESOLUTION);
+  probeCount = 0;
+  for (uint8_t i = 0;
+       i < sensors.getDeviceCount() && probeCount < MAX_TEMP_PROBES; i++) {
+    if (sensors.getAddress(probes[probeCount], i))
+      probeCount++;
+  }
+  for (uint8_t i = probeCount; i < MAX_TEMP_PROBES; i++)
+    snap.temps[i].valid = false;
+  snap.tempCount = probeCount;
+  rescan = false;
+
+  if (probeCount == 0) {
+    Serial.println("[SENS] DS18B20 Not Found");
+  } else if (probeCount != before) {
+    Serial.printf("[SENS] %u DS18B20 probe(s)\n", probeCount);
+  }
+}
+
+void SensorManager::updateIndoorTemp() {
+  uint32_t ms = millis();
+  if (!converting) {
+    if (ms - conversionStartMs < INDOOR_TEMP_INTERVAL_MS)
+      return;
+    PROFILE_SITE(PROFILE_SITE_INDOOR_TEMP);
+    if (rescan || probeCount == 0) {
+      scanProbes();
+    }
+    // Skip ROM: every probe on the bus converts at once.
+    sensors.requestTemperatures();
+    conversionStartMs = ms;
+    converting = true;
+    return;
+  }
+
+  // The datasheet time is an upper bound, so wait it out instead of
+  // polling the bus for the end of the conversion.
+  if (ms - conversionStartMs < conversionMs)
+    return;
+  PROFILE_SITE(PROFILE_SITE_INDOOR_TEMP);
+  converting = false;
+  uint32_t unixTime = sysClock.unixTime();
+  for (uint8_t i = 0; i < probeCount; i++) {
+    float t = sensors.getTempC(probes[i]);
+    if (t == DEVICE_DISCONNECTED_C) {
+      // Keep the last good value; it goes stale for every consumer.
+      rescan = true;
+      continue;
+    }
+    Reading<float> &r = snap.temps[i];
+    if (!r.valid || t != r.value)
+      screenDataDirty = true;
+    r.value = t;
+    r.capturedMs = ms;
+    r.capturedAt = unixTime;
+    r.valid = true;
   }
 }
\ No newline at end of file
@@ -11,8 +11,34 @@
 #include <RTClib.h>
 #include <Wire.h>
 
+#include "Backlight.h"
 #include "Config.h"
 #include "Globals.h"
+#include "Reading.h"
+#include "StationTable.h"
+
+/**
+ * @struct SensorSnapshot
+ * @brief Every reading the UI and the cloud publish show, from one cache.
+ */
+struct SensorSnapshot {
+  Reading<float> temps[MAX_TEMP_PROBES]; ///< DS18B20s in bus order, Celsius.
+  uint8_t tempCount = 0;                 ///< Probes found on the bus.
+  StationTable stations;                 ///< Outdoor nodes by MAC.
+
+  /// @brief The first probe, shown as the indoor temperature.
+  const Reading<float> &indoorTemp() const { return temps[0]; }
+};
+
+/**
+ * @enum SensorConsumer
+ * @brief Reader of the snapshot; each has its own max-age policy.
+ */
+enum SensorConsumer : uint8_t {
+  SENSOR_CONSUMER_UI,      ///< Home screen (INDOOR/OUTDOOR_MAX_AGE_UI_MS).
+  SENSOR_CONSUMER_PUBLISH, ///< AWS publish (*_MAX_AGE_PUBLISH_MS).
+  SENSOR_CONSUMER_COUNT
+};
 
 /**
  * @class SensorManager
@@ -33,14 +59,54 @@ public:
   void update();
 
   /**
-   * @brief Reads the indoor temperature from DS18B20.
-   * @return Temperature in Celsius or NAN on error.
+   * @brief The cached readings as @p who should see them; never blocks.
+   *
+   * Entries older than the consumer's max age come back marked stale, and
+   * a stale probe temperature starts a conversion ahead of schedule.
    */
-  float readIndoorTemp();
+  SensorSnapshot read(SensorConsumer who);
+
+  /// @brief The cached readings, without a staleness check.
+  const SensorSnapshot &snapshot() const { return snap; }
+
+  /**
+   * @brief The station of @p mac, added on first contact (call only for a
+   * frame that decoded).
+   * @return null if MAX_OUTDOOR_NODES other stations are known.
+   */
+  Station *station(const uint8_t *mac);
+
+  /// @brief The station of @p mac, or null if it was never added.
+  Station *knownStation(const uint8_t *mac) {
+    return snap.stations.find(mac);
+  }
+
+  /**
+   * @brief Stores a reading of @p st in the snapshot.
+   * @param receivedMs millis() when the frame arrived.
+   */
+  void recordOutdoor(Station &st, const struct_message &data,
+                     uint32_t receivedMs);
 
 private:
+  /**
+   * @brief Steps the DS18B20 conversion: starts one on all probes every
+   * INDOOR_TEMP_INTERVAL_MS and reads each once they are done.
+   */
+  void updateIndoorTemp();
+
+  /// @brief Searches the bus and caches the ROMs of up to MAX_TEMP_PROBES.
+  void scanProbes();
+
   OneWire oneWire;           ///< OneWire interface for DS18B20.
   DallasTemperature sensors; ///< DallasTemp wrapper.
+  Backlight backlight;       ///< Light sensor and TFT backlight.
 
-  int getBrightness();
+  DeviceAddress probes[MAX_TEMP_PROBES]; ///< ROMs, in bus search order.
+  uint8_t probeCount = 0;                ///< Valid entries in probes.
+  bool rescan = false;                   ///< A probe stopped answering.
+  bool converting = false;               ///< A conversion is running.
+  uint32_t conversionStartMs;            ///< millis() of the last start.
+  uint16_t conversionMs;                 ///< At DS18B20_RESOLUTION.
+  SensorSnapshot snap;                   ///< Latest readings.
 };
\ No newline at end of file
@@ -0,0 +1,62 @@
+/**
+ * @file SpscRing.h
+ * @brief Lock-free single-producer/single-consumer ring buffer.
+ *
+ * push() never blocks and takes no lock, so it is safe in an ISR.
+ */
+
+#pragma once
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @class SpscRing
+ * @brief Fixed ring of @p N entries of @p T (N a power of two).
+ */
+template <typename T, size_t N> class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+  /**
+   * @brief Appends @p value (producer side).
+   * @return false, and counts a drop, if the ring is full.
+   */
+  __attribute__((always_inline)) inline bool push(const T &value) {
+    uint32_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == N) {
+      _dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    _slots[head & (N - 1)] = value;
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Takes the oldest entry (consumer side).
+   * @return false if the ring is empty.
+   */
+  bool pop(T &value) {
+    uint32_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire))
+      return false;
+    value = _slots[tail & (N - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return _tail.load(std::memory_order_relaxed) ==
+           _head.load(std::memory_order_acquire);
+  }
+
+  /// @brief Entries push() could not store since start-up.
+  uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+  T _slots[N];                       ///< Entry storage.
+  std::atomic<uint32_t> _head{0};    ///< Next slot to write (producer).
+  std::atomic<uint32_t> _tail{0};    ///< Next slot to read (consumer).
+  std::atomic<uint32_t> _dropped{0}; ///< Pushes refused while full.
+};
@@ -0,0 +1,49 @@
+/**
+ * @file StationTable.cpp
+ * @brief Implementation of the StationTable class.
+ */
+
+#include "StationTable.h"
+
+int32_t Station::trackSeq(uint16_t seq, bool restarted) {
+  // A repeated number is a burst retry (restart flag included, retries are
+  // resent unchanged); a forward gap is lost readings. A restart, or a jump
+  // back without one, only resyncs.
+  uint16_t step = seq - lastSeq;
+  bool known = hasSeq;
+  lastSeq = seq;
+  hasSeq = true;
+  if (known && step == 0) {
+    duplicates++;
+    return -1;
+  }
+  if (!known || restarted || step >= 0x8000)
+    return 0;
+  lost += step - 1;
+  return step - 1;
+}
+
+uint8_t StationTable::slotOf(const uint8_t *mac) const {
+  // The last three bytes are the device-specific part of the address.
+  uint8_t i = (mac[3] * 31u * 31u + mac[4] * 31u + mac[5]) & (SLOTS - 1);
+  while (_slots[i] && memcmp(_stations[_slots[i] - 1].mac, mac, 6) != 0)
+    i = (i + 1) & (SLOTS - 1);
+  return i;
+}
+
+Station *StationTable::find(const uint8_t *mac) {
+  uint8_t s = _slots[slotOf(mac)];
+  return s ? &_stations[s - 1] : nullptr;
+}
+
+Station *StationTable::findOrAdd(const uint8_t *mac) {
+  uint8_t i = slotOf(mac);
+  if (_slots[i])
+    return &_stations[_slots[i] - 1];
+  if (_count == MAX_OUTDOOR_NODES)
+    return nullptr;
+  Station &s = _stations[_count] = Station();
+  memcpy(s.mac, mac, sizeof(s.mac));
+  _slots[i] = ++_count;
+  return &s;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file StationTable.h
+ * @brief Outdoor nodes heard over ESP-NOW, keyed by sender MAC.
+ */
+
+#pragma once
+#include <Arduino.h>
+
+#include "Config.h"
+#include "Globals.h"
+#include "Reading.h"
+
+/**
+ * @struct Station
+ * @brief One outdoor node and what it last sent.
+ */
+struct Station {
+  uint8_t mac[6];                  ///< Sender address.
+  Reading<struct_message> reading; ///< Latest reading.
+  uint32_t lastSeenMs = 0;         ///< millis() of the last frame.
+  int8_t rssi = 0;                 ///< Last frame, dBm (0 = unknown).
+  uint32_t frames = 0;             ///< Readings received.
+  uint32_t malformed = 0;          ///< Frames that were not a reading.
+  uint32_t corrupt = 0;            ///< v2 frames failing their CRC.
+  uint32_t duplicates = 0;         ///< Retransmissions of a reading.
+  uint32_t lost = 0;               ///< Readings skipped in the sequence.
+  uint16_t lastSeq = 0;            ///< Sequence number of the last v2 frame.
+  bool hasSeq = false;             ///< lastSeq is set.
+
+  /**
+   * @brief Books v2 reading number @p seq.
+   * @param restarted The node started counting again (WIRE_FLAG_RESTART).
+   * @return Readings lost before it, or -1 if it repeats the last one.
+   */
+  int32_t trackSeq(uint16_t seq, bool restarted);
+};
+
+/**
+ * @class StationTable
+ * @brief Up to MAX_OUTDOOR_NODES stations with O(1) lookup by MAC.
+ */
+class StationTable {
+public:
+  /// @brief The station of @p mac, or null if it was never heard.
+  Station *find(const uint8_t *mac);
+
+  /// @brief find(), adding a station if there is room (else null).
+  Station *findOrAdd(const uint8_t *mac);
+
+  uint8_t count() const { return _count; }
+  Station &operator[](uint8_t i) { return _stations[i]; }
+  const Station &operator[](uint8_t i) const { return _stations[i]; }
+
+private:
+  static_assert((MAX_OUTDOOR_NODES & (MAX_OUTDOOR_NODES - 1)) == 0,
+                "MAX_OUTDOOR_NODES must be a power of two");
+  static constexpr uint8_t SLOTS = MAX_OUTDOOR_NODES * 2; ///< Load <= 1/2.
+
+  /// @brief Index slot holding @p mac, or the free slot it would go in.
+  uint8_t slotOf(const uint8_t *mac) const;
+
+  Station _stations[MAX_OUTDOOR_NODES]; ///< In order first heard.
+  uint8_t _count = 0;                   ///< Stations in use.
+  uint8_t _slots[SLOTS] = {};           ///< Station index + 1, 0 = free.
+};
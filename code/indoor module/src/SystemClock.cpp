@@ -0,0 +1,98 @@
+/**
+ * @file SystemClock.cpp
+ * @brief Implementation of the SystemClock class.
+ */
+
+#include "SystemClock.h"
+#include "Config.h"
+#include "Profiler.h"
+
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <time.h>
+
+SystemClock *SystemClock::s_instance = nullptr;
+
+SystemClock::SystemClock(RTC_DS3231 &rtc) : _rtc(rtc) {}
+
+void SystemClock::begin() {
+  s_instance = this;
+  setenv("TZ", LOCAL_TZ, 1);
+  tzset();
+  syncFromRtc();
+  sntp_set_time_sync_notification_cb(onNtpSync);
+}
+
+void SystemClock::syncFromRtc() {
+  PROFILE_SITE(PROFILE_SITE_RTC_READ);
+  DateTime t = _rtc.now();
+  // The read lands somewhere in that second; assume its middle.
+  set(t.unixtime() * 1000000LL + 500000, esp_timer_get_time(),
+      CLOCK_SOURCE_RTC);
+}
+
+void SystemClock::markMinute(int64_t atUs) {
+  int64_t minuteUs = 60 * 1000000LL;
+  int64_t unixUs = atUs + _offsetUs;
+  int64_t mark = (unixUs + minuteUs / 2) / minuteUs * minuteUs;
+  set(mark, atUs, CLOCK_SOURCE_RTC);
+}
+
+void SystemClock::update() {
+  NtpSample s;
+  while (_ntp.pop(s)) {
+    int64_t utcS = s.unixUs / 1000000;
+    int64_t localUs = s.unixUs + ((int64_t)toLocal(utcS) - utcS) * 1000000;
+    int64_t skewUs = localUs - (s.atUs + _offsetUs);
+    set(localUs, s.atUs, CLOCK_SOURCE_NTP);
+    if (skewUs > -1000000 && skewUs < 1000000)
+      continue;
+    _rtc.adjust(DateTime(unixTime()));
+    Serial.printf("[CLK] RTC was %ld ms off NTP, adjusted\n",
+                  (long)(skewUs / 1000));
+  }
+}
+
+int64_t SystemClock::unixMicros() const {
+  return esp_timer_get_time() + _offsetUs;
+}
+
+uint32_t SystemClock::msToNextMinute() const {
+  int64_t minuteUs = 60 * 1000000LL;
+  int64_t intoMinute = unixMicros() % minuteUs;
+  return (uint32_t)((minuteUs - intoMinute + 999) / 1000);
+}
+
+uint32_t SystemClock::toUtc(uint32_t local) {
+  DateTime d(local);
+  struct tm t = {};
+  t.tm_year = d.year() - 1900;
+  t.tm_mon = d.month() - 1;
+  t.tm_mday = d.day();
+  t.tm_hour = d.hour();
+  t.tm_min = d.minute();
+  t.tm_sec = d.second();
+  t.tm_isdst = -1; // mktime() works out DST from LOCAL_TZ.
+  return (uint32_t)mktime(&t);
+}
+
+uint32_t SystemClock::toLocal(uint32_t utc) {
+  time_t u = utc;
+  struct tm t;
+  localtime_r(&u, &t);
+  return DateTime(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday, t.tm_hour,
+                  t.tm_min, t.tm_sec)
+      .unixtime();
+}
+
+void SystemClock::onNtpSync(struct timeval *tv) {
+  if (!s_instance || !tv)
+    return;
+  NtpSample s = {tv->tv_sec * 1000000LL + tv->tv_usec, esp_timer_get_time()};
+  s_instance->_ntp.push(s);
+}
+
+void SystemClock::set(int64_t unixUs, int64_t atUs, ClockSource source) {
+  _offsetUs = unixUs - atUs;
+  _source = source;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file SystemClock.h
+ * @brief Wall clock kept by esp_timer and disciplined by the RTC and NTP.
+ *
+ * Like the DS3231, it keeps local time (LOCAL_TZ).
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <RTClib.h>
+#include <sys/time.h>
+
+#include "SpscRing.h"
+
+/**
+ * @enum ClockSource
+ * @brief Last reference the clock was set from.
+ */
+enum ClockSource : uint8_t {
+  CLOCK_SOURCE_NONE, ///< Not set; counts from the Unix epoch.
+  CLOCK_SOURCE_RTC,  ///< DS3231 read or minute alarm.
+  CLOCK_SOURCE_NTP   ///< SNTP sync.
+};
+
+/**
+ * @class SystemClock
+ * @brief Cheap wall-clock time for the loop.
+ */
+class SystemClock {
+public:
+  explicit SystemClock(RTC_DS3231 &rtc);
+
+  /// @brief Sets the clock from the RTC and subscribes to SNTP syncs.
+  void begin();
+
+  /// @brief Sets the clock from the RTC (one I2C read).
+  void syncFromRtc();
+
+  /**
+   * @brief Corrects the clock from an RTC minute alarm.
+   * @param atUs esp_timer_get_time() of the alarm edge: second 00 of the
+   * minute nearest to what the clock read then.
+   */
+  void markMinute(int64_t atUs);
+
+  /// @brief Applies SNTP syncs received since the last call (loop only).
+  void update();
+
+  /// @brief Unix time in microseconds.
+  int64_t unixMicros() const;
+
+  /// @brief Unix time in seconds.
+  uint32_t unixTime() const { return (uint32_t)(unixMicros() / 1000000); }
+
+  /// @brief Current calendar time.
+  DateTime now() const { return DateTime(unixTime()); }
+
+  /// @brief Milliseconds until the next minute starts.
+  uint32_t msToNextMinute() const;
+
+  ClockSource source() const { return _source; }
+
+  /// @brief UTC Unix time of the local time @p local (LOCAL_TZ).
+  static uint32_t toUtc(uint32_t local);
+
+  /// @brief Local time (LOCAL_TZ) of the UTC Unix time @p utc.
+  static uint32_t toLocal(uint32_t utc);
+
+private:
+  /// @brief Unix time of an SNTP sync and when it arrived.
+  struct NtpSample {
+    int64_t unixUs; ///< Time reported by SNTP.
+    int64_t atUs;   ///< esp_timer_get_time() at the callback.
+  };
+
+  /// @brief SNTP notification; runs in the SNTP task, so only queues.
+  static void onNtpSync(struct timeval *tv);
+
+  void set(int64_t unixUs, int64_t atUs, ClockSource source);
+
+  static SystemClock *s_instance; ///< Target of onNtpSync().
+
+  RTC_DS3231 &_rtc;                        ///< Battery-backed reference.
+  int64_t _offsetUs = 0;                   ///< Unix time minus esp_timer time (us).
+  ClockSource _source = CLOCK_SOURCE_NONE; ///< Last reference applied.
+  SpscRing<NtpSample, 2> _ntp;             ///< SNTP task -> loop.
+};
+
+extern SystemClock sysClock; ///< The wall clock (main.cpp).
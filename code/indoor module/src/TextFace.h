@@ -0,0 +1,78 @@
+/**
+ * @file TextFace.h
+ * @brief Common interface of the ways a line of text can be drawn.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+/**
+ * @class TextFace
+ * @brief Measures and draws a single centred line of text.
+ */
+class TextFace {
+public:
+  virtual ~TextFace() {}
+
+  /// @brief Width as TFT_eSPI::textWidth() reports it (last glyph by ink).
+  virtual int16_t textWidth(const char *s) const = 0;
+
+  /// @brief Pen position after the first @p bytes of @p s.
+  virtual int16_t advance(const char *s, unsigned bytes) const = 0;
+
+  /// @brief Line height (fontHeight()); MC_DATUM centres on it.
+  virtual int16_t lineHeight() const = 0;
+
+  /// @brief Rows below the line top that glyphs may ink.
+  virtual int16_t inkHeight() const = 0;
+
+  /// @brief Draws @p s centred on (@p x, @p y), i.e. with MC_DATUM.
+  virtual void drawCentred(TFT_eSPI &tft, const String &s, int32_t x,
+                           int32_t y) const = 0;
+};
+
+/**
+ * @class TftFace
+ * @brief The smooth font currently loaded in a TFT_eSPI, with the text
+ * colours already set on it.
+ */
+class TftFace : public TextFace {
+public:
+  explicit TftFace(TFT_eSPI &tft) : _tft(tft) {}
+
+  int16_t textWidth(const char *s) const override {
+    return _tft.textWidth(s);
+  }
+
+  int16_t advance(const char *s, unsigned bytes) const override {
+    // textWidth() measures the ink of the last glyph instead of its advance;
+    // a trailing space (always spaceWidth) makes it return the pen position.
+    char buf[64];
+    if (bytes + 2 > sizeof(buf))
+      return _tft.textWidth(String(s).substring(0, bytes) + " ") -
+             _tft.textWidth(" ");
+    memcpy(buf, s, bytes);
+    buf[bytes] = ' ';
+    buf[bytes + 1] = '\0';
+    return _tft.textWidth(buf) - _tft.textWidth(" ");
+  }
+
+  int16_t lineHeight() const override { return _tft.fontHeight(); }
+
+  int16_t inkHeight() const override {
+    // Glyphs hang from the line top; the tallest and the deepest together
+    // can be taller than the line height.
+    return max<int16_t>(_tft.fontHeight(),
+                        _tft.gFont.maxAscent + _tft.gFont.maxDescent);
+  }
+
+  void drawCentred(TFT_eSPI &tft, const String &s, int32_t x,
+                   int32_t y) const override {
+    tft.setTextDatum(MC_DATUM);
+    tft.drawString(s, x, y);
+  }
+
+private:
+  TFT_eSPI &_tft; ///< Display holding the font.
+};
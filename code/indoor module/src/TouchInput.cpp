@@ -0,0 +1,108 @@
+/**
+ * @file TouchInput.cpp
+ * @brief Implementation of the TouchInput class.
+ */
+
+#include "TouchInput.h"
+
+TouchInput *TouchInput::s_instance = nullptr;
+
+TouchInput::TouchInput(TFT_eSPI &tft, uint8_t irqPin)
+    : _tft(tft), _pin(irqPin) {}
+
+void TouchInput::begin() {
+  s_instance = this;
+  pinMode(_pin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(_pin), onPenIrq, FALLING);
+}
+
+void IRAM_ATTR TouchInput::onPenIrq() {
+  if (s_instance)
+    s_instance->_edges.push(micros());
+}
+
+bool TouchInput::poll(TouchEvent &event) {
+  uint32_t edgeUs;
+  while (_edges.pop(edgeUs)) {
+    if (_state == IDLE) {
+      _state = SETTLING;
+      _downUs = edgeUs;
+    }
+  }
+  if (_state == IDLE) {
+    if (digitalRead(_pin) != LOW)
+      return false; // Untouched: no SPI.
+    _state = SETTLING; // Edge missed (e.g. pressed during begin()).
+    _downUs = micros();
+  }
+
+  uint32_t nowUs = micros();
+  uint16_t tx = 0, ty = 0;
+  bool touched = digitalRead(_pin) == LOW && _tft.getTouch(&tx, &ty);
+
+  if (_state == SETTLING) {
+    if (!touched) {
+      _state = IDLE; // Bounce or noise.
+      return false;
+    }
+    if (nowUs - _downUs < TOUCH_DEBOUNCE_MS * 1000UL)
+      return false;
+    _state = DOWN;
+    _startX = _x = tx;
+    _startY = _y = ty;
+    _upUs = 0;
+    _longSent = false;
+    return false;
+  }
+
+  if (touched) {
+    _x = tx;
+    _y = ty;
+    _upUs = 0;
+    int16_t dx = abs(_x - _startX), dy = abs(_y - _startY);
+    if (!_longSent && dx < TOUCH_SWIPE_MIN_PX && dy < TOUCH_SWIPE_MIN_PX &&
+        nowUs - _downUs >= TOUCH_LONG_PRESS_MS * 1000UL) {
+      _longSent = true;
+      describe(event, TOUCH_LONG_PRESS, nowUs);
+      return true;
+    }
+    return false;
+  }
+
+  if (_upUs == 0)
+    _upUs = nowUs;
+  if (nowUs - _upUs < TOUCH_DEBOUNCE_MS * 1000UL)
+    return false;
+  return finish(event);
+}
+
+bool TouchInput::finish(TouchEvent &event) {
+  _state = IDLE;
+  // Sampling makes the XPT2046 drop PENIRQ too; those edges are not presses.
+  uint32_t edgeUs;
+  while (_edges.pop(edgeUs)) {
+  }
+  if (_longSent)
+    return false;
+
+  int16_t dx = _x - _startX, dy = _y - _startY;
+  TouchGesture gesture = TOUCH_TAP;
+  if (abs(dx) >= TOUCH_SWIPE_MIN_PX || abs(dy) >= TOUCH_SWIPE_MIN_PX) {
+    if (abs(dx) >= abs(dy))
+      gesture = dx < 0 ? TOUCH_SWIPE_LEFT : TOUCH_SWIPE_RIGHT;
+    else // getTouch() Y grows towards the top of the panel.
+      gesture = dy > 0 ? TOUCH_SWIPE_UP : TOUCH_SWIPE_DOWN;
+  }
+  describe(event, gesture, _upUs);
+  return true;
+}
+
+void TouchInput::describe(TouchEvent &event, TouchGesture gesture,
+                          uint32_t endUs) const {
+  event.gesture = gesture;
+  event.x = _x;
+  event.y = _y;
+  event.dx = _x - _startX;
+  event.dy = _startY - _y;
+  event.durationMs = (endUs - _downUs) / 1000;
+}
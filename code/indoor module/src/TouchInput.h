@@ -0,0 +1,88 @@
+/**
+ * @file TouchInput.h
+ * @brief Interrupt-driven touch sampling and gesture recognition.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#include "Config.h"
+#include "SpscRing.h"
+
+/**
+ * @enum TouchGesture
+ * @brief What a touch was. Swipe directions are as seen on the panel.
+ */
+enum TouchGesture : uint8_t {
+  TOUCH_TAP,         ///< Short touch without travel.
+  TOUCH_LONG_PRESS,  ///< Held still for TOUCH_LONG_PRESS_MS.
+  TOUCH_SWIPE_LEFT,  ///< Moved right to left.
+  TOUCH_SWIPE_RIGHT, ///< Moved left to right.
+  TOUCH_SWIPE_UP,    ///< Moved bottom to top.
+  TOUCH_SWIPE_DOWN   ///< Moved top to bottom.
+};
+
+/**
+ * @struct TouchEvent
+ * @brief One recognised gesture.
+ */
+struct TouchEvent {
+  TouchGesture gesture; ///< Kind of gesture.
+  int16_t x;            ///< Last sample, getTouch() coordinates.
+  int16_t y;            ///< Last sample, getTouch() coordinates.
+  int16_t dx;           ///< Travel since the press, panel X.
+  int16_t dy;           ///< Travel since the press, panel Y.
+  uint32_t durationMs;  ///< Press to release (or to the long press).
+};
+
+/**
+ * @class TouchInput
+ * @brief Turns PENIRQ edges and touch samples into TouchEvents.
+ */
+class TouchInput {
+public:
+  explicit TouchInput(TFT_eSPI &tft, uint8_t irqPin = TOUCH_IRQ_PIN);
+
+  /// @brief Configures the PENIRQ pin and attaches its interrupt.
+  void begin();
+
+  /**
+   * @brief Advances the touch state machine; call once per loop.
+   * @param event Set to the recognised gesture when returning true.
+   * @return true if a gesture finished (or a long press was reached).
+   */
+  bool poll(TouchEvent &event);
+
+  /// @brief PENIRQ edges lost because the queue was full.
+  uint32_t droppedEdges() const { return _edges.dropped(); }
+
+private:
+  enum State : uint8_t {
+    IDLE,     ///< Untouched; nothing is read.
+    SETTLING, ///< Edge seen, waiting for contact to hold.
+    DOWN      ///< Touch in progress.
+  };
+
+  static void IRAM_ATTR onPenIrq();
+
+  /// @brief Ends the touch; true (and @p event set) unless nothing to report.
+  bool finish(TouchEvent &event);
+
+  /// @brief Fills @p event from the current touch.
+  void describe(TouchEvent &event, TouchGesture gesture, uint32_t endUs) const;
+
+  static TouchInput *s_instance; ///< Target of onPenIrq().
+
+  TFT_eSPI &_tft;               ///< Owner of the XPT2046 driver.
+  uint8_t _pin;                 ///< PENIRQ input.
+  SpscRing<uint32_t, 8> _edges; ///< micros() of PENIRQ falling edges.
+  State _state = IDLE;          ///< Touch state.
+  uint32_t _downUs = 0;         ///< Time of the press edge.
+  uint32_t _upUs = 0;           ///< Time contact was first lost, or 0.
+  int16_t _startX = 0;          ///< First sample of the touch.
+  int16_t _startY = 0;          ///< First sample of the touch.
+  int16_t _x = 0;               ///< Last sample of the touch.
+  int16_t _y = 0;               ///< Last sample of the touch.
+  bool _longSent = false;       ///< Long press already reported.
+};
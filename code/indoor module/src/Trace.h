@@ -0,0 +1,55 @@
+/**
+ * @file Trace.h
+ * @brief Optional instrumentation hooks around rendering hot paths.
+ *
+ * Compiled out unless METEO_TRACE is defined; such builds provide
+ * traceBegin()/traceEnd() (host/src/FrameRecorder.cpp).
+ */
+
+#pragma once
+#include <stdint.h>
+
+/**
+ * @enum TraceId
+ * @brief Instrumented code regions.
+ */
+typedef enum : uint8_t {
+  TRACE_CHANGE_SCREEN, ///< UIManager::changeScreen (arg = SCREEN).
+  TRACE_DRAW_DYNAMIC,  ///< Home screen redraw after new sensor data.
+  TRACE_DRAW_CLOCK,    ///< Minute or status redraw (clock, icons).
+  TRACE_PNG_DECODE,    ///< PNGdec decode of a background or icon.
+  TRACE_RLE_DECODE,    ///< Rle565Image stream of a background or icon.
+  TRACE_COUNT
+} TraceId;
+
+#ifdef METEO_TRACE
+
+void traceBegin(TraceId id, int32_t arg);
+void traceEnd(TraceId id);
+
+/**
+ * @class TraceScope
+ * @brief Marks the enclosing block as one traced region.
+ */
+class TraceScope {
+public:
+  explicit TraceScope(TraceId id, int32_t arg = -1) : _id(id) {
+    traceBegin(id, arg);
+  }
+  ~TraceScope() { traceEnd(_id); }
+
+private:
+  TraceId _id;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(...) TraceScope TRACE_CONCAT(_trace, __LINE__)(__VA_ARGS__)
+
+#else
+
+#define TRACE_SCOPE(...)                                                       \
+  do {                                                                         \
+  } while (0)
+
+#endif
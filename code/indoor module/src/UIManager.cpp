@@ -4,9 +4,131 @@
  */
 
 #include "UIManager.h"
+#include "ClockGlyphs.h"
 
 UIManager *uiInstance = nullptr;
 
+/// @brief Network state for the WiFi icon of the connection screens.
+static NetworkManager *s_network = nullptr;
+/// @brief Readings the labels show, as the UI consumer last read them.
+static SensorSnapshot s_view;
+/// @brief Bit per probe, then per station, whose reading is stale.
+static uint32_t s_staleShown = 0;
+
+/// @brief Pre-rendered clock digits (tools/vlw2atlas.py).
+static const GlyphAtlas clockAtlas(kClockFont);
+
+static constexpr const uint16_t *kWifiFrames[] = {wifiFalse_Sprite,
+                                                  wifitrue_sprite};
+static constexpr const uint16_t *kAutoBrightnessFrames[] = {
+    autoBrightnessOff_Sprite, autoBrightnessOn_Sprite};
+
+// --- Widget data sources ---
+
+static void clockText(String &out) {
+  out = String(now.hour()) + ":";
+  if (now.minute() < 10)
+    out += "0";
+  out += String(now.minute());
+}
+
+static void dateText(String &out) {
+  static const char *daysOfWeek[] = {"Niedziela", "Poniedzialek", "Wtorek",
+                                     "Sroda",     "Czwartek",     "Piatek",
+                                     "Sobota"};
+  int dayIdx = now.dayOfTheWeek();
+  if (dayIdx < 0 || dayIdx > 6)
+    dayIdx = 0;
+  out = String(now.day()) + "." + String(now.month()) + "." +
+        String(now.year()) + ", " + String(daysOfWeek[dayIdx]);
+}
+
+/// @brief Shown instead of a reading older than the UI's max age.
+static const char kNoValue[] = "--";
+
+template <typename T> static bool isStale(const Reading<T> &r) {
+  return r.valid && r.stale;
+}
+
+/// @brief Re-reads s_view; true if a reading went stale or fresh again.
+static bool refreshView(SensorManager *sensors) {
+  static_assert(MAX_TEMP_PROBES + MAX_OUTDOOR_NODES <= 32,
+                "s_staleShown has a bit per reading");
+  s_view = sensors->read(SENSOR_CONSUMER_UI);
+  uint32_t stale = 0;
+  for (uint8_t i = 0; i < s_view.tempCount; i++)
+    stale |= (uint32_t)isStale(s_view.temps[i]) << i;
+  for (uint8_t i = 0; i < s_view.stations.count(); i++)
+    stale |= (uint32_t)isStale(s_view.stations[i].reading)
+             << (MAX_TEMP_PROBES + i);
+  bool changed = stale != s_staleShown;
+  s_staleShown = stale;
+  return changed;
+}
+
+/// @brief Latest reading of the selected station (zeros before any).
+static const Reading<struct_message> &outdoorReading() {
+  static const Reading<struct_message> none;
+  const StationTable &t = s_view.stations;
+  uint8_t i = uiInstance ? uiInstance->selectedStation() : 0;
+  return i < t.count() ? t[i].reading : none;
+}
+
+static void outdoorTempText(String &out) {
+  const Reading<struct_message> &r = outdoorReading();
+  out = isStale(r) ? String(kNoValue)
+            : String(r.value.outdoorTemperatureRead / 10.0, 1);
+  out += " C";
+  if (s_view.stations.count() > 1 && uiInstance)
+    out = String(uiInstance->selectedStation() + 1) + ": " + out;
+}
+
+static void indoorTempText(String &out) {
+  const Reading<float> &r = s_view.indoorTemp();
+  out = isStale(r) ? String(kNoValue) : String(r.value, 1);
+  out += " *C";
+}
+
+/// @brief "Sonda 2: 21.5   3: 19.0 *C", short enough for SMALL_FONT_NAME.
+static void probeTempsText(String &out) {
+  const SensorSnapshot &s = s_view;
+  out = "";
+  for (uint8_t i = 1; i < s.tempCount; i++) {
+    const Reading<float> &t = s.temps[i];
+    if (!t.valid)
+      continue;
+    out += out.length() ? "   " : "Sonda ";
+    out += String(i + 1) + ": ";
+    out += isStale(t) ? String(kNoValue) : String(t.value, 1);
+  }
+  if (out.length())
+    out += " *C";
+}
+
+static void humPressText(String &out) {
+  const Reading<struct_message> &r = outdoorReading();
+  if (isStale(r)) {
+    out = String("Wilg.:") + kNoValue + " %      " + kNoValue + " hPa";
+    return;
+  }
+  out = "Wilg.:" + String(r.value.humidityRead) + " %      " +
+        String(r.value.pressureRead) + " hPa";
+}
+
+static void pairingKeyText(String &out) { out = AppConnectionKey; }
+
+static bool isConnected() { return connectionGood; }
+static bool isDisconnected() { return !connectionGood; }
+static bool isPaired() { return ownerIdentityId.length() > 0; }
+static bool isUnpaired() { return ownerIdentityId.length() == 0; }
+static bool hasPairingKey() { return AppConnectionKey.length() > 0; }
+static bool isPairedNoKey() { return !hasPairingKey() && isPaired(); }
+static bool isUnclaimed() { return !hasPairingKey() && isUnpaired(); }
+
+static uint8_t connectionState() { return connectionGood; }
+static uint8_t wifiState() { return s_network->isWifiConnected(); }
+static uint8_t autoBrightnessState() { return autoBrightness; }
+
 void wrapperGoToSettings(uint8_t, int16_t, int16_t) {
   if (uiInstance)
     uiInstance->onBtnGoToSettings();
@@ -19,6 +141,10 @@ void wrapperSwitchAutoBrightness(uint8_t, int16_t, int16_t) {
   if (uiInstance)
     uiInstance->onBtnSwitchAutoBrightness();
 }
+void wrapperNextStation(uint8_t, int16_t, int16_t) {
+  if (uiInstance)
+    uiInstance->onBtnNextStation();
+}
 void wrapperGoToAppConnection(uint8_t, int16_t, int16_t) {
   if (uiInstance)
     uiInstance->onBtnGoToAppConnection();
@@ -28,10 +154,168 @@ void wrapperGoToWifiConnection(uint8_t, int16_t, int16_t) {
     uiInstance->onBtnGoToWifiConnection();
 }
 
+// --- Screen layouts ---
+
+static constexpr int16_t CX = SCREEN_WIDTH / 2;  ///< Panel centre X.
+static constexpr int16_t CY = SCREEN_HEIGHT / 2; ///< Panel centre Y.
+
+static constexpr Rect kGearRect = {440, 5, 30, 30};
+static constexpr Rect kWifiRect = {400, 5, 30, 30};
+
+using layout::icon;
+using layout::image;
+using layout::label;
+using layout::sprite;
+
+// Erasers repaint the area under each changing text; the last Rect is the
+// part of each inside its rounded (transparent) corners.
+static constexpr WidgetDef kHomeWidgets[] = {
+    image("/images/time295x111.png", {93, 67, 295, 111}, {12, 1, 271, 109}),
+    label(CX, CY - 33, nullptr, TFT_WHITE, TFT_BLUE, clockText, &clockAtlas),
+    image("/images/date265x29.png", {110, 33, 265, 29}, {2, 1, 260, 27}),
+    label(CX, CY - 110, SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE, dateText),
+    sprite(settings_sprite, kGearRect),
+    icon(kWifiFrames, connectionState, kWifiRect),
+    image("/images/out_temp134x52_11.png", {93, 188, 134, 52},
+          {6, 1, 122, 50}),
+    image("/images/hum_press294x34.png", {93, 247, 294, 34}, {4, 0, 287, 34}),
+    image("/images/in_temp134x52.png", {254, 188, 134, 52}, {5, 1, 124, 50}),
+    label(CX - 62, CY + 55, SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          outdoorTempText),
+    label(CX, CY + 104, SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE, humPressText),
+    label(CX + 100, CY + 55, SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          indoorTempText),
+    // The one face of the screen's changing labels: a second one would be
+    // reloaded on every redraw.
+    label(CX, CY + 138, SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE, probeTempsText),
+};
+
+static constexpr HitArea kHomeHits[] = {
+    {1, {430, 270, 50, 50}, wrapperGoToSettings},
+    {2, {93, 80, 134, 52}, wrapperNextStation}, // Outdoor temperature box.
+};
+
+static constexpr WidgetDef kSettingsWidgets[] = {
+    label(CX, CY - 130, MEDIUM_BOLD_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "USTAWIENIA"),
+    label(CX - 85, CY - 78, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "Jasność automatyczna"),
+    label(CX - 140, CY - 52, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "Jasność: "),
+    label(CX - 49, CY - 26, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "Status Wifi/Połączenia z stacją: "),
+    label(CX - 83, CY + 116, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "Połącz z Wifi"),
+    label(CX + 81, CY + 116, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "Połącz z aplikacją"),
+    label(CX - 46, CY + 3, EXTRA_SMALL_FONT_NAME, TFT_LIGHTGREY, TFT_BLUE,
+          "Połączono z wifi oraz z modułem", isConnected),
+    label(CX - 122, CY + 30, EXTRA_SMALL_FONT_NAME, TFT_LIGHTGREY, TFT_BLUE,
+          "zewnętrznym", isConnected),
+    label(CX - 28, CY + 6, EXTRA_SMALL_FONT_NAME, TFT_RED, TFT_BROWN,
+          "Brak połączenia! Sprawdź połączenie", isDisconnected),
+    label(CX - 11, CY + 30, EXTRA_SMALL_FONT_NAME, TFT_RED, TFT_BROWN,
+          " z modułem zewnętrznym oraz siecią Wifi.", isDisconnected),
+    label(CX - 55, CY + 54, EXTRA_SMALL_FONT_NAME, TFT_DARKGREY, TFT_BLUE,
+          "Połączono z aplikacją", isPaired),
+    label(CX - 45, CY + 54, EXTRA_SMALL_FONT_NAME, TFT_RED, TFT_BROWN,
+          "Nie połączono jeszcze z aplikacją", isUnpaired),
+    icon(kWifiFrames, connectionState, kWifiRect),
+    image("/images/auto_brightness_switch27x26.png", {265, 68, 27, 26},
+          {2, 1, 23, 24}),
+    icon(kAutoBrightnessFrames, autoBrightnessState, {267, 70, 24, 24}),
+};
+
+static constexpr HitArea kSettingsHits[] = {
+    {10, {262, 208, 30, 30}, wrapperSwitchAutoBrightness},
+    {11, {0, 280, 40, 40}, wrapperGoToHome},
+    {12, {0, 0, 40, 40}, wrapperGoToAppConnection},
+    {13, {440, 0, 40, 40}, wrapperGoToWifiConnection},
+};
+
+static constexpr WidgetDef kAppConnectionWidgets[] = {
+    sprite(settings_sprite, kGearRect),
+    icon(kWifiFrames, wifiState, kWifiRect),
+    label(CX, CY - 130, MEDIUM_BOLD_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "POŁĄCZ Z APLIKACJĄ"),
+    label(CX - 72, CY - 90, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "1. Zarejestruj się w aplikacji:"),
+    label(CX - 30, CY - 65, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "http://vercel.meteo-app/register/"),
+    label(CX - 45, CY - 40, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "2. Przejdź do zakładki 'Parowanie':"),
+    label(CX, CY + 10, EXTRA_SMALL_FONT_NAME, TFT_GREEN, TFT_BLACK,
+          "Twój kod parowania:", hasPairingKey),
+    label(CX, CY + 45, MEDIUM_BOLD_FONT_NAME, TFT_GREEN, TFT_BLACK,
+          pairingKeyText),
+    label(CX, CY + 75, EXTRA_SMALL_FONT_NAME, TFT_LIGHTGREY, TFT_BLUE,
+          "(Wpisz ten kod w aplikacji)", hasPairingKey),
+    label(CX, CY + 10, EXTRA_SMALL_FONT_NAME, TFT_GREEN, TFT_BLACK,
+          "Urządzenie jest już powiązane", isPairedNoKey),
+    label(CX, CY + 35, EXTRA_SMALL_FONT_NAME, TFT_GREEN, TFT_BLACK,
+          "z Twoim kontem.", isPairedNoKey),
+    label(CX - 75, CY + 10, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "3. Kliknij przycisk poniżej,", isUnclaimed),
+    label(CX - 90, CY + 35, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "aby wygenerować kod.", isUnclaimed),
+};
+
+static constexpr WidgetDef kWifiConnectionWidgets[] = {
+    label(CX, CY - 130, MEDIUM_BOLD_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "POŁĄCZ Z WIFI"),
+    sprite(settings_sprite, kGearRect),
+    label(CX - 39, CY - 80, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "1. Połącz się do sieci Meteo-Setup"),
+    label(CX - 29, CY - 55, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "2. Jeśli nie zostaniesz automatycznie "),
+    label(CX - 1, CY - 30, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "przekierowany do portalu konfiguracyjnego "),
+    label(CX - 83, CY - 5, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "wpisz w przeglądarce: "),
+    label(CX - 93, CY + 20, EXTRA_SMALL_FONT_NAME, TFT_WHITE, TFT_BLUE,
+          "http://setup.meteo/"),
+    icon(kWifiFrames, wifiState, kWifiRect),
+};
+
+/// @brief Buttons of both connection screens.
+static constexpr HitArea kConnectionHits[] = {
+    {20, {0, 280, 40, 40}, wrapperGoToHome},
+    {21, {430, 270, 50, 50}, wrapperGoToSettings},
+};
+
+static_assert(layout::widgetsOnScreen(kHomeWidgets) &&
+                  layout::widgetsOnScreen(kSettingsWidgets) &&
+                  layout::widgetsOnScreen(kAppConnectionWidgets) &&
+                  layout::widgetsOnScreen(kWifiConnectionWidgets),
+              "Widget off the panel");
+static_assert(layout::hitAreasValid(kHomeHits) &&
+                  layout::hitAreasValid(kSettingsHits) &&
+                  layout::hitAreasValid(kConnectionHits),
+              "Invalid or overlapping buttons");
+
+static constexpr TouchGrid kHomeGrid = makeTouchGrid(kHomeHits);
+static constexpr TouchGrid kSettingsGrid = makeTouchGrid(kSettingsHits);
+static constexpr TouchGrid kConnectionGrid = makeTouchGrid(kConnectionHits);
+
+static constexpr ScreenLayout kHomeLayout =
+    layout::screen(kHomeWidgets, kHomeHits, kHomeGrid,
+                   wrapperGoToSettings);
+static constexpr ScreenLayout kSettingsLayout =
+    layout::screen(kSettingsWidgets, kSettingsHits, kSettingsGrid,
+                   nullptr, wrapperGoToHome);
+static constexpr ScreenLayout kAppConnectionLayout =
+    layout::screen(kAppConnectionWidgets, kConnectionHits, kConnectionGrid,
+                   nullptr, wrapperGoToSettings);
+static constexpr ScreenLayout kWifiConnectionLayout =
+    layout::screen(kWifiConnectionWidgets, kConnectionHits,
+                   kConnectionGrid, nullptr, wrapperGoToSettings);
+
 UIManager::UIManager(SensorManager *sensorMgr, NetworkManager *networkMgr)
-    : tft(), settingsIconSprite(&tft), _sensorMgr(sensorMgr),
-      _networkMgr(networkMgr) {
+    : tft(), _sensorMgr(sensorMgr), _networkMgr(networkMgr),
+      icons(&tft, ICON_CACHE_BUDGET_BYTES, ICON_CACHE_MAX_ENTRIES),
+      renderer(tft, png, icons), touch(tft), clock(rtc, sysClock) {
   uiInstance = this;
+  s_network = networkMgr;
   currentScreen = HOME_SCREEN;
 }
 
@@ -39,352 +323,99 @@ void UIManager::begin() {
   tft.init();
   tft.setRotation(1);
   tft.fillScreen(TFT_BLACK);
+  BandWriter::begin(tft);
+  touch.begin();
+  clock.begin();
   Serial.printf("[UI] Screen initialized: %dx%d\n", tft.width(), tft.height());
+  if (tft.width() != SCREEN_WIDTH || tft.height() != SCREEN_HEIGHT)
+    Serial.printf("[UI] Layouts are for %dx%d\n", SCREEN_WIDTH,
+                  SCREEN_HEIGHT);
 
   bgHome = new Background(BG_HOME_PATH);
   bgSettings = new Background(BG_SETTINGS_PATH);
   bgAccount = new Background(BG_ACCOUNT_PATH);
+  bgWifi = new Background(BG_ACCOUNT_PATH);
 
-  bgHome->addButton(Button(1, 430, 320, 50, 50, wrapperGoToSettings));
-
-  bgSettings->addButton(
-      Button(10, 262, 238, 30, 30, wrapperSwitchAutoBrightness));
-  bgSettings->addButton(Button(11, 0, 320, 40, 40, wrapperGoToHome));
-  bgSettings->addButton(Button(12, 0, 40, 40, 40, wrapperGoToAppConnection));
-  bgSettings->addButton(Button(13, 440, 40, 40, 40, wrapperGoToWifiConnection));
-
-  bgAccount->addButton(Button(20, 0, 320, 40, 40, wrapperGoToHome));
-  bgAccount->addButton(Button(21, 430, 320, 50, 50, wrapperGoToSettings));
+  bgHome->setLayout(kHomeLayout);
+  bgSettings->setLayout(kSettingsLayout);
+  bgAccount->setLayout(kAppConnectionLayout);
+  bgWifi->setLayout(kWifiConnectionLayout);
 
+  refreshView(_sensorMgr);
   changeScreen(HOME_SCREEN);
 }
 
 void UIManager::update() {
-  uint32_t ms = millis();
-
-  uint16_t tx = 0, ty = 0;
-  bool touched = tft.getTouch(&tx, &ty);
-  Background *activeBg = getActiveBackground();
-  if (activeBg) {
-    activeBg->handleTouch(touched ? (int16_t)tx : -1,
-                          touched ? (int16_t)ty : -1, touched);
+  // Labels show what the UI consumer reads: a reading past its max age is
+  // redrawn as a placeholder.
+  if (refreshView(_sensorMgr))
+    screenDataDirty = true;
+
+  {
+    PROFILE_SITE(PROFILE_SITE_TOUCH);
+    TouchEvent event;
+    Background *activeBg = getActiveBackground();
+    if (touch.poll(event) && activeBg)
+      activeBg->handleTouch(event);
   }
 
-  if (lastDataReceivedMs != 0 && (ms - lastDataReceivedMs > 120000UL)) {
+  // The link is lost once no station that was heard is fresh any more.
+  const SensorSnapshot &sensors = s_view;
+  bool heard = false, fresh = false;
+  for (uint8_t i = 0; i < sensors.stations.count(); i++) {
+    const Reading<struct_message> &r = sensors.stations[i].reading;
+    heard |= r.valid;
+    fresh |= r.valid && !r.stale;
+  }
+  if (heard && !fresh) {
     if (connectionGood) {
       connectionGood = false;
-      updateConnectionIcon(false);
-
-      if (currentScreen == SETTINGS_SCREEN)
-        changeScreen(SETTINGS_SCREEN);
+      renderer.drawChanges(*getActiveBackground());
     }
   }
 
   if (currentScreen == HOME_SCREEN && screenDataDirty) {
-    drawHomeScreenDynamicData();
+    TRACE_SCOPE(TRACE_DRAW_DYNAMIC);
+    PROFILE_SITE(PROFILE_SITE_DRAW_DYNAMIC);
+    HEAP_TRACK_SCOPE(HEAP_SITE_DRAW_DYNAMIC);
+    renderer.drawChanges(*bgHome);
     screenDataDirty = false;
   }
 
-  if (ms - lastDrawMs >= 2000) {
-    lastDrawMs = ms;
-
-    if (currentScreen == APP_CONNECTION_SCREEN ||
-        currentScreen == WIFI_CONNECTION_SCREEN) {
-      updateConnectionIcon(_networkMgr->isWifiConnected());
-    } else if (currentScreen == SETTINGS_SCREEN) {
-      updateConnectionIcon(connectionGood);
-    } else if (currentScreen == HOME_SCREEN) {
-      updateConnectionIcon(connectionGood);
-      drawHomeScreenClockAndDate();
-    }
+  // Redraw only at clock boundaries and on status changes.
+  uint8_t clockEvents = clock.poll();
+  if (clockEvents || statusDirty) {
+    statusDirty = false;
+    TRACE_SCOPE(TRACE_DRAW_CLOCK);
+    PROFILE_SITE(PROFILE_SITE_DRAW_CLOCK);
+    HEAP_TRACK_SCOPE(HEAP_SITE_DRAW_CLOCK);
+    if (clockEvents & CLOCK_DAY)
+      Serial.printf("[UI] New day: %d.%d.%d\n", now.day(), now.month(),
+                    now.year());
+    renderer.drawChanges(*getActiveBackground());
   }
 }
 
 void UIManager::changeScreen(SCREEN s) {
-  now = rtc.now();
+  TRACE_SCOPE(TRACE_CHANGE_SCREEN, s);
+  PROFILE_SITE(PROFILE_SITE_CHANGE_SCREEN);
   currentScreen = s;
-  int16_t cx = tft.width() / 2;
-  int16_t cy = tft.height() / 2;
 
-  Background *bg = getActiveBackground();
-  if (!bg->draw(tft, png, true)) {
+  if (!renderer.drawAll(*getActiveBackground())) {
     Serial.println("[UI] Failed to draw background PNG");
     return;
   }
 
-  switch (s) {
-  case HOME_SCREEN: {
-    lastDrawnMinute = -1;
-    lastDrawnDay = -1;
-
-    drawHomeScreenClockAndDate();
-
-    drawIconLazy("/images/out_temp134x52_11.png", 93, 188, TFT_BLACK);
-    drawIconLazy("/images/in_temp134x52.png", 254, 188, TFT_BLACK);
-    drawIconLazy("/images/hum_press294x34.png", 93, 247, TFT_BLACK);
+  if (s == HOME_SCREEN)
+    screenDataDirty = true; // Re-read the indoor sensor.
 
-    settingsIconSprite.createSprite(30, 30);
-    settingsIconSprite.setSwapBytes(true);
-    settingsIconSprite.pushImage(0, 0, 30, 30, settings_sprite);
-    settingsIconSprite.pushSprite(440, 5, TFT_BLACK);
-    settingsIconSprite.deleteSprite();
-
-    screenDataDirty = true;
-    updateConnectionIcon(connectionGood);
-    homeStaticDrawn = false;
-    break;
-  }
-
-  case APP_CONNECTION_SCREEN: {
-
-    settingsIconSprite.createSprite(30, 30);
-    settingsIconSprite.setSwapBytes(true);
-    settingsIconSprite.pushImage(0, 0, 30, 30, settings_sprite);
-    settingsIconSprite.pushSprite(440, 5, TFT_BLACK);
-    settingsIconSprite.deleteSprite();
-
-    updateConnectionIcon(connectionGood);
-
-    tft.loadFont(MEDIUM_BOLD_FONT_NAME);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("POŁĄCZ Z APLIKACJĄ", cx, cy - 130);
-    tft.unloadFont();
-
-    tft.loadFont(EXTRA_SMALL_FONT_NAME, LittleFS);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.drawString("1. Zarejestruj się w aplikacji:", cx - 72, cy - 90);
-    tft.drawString("http://vercel.meteo-app/register/", cx - 30, cy - 65);
-    tft.drawString("2. Przejdź do zakładki 'Parowanie':", cx - 45, cy - 40);
-
-    if (AppConnectionKey.length() > 0) {
-
-      tft.setTextColor(TFT_GREEN, TFT_BLACK);
-      tft.drawString("Twój kod parowania:", cx, cy + 10);
-
-      tft.loadFont(MEDIUM_BOLD_FONT_NAME);
-      tft.drawString(AppConnectionKey, cx, cy + 45);
-      tft.unloadFont();
-
-      tft.loadFont(EXTRA_SMALL_FONT_NAME, LittleFS);
-      tft.setTextColor(TFT_LIGHTGREY, TFT_BLUE);
-      tft.drawString("(Wpisz ten kod w aplikacji)", cx, cy + 75);
-
-    } else if (ownerIdentityId.length() > 0) {
-
-      tft.setTextColor(TFT_GREEN, TFT_BLACK);
-      tft.drawString("Urządzenie jest już powiązane", cx, cy + 10);
-      tft.drawString("z Twoim kontem.", cx, cy + 35);
-
-    } else {
-      tft.setTextColor(TFT_WHITE, TFT_BLUE);
-      tft.drawString("3. Kliknij przycisk poniżej,", cx - 75, cy + 10);
-      tft.drawString("aby wygenerować kod.", cx - 90, cy + 35);
-    }
-    tft.unloadFont();
-    break;
-  }
-
-  case WIFI_CONNECTION_SCREEN: {
-
-    tft.loadFont(MEDIUM_BOLD_FONT_NAME);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("POŁĄCZ Z WIFI", cx, cy - 130);
-    tft.unloadFont();
-
-    settingsIconSprite.createSprite(30, 30);
-    settingsIconSprite.setSwapBytes(true);
-    settingsIconSprite.pushImage(0, 0, 30, 30, settings_sprite);
-    settingsIconSprite.pushSprite(440, 5, TFT_BLACK);
-    settingsIconSprite.deleteSprite();
-
-    tft.loadFont(EXTRA_SMALL_FONT_NAME, LittleFS);
-    tft.drawString("1. Połącz się do sieci Meteo-Setup", cx - 39, cy - 80);
-    tft.drawString("2. Jeśli nie zostaniesz automatycznie ", cx - 29, cy - 55);
-    tft.drawString("przekierowany do portalu konfiguracyjnego ", cx - 1,
-                   cy - 30);
-    tft.drawString("wpisz w przeglądarce: ", cx - 83, cy - 5);
-    tft.drawString("http://setup.meteo/", cx - 93, cy + 20);
-    tft.unloadFont();
-
-    updateConnectionIcon(connectionGood);
-
-    if (!_networkMgr->isConfigPortalActive()) {
-      _networkMgr->startConfigPortal();
-    }
-    break;
-  }
-
-  case SETTINGS_SCREEN: {
-
-    tft.loadFont(MEDIUM_BOLD_FONT_NAME);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("USTAWIENIA", cx, cy - 130);
-    tft.unloadFont();
-
-    tft.loadFont(EXTRA_SMALL_FONT_NAME, LittleFS);
-    tft.drawString("Jasność automatyczna", cx - 85, cy - 78);
-    tft.drawString("Jasność: ", cx - 140, cy - 52);
-    tft.drawString("Status Wifi/Połączenia z stacją: ", cx - 49, cy - 26);
-    tft.drawString("Połącz z Wifi", cx - 83, cy + 116);
-    tft.drawString("Połącz z aplikacją", cx + 81, cy + 116);
-    tft.unloadFont();
-
-    drawConnectionStatusText();
-    drawAccountConnectionStatusText();
-    updateConnectionIcon(connectionGood);
-    updateAutoBrightnessIcon(autoBrightness);
-    break;
-  }
-  default:
-    break;
+  if (s == WIFI_CONNECTION_SCREEN && !_networkMgr->isConfigPortalActive()) {
+    icons.clear(); // The portal's web server needs the heap.
+    renderer.releaseFont();
+    _networkMgr->startConfigPortal();
   }
 }
 
-void UIManager::drawHomeScreenDynamicData() {
-  float t = _sensorMgr->readIndoorTemp();
-  if (!isnan(t)) {
-    homeTemperatureRead = t;
-  }
-
-  String sIn = String(homeTemperatureRead, 1) + " *C";
-  String sOut = String(Data.outdoorTemperatureRead / 10.0, 1) + " C";
-  String sHP = "Wilg.:" + String(Data.humidityRead) + " %      " +
-               String(Data.pressureRead) + " hPa";
-
-  int16_t cx = tft.width() / 2;
-  int16_t cy = tft.height() / 2;
-
-  tft.loadFont(SMALL_FONT_NAME, LittleFS);
-  tft.setTextColor(TFT_WHITE, TFT_BLUE);
-  tft.setTextDatum(MC_DATUM);
-
-  drawIconLazy("/images/out_temp134x52_11.png", 93, 188, TFT_BLACK);
-  drawIconLazy("/images/in_temp134x52.png", 254, 188, TFT_BLACK);
-  drawIconLazy("/images/hum_press294x34.png", 93, 247, TFT_BLACK);
-
-  tft.drawString(sOut, cx - 62, cy + 55);
-  tft.drawString(sHP, cx, cy + 104);
-  tft.drawString(sIn, cx + 100, cy + 55);
-
-  tft.unloadFont();
-}
-
-void UIManager::drawHomeScreenClockAndDate() {
-  int16_t cx = tft.width() / 2;
-  int16_t cy = tft.height() / 2;
-
-  now = rtc.now();
-
-  int m = now.minute();
-  if (m != lastDrawnMinute) {
-    lastDrawnMinute = m;
-
-    drawIconLazy("/images/time295x111.png", 93, 67, TFT_BLACK);
-
-    String timeStr = "";
-    timeStr += String(now.hour()) + ":";
-    if (now.minute() < 10)
-      timeStr += "0";
-    timeStr += String(now.minute());
-
-    tft.loadFont(TIME_FONT_NAME, LittleFS);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString(timeStr, cx, cy - 33);
-    tft.unloadFont();
-  }
-
-  int d = now.day();
-  if (d != lastDrawnDay || lastDrawnDay == -1) {
-    lastDrawnDay = d;
-
-    drawIconLazy("/images/date265x29.png", 110, 33, TFT_BLACK);
-
-    const char *daysOfWeek[] = {"Niedziela", "Poniedzialek", "Wtorek", "Sroda",
-                                "Czwartek",  "Piatek",       "Sobota"};
-    int dayIdx = now.dayOfTheWeek();
-    if (dayIdx < 0 || dayIdx > 6)
-      dayIdx = 0;
-
-    String dateDayStr = String(now.day()) + "." + String(now.month()) + "." +
-                        String(now.year()) + ", " + String(daysOfWeek[dayIdx]);
-
-    tft.loadFont(SMALL_FONT_NAME, LittleFS);
-    tft.setTextColor(TFT_WHITE, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString(dateDayStr, cx, cy - 110);
-    tft.unloadFont();
-  }
-}
-
-void UIManager::drawIconLazy(const char *path, int x, int y, uint16_t bg) {
-  Icon ic(&tft, path, 0, 0, 0);
-  if (ic.loadFromFS()) {
-    ic.draw(x, y, bg);
-  }
-}
-
-void UIManager::updateAutoBrightnessIcon(bool status) {
-  drawIconLazy("/images/auto_brightness_switch27x26.png", 265, 68, TFT_BLACK);
-  tft.setSwapBytes(true);
-  if (status) {
-    tft.pushImage(267, 70, 24, 24, autoBrightnessOn_Sprite, TFT_BLACK);
-  } else {
-    tft.pushImage(267, 70, 24, 24, autoBrightnessOff_Sprite, TFT_BLACK);
-  }
-  tft.setSwapBytes(false);
-}
-
-void UIManager::updateConnectionIcon(bool status) {
-  tft.setSwapBytes(true);
-  if (status) {
-    tft.pushImage(400, 5, 30, 30, wifitrue_sprite, TFT_BLACK);
-  } else {
-    tft.pushImage(400, 5, 30, 30, wifiFalse_Sprite, TFT_BLACK);
-  }
-  tft.setSwapBytes(false);
-}
-
-void UIManager::drawConnectionStatusText() {
-  int16_t cx = tft.width() / 2;
-  int16_t cy = tft.height() / 2;
-
-  tft.loadFont(EXTRA_SMALL_FONT_NAME, LittleFS);
-
-  if (connectionGood) {
-    tft.setTextColor(TFT_LIGHTGREY, TFT_BLUE);
-    tft.drawString("Połączono z wifi oraz z modułem", cx - 46, cy + 3);
-    tft.drawString("zewnętrznym", cx - 122, cy + 30);
-  } else {
-    tft.setTextColor(TFT_RED, TFT_BROWN);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Brak połączenia! Sprawdź połączenie", cx - 28, cy + 6);
-    tft.drawString(" z modułem zewnętrznym oraz siecią Wifi.", cx - 11,
-                   cy + 30);
-  }
-  tft.unloadFont();
-}
-
-void UIManager::drawAccountConnectionStatusText() {
-  int16_t cx = tft.width() / 2;
-  int16_t cy = tft.height() / 2;
-  tft.loadFont(EXTRA_SMALL_FONT_NAME, LittleFS);
-
-  if (ownerIdentityId.length() > 0) {
-    tft.setTextColor(TFT_DARKGREY, TFT_BLUE);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Połączono z aplikacją", cx - 55, cy + 54);
-  } else {
-    tft.setTextColor(TFT_RED, TFT_BROWN);
-    tft.setTextDatum(MC_DATUM);
-    tft.drawString("Nie połączono jeszcze z aplikacją", cx - 45, cy + 54);
-  }
-  tft.unloadFont();
-}
-
 Background *UIManager::getActiveBackground() {
   switch (currentScreen) {
   case HOME_SCREEN:
@@ -394,7 +425,7 @@ Background *UIManager::getActiveBackground() {
   case APP_CONNECTION_SCREEN:
     return bgAccount;
   case WIFI_CONNECTION_SCREEN:
-    return bgAccount;
+    return bgWifi;
   default:
     return bgHome;
   }
@@ -411,7 +442,16 @@ void UIManager::onBtnGoToHome() {
 
 void UIManager::onBtnSwitchAutoBrightness() {
   autoBrightness = !autoBrightness;
-  updateAutoBrightnessIcon(autoBrightness);
+  renderer.drawChanges(*bgSettings);
+}
+
+void UIManager::onBtnNextStation() {
+  uint8_t count = _sensorMgr->snapshot().stations.count();
+  if (count < 2)
+    return;
+  _station = (_station + 1) % count;
+  Serial.printf("[UI] Action: Show Station %u\n", _station + 1);
+  renderer.drawChanges(*bgHome);
 }
 
 void UIManager::onBtnGoToWifiConnection() {
@@ -423,5 +463,5 @@ void UIManager::onBtnGoToAppConnection() {
   Serial.println("[UI] Action: Go To App Connection");
   changeScreen(APP_CONNECTION_SCREEN);
   _networkMgr->startClaimIfNeeded();
-  changeScreen(APP_CONNECTION_SCREEN);
+  renderer.drawChanges(*bgAccount);
 }
\ No newline at end of file
@@ -10,11 +10,19 @@
 #include <TFT_eSPI.h>
 
 #include "Background.h"
+#include "ClockScheduler.h"
 #include "Config.h"
 #include "Globals.h"
+#include "HeapTracker.h"
 #include "Icon.h"
+#include "IconCache.h"
 #include "NetworkManager.h"
+#include "Profiler.h"
+#include "Renderer.h"
 #include "SensorManager.h"
+#include "TouchInput.h"
+#include "Trace.h"
+#include "Widget.h"
 
 #include "autoBrightnessOff_Sprite.h"
 #include "autoBrightnessOn_Sprite.h"
@@ -57,6 +65,13 @@ public:
   void onBtnGoToWifiConnection();
   void onBtnGoToAppConnection();
   void onBtnSwitchAutoBrightness();
+  void onBtnNextStation();
+
+  /// @brief Index of the outdoor station shown on the home screen.
+  uint8_t selectedStation() const { return _station; }
+
+  /// @brief Resident icon sprites (for diagnostics).
+  IconCache &iconCache() { return icons; }
 
 private:
   TFT_eSPI tft;                ///< TFT driver.
@@ -66,22 +81,15 @@ private:
 
   Background *bgHome;     ///< Home screen background.
   Background *bgSettings; ///< Settings screen background.
-  Background *bgAccount;  ///< Account/WiFi screen background.
-
-  TFT_eSprite settingsIconSprite; ///< Helper sprite for settings icon.
-  SCREEN currentScreen;           ///< Currently active screen.
+  Background *bgAccount;  ///< App connection screen background.
+  Background *bgWifi;     ///< WiFi connection screen background.
 
-  uint32_t lastDrawMs = 0;      ///< Timestamp of last UI redraw.
-  int lastDrawnMinute = -1;     ///< Last drawn minute value (to avoid redraws).
-  int lastDrawnDay = -1;        ///< Last drawn day value.
-  bool homeStaticDrawn = false; ///< Flag if static elements are drawn.
+  IconCache icons;      ///< Decoded icons kept between draws.
+  Renderer renderer;    ///< Draws the widget trees.
+  TouchInput touch;     ///< PENIRQ-driven gestures.
+  ClockScheduler clock; ///< Minute/day boundaries from the RTC alarm.
+  SCREEN currentScreen; ///< Currently active screen.
+  uint8_t _station = 0; ///< Station on the home screen.
 
   Background *getActiveBackground();
-  void drawIconLazy(const char *path, int x, int y, uint16_t bg = TFT_BLACK);
-  void updateAutoBrightnessIcon(bool status);
-  void updateConnectionIcon(bool status);
-  void drawConnectionStatusText();
-  void drawAccountConnectionStatusText();
-  void drawHomeScreenDynamicData();
-  void drawHomeScreenClockAndDate();
 };
\ No newline at end of file
@@ -0,0 +1,91 @@
+/**
+ * @file Widget.cpp
+ * @brief Implementation of the widget classes.
+ */
+
+#include "Widget.h"
+#include "Renderer.h"
+
+LabelWidget::LabelWidget(int16_t x, int16_t y, const char *font, uint16_t fg,
+                         uint16_t bg, const char *text, Condition visible)
+    : Widget({0, 0, 0, 0}), _x(x), _y(y), _font(font), _fg(fg),
+      _bg(bg), _text(text), _source(nullptr), _visible(visible),
+      _atlas(nullptr) {}
+
+LabelWidget::LabelWidget(int16_t x, int16_t y, const char *font, uint16_t fg,
+                         uint16_t bg, TextSource source,
+                         const GlyphAtlas *atlas)
+    : Widget({0, 0, 0, 0}), _x(x), _y(y), _font(font), _fg(fg),
+      _bg(bg), _text(nullptr), _source(source), _visible(nullptr),
+      _atlas(atlas) {}
+
+void LabelWidget::invalidate() {
+  Widget::invalidate();
+  _damage.invalidate();
+}
+
+const TextFace &LabelWidget::face(Renderer &r, const String &text) const {
+  if (_atlas && (!_font || _atlas->covers(text)))
+    return *_atlas;
+  r.useFont(_font);
+  return r.fontFace();
+}
+
+Rect LabelWidget::poll(Renderer &r) {
+  bool shown = !_visible || _visible();
+  if (!_source && !_dirty && shown == _shown)
+    return {0, 0, 0, 0}; // Fixed text, nothing to re-read.
+  _shown = shown;
+  _dirty = false;
+
+  String text;
+  if (shown) {
+    if (_source)
+      _source(text);
+    else
+      text = _text;
+  }
+  if (_damage.unchanged(text))
+    return {0, 0, 0, 0};
+
+  Rect damage =
+      _damage.update(face(r, text), text, _x, _y, Rect{0, 0, 0, 0});
+  _bounds = _damage.box();
+  return damage;
+}
+
+void LabelWidget::draw(Renderer &r) {
+  const String &text = _damage.text();
+  if (text.length() == 0)
+    return;
+  const TextFace &f = face(r, text);
+  r.tft().setTextColor(_fg, _bg);
+  f.drawCentred(r.tft(), text, _x, _y);
+}
+
+void ImageWidget::draw(Renderer &r) {
+  r.drawImage(_path, _bounds.x, _bounds.y);
+}
+
+/// @brief Pushes a native RGB565 bitmap with black as the transparent key.
+static void pushKeyed(TFT_eSPI &tft, const Rect &at, const uint16_t *pixels) {
+  bool swap = tft.getSwapBytes();
+  tft.setSwapBytes(true);
+  tft.pushImage(at.x, at.y, at.w, at.h, pixels, TFT_BLACK);
+  tft.setSwapBytes(swap);
+}
+
+void SpriteWidget::draw(Renderer &r) { pushKeyed(r.tft(), _bounds, _pixels); }
+
+Rect IconWidget::poll(Renderer &) {
+  uint8_t state = _source();
+  if (state >= _count)
+    state = _count - 1;
+  bool changed = state != _shown;
+  _shown = state;
+  return pollFixed(changed);
+}
+
+void IconWidget::draw(Renderer &r) {
+  pushKeyed(r.tft(), _bounds, _frames[_shown]);
+}
@@ -0,0 +1,170 @@
+/**
+ * @file Widget.h
+ * @brief Retained-mode elements of a screen, drawn over its Background.
+ */
+
+#pragma once
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+
+#include "Damage.h"
+#include "GlyphAtlas.h"
+
+class Renderer;
+
+typedef void (*TextSource)(String &out); ///< Fills in a label's text.
+typedef bool (*Condition)();             ///< Whether a widget is shown.
+typedef uint8_t (*StateSource)();        ///< Frame an icon shows.
+
+/**
+ * @class Widget
+ * @brief Base of all screen elements.
+ */
+class Widget {
+public:
+  virtual ~Widget() {}
+
+  /// @brief Area the widget covers on screen.
+  const Rect &bounds() const { return _bounds; }
+
+  /**
+   * @brief Part of bounds() the widget paints without transparent pixels,
+   * so the background under it need not be redrawn (empty if none).
+   */
+  const Rect &opaque() const { return _opaque; }
+
+  /// @brief Forgets what is on screen; the next poll() reports all of it.
+  virtual void invalidate() { _dirty = true; }
+
+  /**
+   * @brief Re-reads the bound source.
+   * @return Area to re-composite, empty if nothing changed.
+   */
+  virtual Rect poll(Renderer &r) = 0;
+
+  /// @brief Draws the current state (clipped to the renderer's viewport).
+  virtual void draw(Renderer &r) = 0;
+
+protected:
+  Widget(const Rect &bounds, const Rect &opaque = {0, 0, 0, 0})
+      : _bounds(bounds), _opaque(opaque) {}
+
+  /// @brief poll() for widgets whose bounds never move.
+  Rect pollFixed(bool changed) {
+    bool damaged = _dirty || changed;
+    _dirty = false;
+    return damaged ? _bounds : Rect{0, 0, 0, 0};
+  }
+
+  Rect _bounds;       ///< Area covered on screen.
+  Rect _opaque;       ///< Area painted without transparency.
+  bool _dirty = true; ///< Screen content unknown.
+};
+
+/**
+ * @class LabelWidget
+ * @brief One line of text centred on an anchor (MC_DATUM).
+ *
+ * The text is either fixed or bound to a TextSource; an optional Condition
+ * hides it. Bounds follow the text (TextDamage::box()), and a change only
+ * damages the glyphs that differ.
+ */
+class LabelWidget : public Widget {
+public:
+  /// @brief Label with fixed @p text, shown while @p visible (if given).
+  LabelWidget(int16_t x, int16_t y, const char *font, uint16_t fg,
+              uint16_t bg, const char *text, Condition visible = nullptr);
+
+  /**
+   * @brief Label showing whatever @p source returns, drawn from @p atlas
+   * when it has every character, otherwise in @p font. With no @p font the
+   * atlas draws every text and skips characters it lacks.
+   */
+  LabelWidget(int16_t x, int16_t y, const char *font, uint16_t fg,
+              uint16_t bg, TextSource source,
+              const GlyphAtlas *atlas = nullptr);
+
+  void invalidate() override;
+  Rect poll(Renderer &r) override;
+  void draw(Renderer &r) override;
+
+private:
+  /// @brief Face that draws @p text (loads the font if needed).
+  const TextFace &face(Renderer &r, const String &text) const;
+
+  int16_t _x;               ///< Anchor X.
+  int16_t _y;               ///< Anchor Y.
+  const char *_font;        ///< Smooth font (see Renderer::useFont()).
+  uint16_t _fg;             ///< Text colour.
+  uint16_t _bg;             ///< Colour the glyph edges blend into.
+  const char *_text;        ///< Fixed text, or nullptr.
+  TextSource _source;       ///< Bound text, or nullptr.
+  Condition _visible;       ///< Shown only while true (nullptr: always).
+  const GlyphAtlas *_atlas; ///< Pre-rendered glyphs, or nullptr.
+  TextDamage _damage;       ///< Text on screen.
+  bool _shown = false;      ///< Visibility last polled.
+};
+
+/**
+ * @class ImageWidget
+ * @brief A LittleFS image (PNG or its .rle) drawn through the IconCache,
+ * black transparent.
+ */
+class ImageWidget : public Widget {
+public:
+  /**
+   * @param path Image file.
+   * @param bounds Where the image is drawn (its size).
+   * @param opaque Rectangle of the image without key pixels, relative to
+   * its top-left corner, e.g. inside the rounded corners of an eraser.
+   */
+  ImageWidget(const char *path, const Rect &bounds,
+              const Rect &opaque = {0, 0, 0, 0})
+      : Widget(bounds, {(int16_t)(bounds.x + opaque.x),
+                        (int16_t)(bounds.y + opaque.y), opaque.w, opaque.h}),
+        _path(path) {}
+
+  Rect poll(Renderer &) override { return pollFixed(false); }
+  void draw(Renderer &r) override;
+
+private:
+  const char *_path; ///< Image file.
+};
+
+/**
+ * @class SpriteWidget
+ * @brief A fixed RGB565 bitmap from flash, black transparent.
+ */
+class SpriteWidget : public Widget {
+public:
+  SpriteWidget(const uint16_t *pixels, const Rect &bounds)
+      : Widget(bounds), _pixels(pixels) {}
+
+  Rect poll(Renderer &) override { return pollFixed(false); }
+  void draw(Renderer &r) override;
+
+private:
+  const uint16_t *_pixels; ///< Native RGB565, bounds.w x bounds.h.
+};
+
+/**
+ * @class IconWidget
+ * @brief A status icon: one of several RGB565 bitmaps from flash, picked
+ * by a StateSource, black transparent.
+ */
+class IconWidget : public Widget {
+public:
+  IconWidget(const uint16_t *const *frames, uint8_t count,
+             StateSource source, const Rect &bounds)
+      : Widget(bounds), _frames(frames), _count(count),
+        _source(source) {}
+
+  Rect poll(Renderer &) override;
+  void draw(Renderer &r) override;
+
+private:
+  const uint16_t *const *_frames; ///< Bitmaps, bounds.w x bounds.h each.
+  uint8_t _count;                 ///< Entries in _frames.
+  StateSource _source;            ///< Selects the frame.
+  uint8_t _shown = 0;             ///< Frame last polled.
+};
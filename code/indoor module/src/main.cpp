@@ -10,23 +10,24 @@
 
 #include "Config.h"
 #include "Globals.h"
+#include "HeapTracker.h"
 #include "NetworkManager.h"
+#include "Profiler.h"
 #include "SensorManager.h"
+#include "SystemClock.h"
 #include "UIManager.h"
 
-struct_message telemetryData;             ///< ESP-NOW telemetryData buffer
-float homeTemperatureRead = 0.0; ///< Local temperature
-volatile bool newDataReceived = false;
 volatile bool screenDataDirty = false;
+volatile bool statusDirty = false;
 bool connectionGood = false;
 bool autoBrightness = false;
 String ownerIdentityId = "";
 String AppConnectionKey = "";
 RTC_DS3231 rtc;
+SystemClock sysClock(rtc);
 DateTime now;
 
-volatile uint32_t lastDataReceivedMs = 0; ///< Timeout tracker
-PNG png;                                  ///< Global PNG decoder instance
+PNG png; ///< Global PNG decoder instance
 
 SensorManager *sensorMgr = nullptr;
 NetworkManager *netMgr = nullptr;
@@ -61,17 +62,63 @@ void setup() {
   Serial.println("[MAIN] System Started Successfully");
 }
 
+/**
+ * @brief Handles single-character diagnostic commands arriving on Serial.
+ */
+static void handleSerialCommands() {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    switch (c) {
+#if LOOP_PROFILER_ENABLED
+    case PROFILER_DUMP_KEY:
+      loopProfiler.dump();
+      break;
+#endif
+    case PROFILER_RESET_KEY:
+#if LOOP_PROFILER_ENABLED
+      loopProfiler.reset();
+#endif
+#ifdef METEO_HEAP_TRACK
+      heapTracker.reset();
+#endif
+      if (uiMgr)
+        uiMgr->iconCache().resetStats();
+      Serial.println("[MAIN] Diagnostics reset");
+      break;
+#ifdef METEO_HEAP_TRACK
+    case HEAP_DUMP_KEY:
+      heapTracker.dump();
+      break;
+#endif
+    case ICON_CACHE_DUMP_KEY:
+      if (uiMgr)
+        uiMgr->iconCache().dump();
+      break;
+    default:
+      break;
+    }
+  }
+}
+
 /**
  * @brief Main Loop.
  */
 void loop() {
-  if (netMgr)
+  if (netMgr) {
+    PROFILE_STAGE(PROFILE_STAGE_NET);
     netMgr->loop();
+  }
 
-  if (sensorMgr)
+  if (sensorMgr) {
+    PROFILE_STAGE(PROFILE_STAGE_SENSOR);
     sensorMgr->update();
+  }
 
-  if (uiMgr)
+  if (uiMgr) {
+    PROFILE_STAGE(PROFILE_STAGE_UI);
     uiMgr->update();
+  }
+
+  handleSerialCommands();
   delay(10);
 }
@@ -0,0 +1,42 @@
+/**
+ * @file test_session.cpp
+ * @brief Publish cycles of NetworkManager on the simulated radio.
+ */
+
+#include <unity.h>
+
+#include "Firmware.h"
+
+namespace {
+/// @brief Publishes @p readings readings in the given session mode.
+void publishReadings(bool persistent, uint32_t readings) {
+  netMgr->setPersistentSession(persistent);
+  netMgr->loop();
+  host::mqttResetStats();
+  for (uint32_t i = 0; i < readings; i++) {
+    bench::injectReading(bench::sampleReading(i));
+    netMgr->loop();
+    // The soft-AP is only for the config portal.
+    TEST_ASSERT_EQUAL(0, WiFi.getMode() & WIFI_AP);
+  }
+  TEST_ASSERT_EQUAL_UINT32(readings, host::mqttPublishCount());
+}
+} // namespace
+
+void setUp() { bench::bootFirmware(); }
+void tearDown() { netMgr->setPersistentSession(NET_PERSISTENT_SESSION); }
+
+void test_persistent_session_publishes_in_sta_mode() {
+  publishReadings(true, 4);
+}
+
+void test_reconnect_per_reading_publishes_in_sta_mode() {
+  publishReadings(false, 4);
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_persistent_session_publishes_in_sta_mode);
+  RUN_TEST(test_reconnect_per_reading_publishes_in_sta_mode);
+  return UNITY_END();
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_wire.cpp
+ * @brief ESP-NOW frame decoding (MeteoWire.h) and Station::trackSeq().
+ */
+
+#include <unity.h>
+
+#include "MeteoWire.h"
+#include "StationTable.h"
+
+namespace {
+struct_message reading() {
+  struct_message m = {};
+  m.humidityRead = 41;
+  m.outdoorTemperatureRead = -34;
+  m.pressureRead = 1006;
+  m.uvIndexRead = 3;
+  return m;
+}
+
+/// @brief The padded struct the first firmware sent.
+void encodeV1(const struct_message &m, uint8_t *buf) {
+  memset(buf, 0, METEO_WIRE_V1_SIZE);
+  buf[0] = m.humidityRead;
+  memcpy(buf + 2, &m.outdoorTemperatureRead, 2);
+  memcpy(buf + 4, &m.pressureRead, 2);
+  buf[6] = m.uvIndexRead;
+}
+
+void assertReading(const struct_message &expected,
+                   const struct_message &actual) {
+  TEST_ASSERT_EQUAL_UINT8(expected.humidityRead, actual.humidityRead);
+  TEST_ASSERT_EQUAL_INT16(expected.outdoorTemperatureRead,
+                          actual.outdoorTemperatureRead);
+  TEST_ASSERT_EQUAL_UINT16(expected.pressureRead, actual.pressureRead);
+  TEST_ASSERT_EQUAL_UINT8(expected.uvIndexRead, actual.uvIndexRead);
+}
+} // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_v2_round_trip() {
+  struct_message m = reading();
+  WireFrameV2 f = wireEncode(m, 40000, WIRE_FLAG_RESTART);
+  WireReading r{};
+  TEST_ASSERT_EQUAL(WIRE_OK, wireDecode((const uint8_t *)&f, sizeof(f), r));
+  TEST_ASSERT_EQUAL_UINT8(METEO_WIRE_VERSION, r.version);
+  TEST_ASSERT_EQUAL_UINT16(40000, r.seq);
+  TEST_ASSERT_EQUAL_UINT8(WIRE_FLAG_RESTART, r.flags);
+  assertReading(m, r.data);
+}
+
+void test_v2_bit_flip_fails_crc() {
+  WireFrameV2 f = wireEncode(reading(), 7);
+  uint8_t *p = (uint8_t *)&f;
+  for (size_t i = 0; i < sizeof(f); i++) {
+    p[i] ^= 0x10;
+    WireReading r{};
+    WireStatus status = wireDecode(p, sizeof(f), r);
+    TEST_ASSERT_TRUE(status == WIRE_BAD_CRC ||
+                     (i == 0 && status == WIRE_BAD_VERSION));
+    p[i] ^= 0x10;
+  }
+}
+
+void test_v2_unknown_version_is_rejected() {
+  WireFrameV2 f = wireEncode(reading(), 7);
+  f.version = METEO_WIRE_VERSION + 1;
+  WireReading r{};
+  TEST_ASSERT_EQUAL(WIRE_BAD_VERSION,
+                    wireDecode((const uint8_t *)&f, sizeof(f), r));
+  TEST_ASSERT_EQUAL(WIRE_BAD_LENGTH,
+                    wireDecode((const uint8_t *)&f, sizeof(f) - 1, r));
+}
+
+void test_v1_reading_decodes() {
+  struct_message m = reading();
+  uint8_t buf[METEO_WIRE_V1_SIZE];
+  encodeV1(m, buf);
+  WireReading r{};
+  TEST_ASSERT_EQUAL(WIRE_OK, wireDecode(buf, sizeof(buf), r));
+  TEST_ASSERT_EQUAL_UINT8(1, r.version);
+  assertReading(m, r.data);
+
+  // No BME280: the old firmware sent zero pressure.
+  m.pressureRead = 0;
+  encodeV1(m, buf);
+  TEST_ASSERT_EQUAL(WIRE_OK, wireDecode(buf, sizeof(buf), r));
+}
+
+void test_v1_junk_is_implausible() {
+  const uint8_t junk[METEO_WIRE_V1_SIZE] = {0xA5, 0xA5, 0xA5, 0xA5,
+                                            0xA5, 0xA5, 0xA5, 0xA5};
+  WireReading r{};
+  TEST_ASSERT_EQUAL(WIRE_IMPLAUSIBLE, wireDecode(junk, sizeof(junk), r));
+
+  struct_message m = reading();
+  uint8_t buf[METEO_WIRE_V1_SIZE];
+  m.humidityRead = 101;
+  encodeV1(m, buf);
+  TEST_ASSERT_EQUAL(WIRE_IMPLAUSIBLE, wireDecode(buf, sizeof(buf), r));
+
+  m = reading();
+  m.pressureRead = 200;
+  encodeV1(m, buf);
+  TEST_ASSERT_EQUAL(WIRE_IMPLAUSIBLE, wireDecode(buf, sizeof(buf), r));
+
+  encodeV1(reading(), buf);
+  buf[1] = 1; // Padding the sender zeroed.
+  TEST_ASSERT_EQUAL(WIRE_IMPLAUSIBLE, wireDecode(buf, sizeof(buf), r));
+}
+
+void test_seq_counts_losses_and_retries() {
+  Station st;
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(40000, true));
+  TEST_ASSERT_EQUAL_INT32(-1, st.trackSeq(40000, true)); // Burst retry.
+  TEST_ASSERT_EQUAL_INT32(1, st.trackSeq(40002, false));
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(40003, false));
+  TEST_ASSERT_EQUAL_INT32(-1, st.trackSeq(40003, false));
+}
+
+void test_seq_wraps() {
+  Station st;
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(65534, true));
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(65535, false));
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(0, false));
+  TEST_ASSERT_EQUAL_INT32(1, st.trackSeq(2, false));
+}
+
+void test_seq_restart_is_not_a_gap() {
+  Station st;
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(40000, true));
+  // The node lost its RTC memory and counts from 1 again.
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(1, true));
+  TEST_ASSERT_EQUAL_INT32(0, st.trackSeq(2, false));
+}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_v2_round_trip);
+  RUN_TEST(test_v2_bit_flip_fails_crc);
+  RUN_TEST(test_v2_unknown_version_is_rejected);
+  RUN_TEST(test_v1_reading_decodes);
+  RUN_TEST(test_v1_junk_is_implausible);
+  RUN_TEST(test_seq_counts_losses_and_retries);
+  RUN_TEST(test_seq_wraps);
+  RUN_TEST(test_seq_restart_is_not_a_gap);
+  return UNITY_END();
+}
@@ -0,0 +1,218 @@
+"""
+@file png2rle.py
+@brief Converts the PNGs in data/images into RLE RGB565 assets (src/Rle565.h).
+
+Runs as a PlatformIO pre-script, or standalone:
+    python3 tools/png2rle.py [data/images]
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+MAGIC = b"R565"
+VERSION = 1
+FLAG_KEYED = 0x01
+FLAG_INDEXED = 0x02
+KEY = 0x0000
+MAX_PALETTE = 256
+
+OP_LITERAL = 0x00
+OP_REPEAT = 0x40
+OP_SKIP = 0x80
+MAX_RUN = 64
+MIN_REPEAT = 3  # shorter repeats are cheaper as part of a literal
+
+
+def _paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def _unfilter(raw, width, height, bpp):
+    stride = width * bpp
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        if ftype == 1:
+            for i in range(bpp, stride):
+                line[i] = (line[i] + line[i - bpp]) & 0xFF
+        elif ftype == 2:
+            for i in range(stride):
+                line[i] = (line[i] + prev[i]) & 0xFF
+        elif ftype == 3:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + ((left + prev[i]) >> 1)) & 0xFF
+        elif ftype == 4:
+            for i in range(stride):
+                left = line[i - bpp] if i >= bpp else 0
+                up_left = prev[i - bpp] if i >= bpp else 0
+                line[i] = (line[i] + _paeth(left, prev[i], up_left)) & 0xFF
+        elif ftype != 0:
+            raise ValueError("bad filter type %d" % ftype)
+        rows.append(line)
+        prev = line
+    return rows
+
+
+def _rgb565(r, g, b, a=255):
+    if a != 255:
+        r, g, b = r * a // 255, g * a // 255, b * a // 255
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def decode_png(path):
+    """Returns (width, height, rows of RGB565 values)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG")
+
+    pos = 8
+    idat = bytearray()
+    palette = []
+    trns = b""
+    width = height = ctype = 0
+    while pos < len(data):
+        length, tag = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if tag == b"IHDR":
+            width, height, depth, ctype, _, _, interlace = struct.unpack(
+                ">IIBBBBB", body)
+            if depth != 8 or interlace:
+                raise ValueError("only 8-bit non-interlaced PNGs")
+        elif tag == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif tag == b"tRNS":
+            trns = body
+        elif tag == b"IDAT":
+            idat += body
+        elif tag == b"IEND":
+            break
+
+    bpp = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ctype)
+    if bpp is None:
+        raise ValueError("unsupported colour type %d" % ctype)
+    rows = _unfilter(zlib.decompress(bytes(idat)), width, height, bpp)
+
+    lut = None
+    if ctype == 3:
+        lut = [_rgb565(r, g, b, trns[i] if i < len(trns) else 255)
+               for i, (r, g, b) in enumerate(palette)]
+
+    out = []
+    for line in rows:
+        if ctype == 3:
+            px = [lut[i] for i in line]
+        elif ctype == 0:
+            px = [_rgb565(v, v, v) for v in line]
+        elif ctype == 2:
+            px = [_rgb565(line[i], line[i + 1], line[i + 2])
+                  for i in range(0, len(line), 3)]
+        elif ctype == 4:
+            px = [_rgb565(line[i], line[i], line[i], line[i + 1])
+                  for i in range(0, len(line), 2)]
+        else:
+            px = [_rgb565(line[i], line[i + 1], line[i + 2], line[i + 3])
+                  for i in range(0, len(line), 4)]
+        out.append(px)
+    return width, height, out
+
+
+def _run_length(row, x, limit):
+    n = 1
+    while x + n < limit and n < MAX_RUN and row[x + n] == row[x]:
+        n += 1
+    return n
+
+
+def encode_row(row, index=None):
+    """Packs one row; packets never cross a row boundary.
+
+    With an @p index (colour -> palette slot) pixel values are stored as one
+    byte, otherwise as little-endian RGB565.
+    """
+    def values(px):
+        if index is not None:
+            return bytes(index[v] for v in px)
+        return struct.pack("<%dH" % len(px), *px)
+
+    out = bytearray()
+    x = 0
+    w = len(row)
+    while x < w:
+        n = _run_length(row, x, w)
+        if row[x] == KEY:
+            out.append(OP_SKIP | (n - 1))
+            x += n
+            continue
+        if n >= MIN_REPEAT:
+            out.append(OP_REPEAT | (n - 1))
+            out += values(row[x:x + 1])
+            x += n
+            continue
+        # Literal: extend until a key pixel or a worthwhile repeat starts.
+        start = x
+        while x < w and x - start < MAX_RUN and row[x] != KEY:
+            if x > start and _run_length(row, x, w) >= MIN_REPEAT:
+                break
+            x += 1
+        out.append(OP_LITERAL | (x - start - 1))
+        out += values(row[start:x])
+    return out
+
+
+def convert(png_path, rle_path):
+    width, height, rows = decode_png(png_path)
+    colours = sorted({v for row in rows for v in row} - {KEY})
+    flags = FLAG_KEYED
+    palette = b""
+    index = None
+    if len(colours) <= MAX_PALETTE:
+        flags |= FLAG_INDEXED
+        index = {v: i for i, v in enumerate(colours)}
+        palette = struct.pack("<%dH" % len(colours), *colours)
+    body = bytearray()
+    for row in rows:
+        body += encode_row(row, index)
+    header = MAGIC + struct.pack("<BBHHHH", VERSION, flags, width, height, KEY,
+                                 len(palette) // 2) + palette
+    tmp = rle_path + ".tmp"
+    with open(tmp, "wb") as f:
+        f.write(header)
+        f.write(body)
+    os.replace(tmp, rle_path)
+    return width, height, len(header) + len(body)
+
+
+def convert_dir(image_dir):
+    for name in sorted(os.listdir(image_dir)):
+        if not name.lower().endswith(".png"):
+            continue
+        png_path = os.path.join(image_dir, name)
+        rle_path = png_path[:-4] + ".rle"
+        if (os.path.exists(rle_path) and
+                os.path.getmtime(rle_path) >= os.path.getmtime(png_path)):
+            continue
+        width, height, size = convert(png_path, rle_path)
+        print("[png2rle] %s -> %s (%dx%d, %d -> %d bytes)" %
+              (name, os.path.basename(rle_path), width, height,
+               os.path.getsize(png_path), size))
+
+
+if __name__ == "__main__":
+    convert_dir(sys.argv[1] if len(sys.argv) > 1 else
+                os.path.join("data", "images"))
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    convert_dir(os.path.join(env.subst("$PROJECT_DATA_DIR"), "images"))  # noqa: F821
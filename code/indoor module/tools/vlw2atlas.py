@@ -0,0 +1,115 @@
+"""
+@file vlw2atlas.py
+@brief Pre-renders the clock digits of the time font into src/ClockGlyphs.h.
+
+Runs as a PlatformIO pre-script, or standalone:
+    python3 tools/vlw2atlas.py [font.vlw [out.h]]
+"""
+
+import os
+import struct
+import sys
+
+FONT = os.path.join("fonts", "Lato-Regular-92.vlw")  # read at build time only
+OUTPUT = os.path.join("src", "ClockGlyphs.h")
+CHARS = "0123456789:"
+FG = 0xFFFF  # TFT_WHITE, the clock text colour
+BG = 0x001F  # TFT_BLUE, the colour edges are blended into
+KEY = 0x0000  # transparent; a white/blue blend always has blue bits set
+
+
+def alpha_blend(alpha, fg, bg):
+    """TFT_eSPI::alphaBlend(), bit for bit."""
+    rxb = bg & 0xF81F
+    rxb += ((fg & 0xF81F) - rxb) * (alpha >> 2) >> 6
+    xgx = bg & 0x07E0
+    xgx += ((fg & 0x07E0) - xgx) * alpha >> 8
+    return (rxb & 0xF81F) | (xgx & 0x07E0)
+
+
+def read_vlw(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    count, _, y_advance, _, ascent, descent = struct.unpack_from(">6I", data)
+    glyphs = {}
+    max_ascent, max_descent = ascent, descent
+    bitmap = 24 + count * 28
+    for i in range(count):
+        code, h, w, x_adv, d_y, d_x, _ = struct.unpack_from(">7i", data,
+                                                            24 + i * 28)
+        if ((0x20 < code < 0x7F) or code > 0xA0) and d_y > max_ascent:
+            max_ascent = d_y
+        if (((0x20 < code < 0xA0) and code != 0x7F) or code > 0xFF) and \
+                h - d_y > max_descent:
+            max_descent = h - d_y
+        glyphs[code] = (w, h, x_adv, d_x, d_y, data[bitmap:bitmap + w * h])
+        bitmap += w * h
+    return y_advance, max_ascent, max_descent, glyphs
+
+
+def render(font_path, out_path):
+    y_advance, max_ascent, max_descent, glyphs = read_vlw(font_path)
+    records, pixels = [], []
+    for ch in CHARS:
+        w, h, x_adv, d_x, d_y, alpha = glyphs[ord(ch)]
+        records.append((ord(ch), w, h, x_adv, d_x, d_y, len(pixels)))
+        for a in alpha:
+            px = KEY if a == 0 else FG if a == 255 else alpha_blend(a, FG, BG)
+            assert a == 0 or px != KEY, "blend collides with the key colour"
+            pixels.append(px)
+
+    lines = [
+        "/**",
+        " * @file ClockGlyphs.h",
+        " * @brief Clock digit atlas, generated by tools/vlw2atlas.py from",
+        " * %s - do not edit." % os.path.basename(font_path),
+        " */",
+        "",
+        "#pragma once",
+        '#include "GlyphAtlas.h"',
+        "",
+        "static const uint16_t kClockGlyphPixels[] PROGMEM = {",
+    ]
+    for i in range(0, len(pixels), 12):
+        lines.append("    " + ", ".join("0x%04X" % p
+                                      for p in pixels[i:i + 12]) + ",")
+    lines.append("};")
+    lines.append("")
+    lines.append("static const AtlasGlyph kClockGlyphs[] = {")
+    for code, w, h, x_adv, d_x, d_y, offset in records:
+        lines.append("    {'%s', %d, %d, %d, %d, %d, %d}," %
+                     (chr(code), w, h, x_adv, d_x, d_y, offset))
+    lines.append("};")
+    lines.append("")
+    lines.append("static const AtlasFont kClockFont = {")
+    lines.append("    %d, %d, %d, 0x%04X, 0x%04X, 0x%04X," %
+                 (y_advance, max_ascent, max_descent, FG, BG, KEY))
+    lines.append("    kClockGlyphs, %d, kClockGlyphPixels};" % len(records))
+    lines.append("")
+
+    tmp = out_path + ".tmp"
+    with open(tmp, "w") as f:
+        f.write("\n".join(lines))
+    os.replace(tmp, out_path)
+    return len(records), len(pixels)
+
+
+def generate(project_dir, font=FONT, output=OUTPUT):
+    font_path = os.path.join(project_dir, font)
+    out_path = os.path.join(project_dir, output)
+    if (os.path.exists(out_path) and
+            os.path.getmtime(out_path) >= os.path.getmtime(font_path)):
+        return
+    count, size = render(font_path, out_path)
+    print("[vlw2atlas] %s -> %s (%d glyphs, %d bytes)" %
+          (os.path.basename(font_path), output, count, size * 2))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        render(sys.argv[1], sys.argv[2] if len(sys.argv) > 2 else OUTPUT)
+    else:
+        generate(".")
+else:
+    Import("env")  # noqa: F821 - provided by PlatformIO
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
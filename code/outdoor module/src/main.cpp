@@ -19,6 +19,8 @@
 #include <esp_now.h>
 #include <esp_wifi.h>
 
+#include <MeteoWire.h>
+
 // ================= HARDWARE DEFINITIONS =================
 
 /** @brief I2C SDA Pin */
@@ -68,19 +70,22 @@ bool bmpOk = false;
  */
 RTC_DATA_ATTR uint8_t savedChannel = 1;
 
-/**
- * @struct struct_message
- * @brief Data structure for ESP-NOW transmission.
- * @warning Must match the receiver's structure exactly (including padding).
+/** * @brief Number of the current reading, sent in every frame.
+ * @note Stored in RTC memory so the receiver sees gaps across Deep Sleep.
+ */
+RTC_DATA_ATTR uint16_t telemetrySeq = 0;
+
+/** * @brief A frame numbered from telemetrySeq was acknowledged.
+ * @note Cleared with the rest of RTC memory on power-up, when the frames
+ * carry WIRE_FLAG_RESTART until one gets through.
  */
-typedef struct struct_message {
-  uint8_t humidityRead;           ///< Relative humidity (%)
-  int16_t outdoorTemperatureRead; ///< Temperature * 10 (e.g. 255 = 25.5°C)
-  uint16_t pressureRead;          ///< Atmospheric pressure (hPa)
-  uint8_t uvIndexRead;            ///< UV Raw Value (Clamped to 255)
-} struct_message;
+RTC_DATA_ATTR bool telemetrySeqAcked = false;
 
+/** @brief Current reading (encoded by wireEncode(), see MeteoWire.h) */
 struct_message telemetryData;
+
+/** @brief Frame sent for telemetryData; retries repeat it unchanged */
+WireFrameV2 telemetryFrame;
 esp_now_peer_info_t peerInfo;
 
 // Flags for async ESP-NOW callback
@@ -198,8 +203,8 @@ bool trySendOnChannel(uint8_t channel) {
     transmissionFinished = false;
     transmissionSuccess = false;
 
-    esp_err_t result =
-        esp_now_send(broadcastAddress, (uint8_t *)&telemetryData, sizeof(telemetryData));
+    esp_err_t result = esp_now_send(
+        broadcastAddress, (uint8_t *)&telemetryFrame, sizeof(telemetryFrame));
 
     if (result == ESP_OK) {
       // Wait for ACK
@@ -273,6 +278,8 @@ void setup() {
 
   setupEspNow();
   fillMeasurement();
+  telemetryFrame = wireEncode(telemetryData, ++telemetrySeq,
+                              telemetrySeqAcked ? 0 : WIRE_FLAG_RESTART);
 
   unsigned long startTime = millis();
   bool sentOk = false;
@@ -305,6 +312,9 @@ void setup() {
     }
   }
 
+  if (sentOk)
+    telemetrySeqAcked = true;
+
   goToDeepSleep();
 }
 